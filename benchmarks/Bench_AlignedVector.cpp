@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+#include <mathlib/aligned_vector.h>
+#include <mathlib/quaternion.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+template <typename T>
+static Matrix<3, 3, T> makeRotation() {
+    return Quaternion<T>(Vector<3, T>(T(1), T(2), T(3)), T(0.5)).toRotationMatrix();
+}
+
+template <typename T>
+static void BM_AlignedVector_TransformVector(benchmark::State &state) {
+    const Matrix<3, 3, T> m = makeRotation<T>();
+    std::vector<Vector<3, T>> in(state.range(0), Vector<3, T>(T(1), T(2), T(3))), out(in.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < in.size(); ++i)
+            out[i] = m * in[i];
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void BM_AlignedVector_TransformAligned(benchmark::State &state) {
+    const Matrix<3, 3, T> m = makeRotation<T>();
+    std::vector<AlignedVector<3, T>> in(state.range(0), AlignedVector<3, T>(T(1), T(2), T(3))), out(in.size());
+    for (auto _ : state) {
+        mathlib::transform(m, in.data(), out.data(), in.size());
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void BM_AlignedVector_AddVector(benchmark::State &state) {
+    std::vector<Vector<3, T>> a(state.range(0), Vector<3, T>(T(1), T(2), T(3))), b(a);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < a.size(); ++i)
+            a[i] += b[i];
+        benchmark::DoNotOptimize(a.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void BM_AlignedVector_AddAligned(benchmark::State &state) {
+    std::vector<AlignedVector<3, T>> a(state.range(0), AlignedVector<3, T>(T(1), T(2), T(3))), b(a);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < a.size(); ++i)
+            a[i] += b[i];
+        benchmark::DoNotOptimize(a.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename V>
+static void gatherNormalized(benchmark::State &state) {
+    std::vector<V> in(state.range(0), V(Vector<3, typename V::type>(1, 2, 3)));
+    std::vector<unsigned> order(in.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::shuffle(order.begin(), order.end(), std::mt19937(42));
+    std::vector<V> out(in.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < order.size(); ++i)
+            out[i] = in[order[i]].normalized();
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void BM_AlignedVector_GatherVector(benchmark::State &state) {
+    gatherNormalized<Vector<3, T>>(state);
+}
+
+template <typename T>
+static void BM_AlignedVector_GatherAligned(benchmark::State &state) {
+    gatherNormalized<AlignedVector<3, T>>(state);
+}
+
+BENCHMARK_TEMPLATE(BM_AlignedVector_TransformVector, float)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_AlignedVector_TransformAligned, float)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_AlignedVector_TransformVector, double)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_AlignedVector_TransformAligned, double)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_AlignedVector_AddVector, float)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(BM_AlignedVector_AddAligned, float)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(BM_AlignedVector_AddVector, double)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(BM_AlignedVector_AddAligned, double)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(BM_AlignedVector_GatherVector, float)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_AlignedVector_GatherAligned, float)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_AlignedVector_GatherVector, double)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_AlignedVector_GatherAligned, double)->Arg(1 << 10)->Arg(1 << 20);
@@ -0,0 +1,139 @@
+#include <benchmark/benchmark.h>
+#include <mathlib/bvh.h>
+#include <mathlib/defines.h>
+
+#include <cmath>
+#include <vector>
+
+static float noise(std::size_t i) {
+    return float(std::fmod(std::abs(std::sin(double(i)) * 43758.5453), 1.));
+}
+
+static std::vector<Trianglef> soup(std::size_t count) {
+    std::vector<Trianglef> ret(count);
+    const float size = 20.f / std::cbrt(float(count));
+    for (std::size_t i = 0; i < count; ++i) {
+        const Vector3f center(noise(i * 9) * 10.f, noise(i * 9 + 1) * 10.f, noise(i * 9 + 2) * 10.f);
+        ret[i].v0 = center;
+        ret[i].v1 = center + (Vector3f(noise(i * 9 + 3), noise(i * 9 + 4), noise(i * 9 + 5)) - .5f) * size;
+        ret[i].v2 = center + (Vector3f(noise(i * 9 + 6), noise(i * 9 + 7), noise(i * 9 + 8)) - .5f) * size;
+    }
+    return ret;
+}
+
+/**
+ * Primary rays of a pinhole camera, row by row in tiles of 4x4 pixels so consecutive rays are coherent.
+ */
+static std::vector<Rayf> camera(unsigned width) {
+    std::vector<Rayf> ret;
+    const Vector3f origin(5.f, 5.f, -10.f);
+    for (unsigned ty = 0; ty < width; ty += 4)
+        for (unsigned tx = 0; tx < width; tx += 4)
+            for (unsigned y = ty; y < ty + 4; ++y)
+                for (unsigned x = tx; x < tx + 4; ++x)
+                    ret.emplace_back(origin, Vector3f(float(x) / float(width) - .5f, float(y) / float(width) - .5f, 1.f));
+    return ret;
+}
+
+static void BM_Bvh_Build(benchmark::State &state) {
+    const std::vector<Trianglef> triangles = soup(state.range(0));
+    for (auto _ : state) {
+        Bvhf bvh(triangles, unsigned(state.range(1)));
+        benchmark::DoNotOptimize(bvh);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <unsigned W>
+static void BM_Bvh_Intersect(benchmark::State &state) {
+    const Bvhf bvh(soup(state.range(0)));
+    const std::vector<Rayf> rays = camera(256);
+    std::vector<RayHit<float>> hits(rays.size());
+    for (auto _ : state) {
+        bvh.intersect<W>(rays.data(), rays.size(), hits.data());
+        benchmark::DoNotOptimize(hits.data());
+    }
+    state.SetItemsProcessed(state.iterations() * rays.size());
+}
+
+/**
+ * One triangle against many rays, one ray at a time with Vector3 operations.
+ */
+static void BM_Ray_TriangleSingle(benchmark::State &state) {
+    const Trianglef triangle = soup(1)[0];
+    const std::vector<Rayf> rays = camera(64);
+    for (auto _ : state) {
+        unsigned found = 0;
+        for (const Rayf &ray : rays) {
+            RayHit<float> hit;
+            found += mathlib::intersect(ray, triangle, hit);
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * rays.size());
+}
+
+/**
+ * One triangle against many rays, W rays at a time.
+ */
+template <unsigned W>
+static void BM_Ray_TrianglePacket(benchmark::State &state) {
+    const Trianglef triangle = soup(1)[0];
+    const std::vector<Rayf> rays = camera(64);
+    std::vector<RayPacket<W, float>> packets;
+    for (std::size_t i = 0; i < rays.size(); i += W)
+        packets.emplace_back(rays.data() + i, W);
+    for (auto _ : state) {
+        std::uint32_t found = 0;
+        for (RayPacket<W, float> &packet : packets) {
+            HitPacket<W, float> hits;
+            found |= mathlib::intersect(packet, triangle, 0, hits);
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * rays.size());
+}
+
+static void BM_Ray_BoxSingle(benchmark::State &state) {
+    const Aabbf box(Vector3f(4.f), Vector3f(6.f));
+    const std::vector<Rayf> rays = camera(64);
+    for (auto _ : state) {
+        unsigned found = 0;
+        for (const Rayf &ray : rays) {
+            float t;
+            found += mathlib::intersect(ray, box, t);
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * rays.size());
+}
+
+template <unsigned W>
+static void BM_Ray_BoxPacket(benchmark::State &state) {
+    const Aabbf box(Vector3f(4.f), Vector3f(6.f));
+    const std::vector<Rayf> rays = camera(64);
+    std::vector<RayPacket<W, float>> packets;
+    for (std::size_t i = 0; i < rays.size(); i += W)
+        packets.emplace_back(rays.data() + i, W);
+    for (auto _ : state) {
+        std::uint32_t found = 0;
+        for (const RayPacket<W, float> &packet : packets)
+            found |= mathlib::intersect(packet, box);
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * rays.size());
+}
+
+BENCHMARK(BM_Bvh_Build)->Args({1 << 16, 1})->Args({1 << 16, 0})->Args({1 << 20, 1})->Args({1 << 20, 0});
+BENCHMARK_TEMPLATE(BM_Bvh_Intersect, 1)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_Bvh_Intersect, 4)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_Bvh_Intersect, 8)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_Bvh_Intersect, 16)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(BM_Ray_TriangleSingle);
+BENCHMARK_TEMPLATE(BM_Ray_TrianglePacket, 4);
+BENCHMARK_TEMPLATE(BM_Ray_TrianglePacket, 8);
+BENCHMARK_TEMPLATE(BM_Ray_TrianglePacket, 16);
+BENCHMARK(BM_Ray_BoxSingle);
+BENCHMARK_TEMPLATE(BM_Ray_BoxPacket, 4);
+BENCHMARK_TEMPLATE(BM_Ray_BoxPacket, 8);
+BENCHMARK_TEMPLATE(BM_Ray_BoxPacket, 16);
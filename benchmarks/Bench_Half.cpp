@@ -0,0 +1,22 @@
+#include <benchmark/benchmark.h>
+#include <mathlib/half.h>
+
+#include <vector>
+
+template <typename S, typename D>
+static void BM_Half_Convert(benchmark::State &state) {
+    std::vector<Vector<3, S>> in(state.range(0), Vector<3, S>(S(0.25f), S(-0.5f), S(1.f)));
+    std::vector<Vector<3, D>> out(in.size());
+    for (auto _ : state) {
+        mathlib::convert(in.data(), out.data(), in.size());
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * (sizeof(Vector<3, S>) + sizeof(Vector<3, D>)));
+}
+
+BENCHMARK_TEMPLATE(BM_Half_Convert, float, mathlib::half)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_Half_Convert, mathlib::half, float)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_Half_Convert, float, mathlib::bfloat16)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_Half_Convert, mathlib::bfloat16, float)->Arg(1 << 10)->Arg(1 << 20);
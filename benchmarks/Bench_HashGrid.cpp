@@ -0,0 +1,34 @@
+#include <benchmark/benchmark.h>
+#include <mathlib/hash_grid.h>
+
+#include <cmath>
+#include <vector>
+
+template <typename T>
+static void BM_HashGrid_Build(benchmark::State &state) {
+    std::vector<Vector<3, T>> points(state.range(0));
+    for (std::size_t i = 0; i < points.size(); ++i)
+        for (unsigned c = 0; c < 3; ++c)
+            points[i][c] = T(std::fmod(std::sin(double(i * (c + 3))) * 43758.5453, 100.));
+    SpatialHashGrid<3, T> grid(T(1));
+    for (auto _ : state) {
+        grid.build(points);
+        benchmark::DoNotOptimize(grid.cells());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void BM_HashGrid_Hash(benchmark::State &state) {
+    Vector<3, T> v(T(1), T(2), T(3));
+    std::hash<Vector<3, T>> hash;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(v);
+        benchmark::DoNotOptimize(hash(v));
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_HashGrid_Build, float)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_HashGrid_Build, double)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_HashGrid_Hash, int);
+BENCHMARK_TEMPLATE(BM_HashGrid_Hash, unsigned);
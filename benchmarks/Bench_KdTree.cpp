@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+#include <mathlib/kdtree.h>
+
+#include <cmath>
+#include <vector>
+
+template <typename T>
+static std::vector<Vector<3, T>> cloud(std::size_t count) {
+    std::vector<Vector<3, T>> ret(count);
+    for (std::size_t i = 0; i < count; ++i)
+        for (unsigned c = 0; c < 3; ++c)
+            ret[i][c] = T(std::fmod(std::sin(double(i * (c + 3))) * 43758.5453, 10.));
+    return ret;
+}
+
+template <typename T>
+static void BM_KdTree_Build(benchmark::State &state) {
+    const std::vector<Vector<3, T>> points = cloud<T>(state.range(0));
+    for (auto _ : state) {
+        KdTree<3, T> tree(points);
+        benchmark::DoNotOptimize(tree);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void BM_KdTree_Knn(benchmark::State &state) {
+    const std::vector<Vector<3, T>> points = cloud<T>(state.range(0));
+    const KdTree<3, T> tree(points);
+    const std::vector<Vector<3, T>> queries = cloud<T>(1 << 12);
+    std::vector<std::size_t> indices(queries.size() * 8);
+    for (auto _ : state) {
+        tree.knn(queries.data(), queries.size(), 8, indices.data(), nullptr);
+        benchmark::DoNotOptimize(indices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+BENCHMARK_TEMPLATE(BM_KdTree_Build, float)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_KdTree_Build, double)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_KdTree_Knn, float)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_KdTree_Knn, double)->Arg(1 << 16)->Arg(1 << 20);
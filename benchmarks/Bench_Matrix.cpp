@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+#include <mathlib/matrix.h>
+#include <mathlib/quaternion.h>
+
+template <unsigned N, typename T>
+static void BM_Matrix_MatrixVector(benchmark::State &state) {
+    Matrix<N, N, T> m = Matrix<N, N, T>::Identity() * T(2);
+    Vector<N, T> v(T(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(m);
+        benchmark::DoNotOptimize(v);
+        Vector<N, T> r = m * v;
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+template <unsigned N, typename T>
+static void BM_Matrix_MatrixMatrix(benchmark::State &state) {
+    Matrix<N, N, T> a = Matrix<N, N, T>::Identity() * T(2);
+    Matrix<N, N, T> b(T(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(b);
+        Matrix<N, N, T> r = a * b;
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+template <unsigned N, typename T>
+static void BM_Matrix_Inverse(benchmark::State &state) {
+    Matrix<N, N, T> m = Matrix<N, N, T>::Identity() * T(2) + Matrix<N, N, T>(T(0.25));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(m);
+        Matrix<N, N, T> r = m.inverse();
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+template <typename T>
+static void BM_Matrix_RotateWithMatrix(benchmark::State &state) {
+    Matrix<3, 3, T> m = Quaternion<T>(Vector<3, T>(T(1), T(2), T(3)), T(0.5)).toRotationMatrix();
+    Vector<3, T> v(T(1), T(0), T(2));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(m);
+        benchmark::DoNotOptimize(v);
+        Vector<3, T> r = m * v;
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_Matrix_MatrixVector, 3, float);
+BENCHMARK_TEMPLATE(BM_Matrix_MatrixVector, 3, double);
+BENCHMARK_TEMPLATE(BM_Matrix_MatrixVector, 4, float);
+BENCHMARK_TEMPLATE(BM_Matrix_MatrixVector, 4, double);
+BENCHMARK_TEMPLATE(BM_Matrix_MatrixMatrix, 3, float);
+BENCHMARK_TEMPLATE(BM_Matrix_MatrixMatrix, 3, double);
+BENCHMARK_TEMPLATE(BM_Matrix_MatrixMatrix, 4, float);
+BENCHMARK_TEMPLATE(BM_Matrix_MatrixMatrix, 4, double);
+BENCHMARK_TEMPLATE(BM_Matrix_Inverse, 3, double);
+BENCHMARK_TEMPLATE(BM_Matrix_Inverse, 4, float);
+BENCHMARK_TEMPLATE(BM_Matrix_Inverse, 4, double);
+BENCHMARK_TEMPLATE(BM_Matrix_RotateWithMatrix, float);
+BENCHMARK_TEMPLATE(BM_Matrix_RotateWithMatrix, double);
@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+#include <mathlib/operators.h>
+#include <mathlib/vector.h>
+
+template <unsigned N, typename T>
+static void BM_Operators_Add(benchmark::State &state) {
+    Vector<N, T> a(T(1)), b(T(2));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(b);
+        Vector<N, T> c = a + b;
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <unsigned N, typename T>
+static void BM_Operators_Multiply(benchmark::State &state) {
+    Vector<N, T> a(T(1)), b(T(2));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(b);
+        Vector<N, T> c = a * b;
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <unsigned N, typename T>
+static void BM_Operators_Divide(benchmark::State &state) {
+    Vector<N, T> a(T(1)), b(T(2));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(b);
+        Vector<N, T> c = a / b;
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <unsigned N, typename T>
+static void BM_Operators_Scalar(benchmark::State &state) {
+    Vector<N, T> a(T(1));
+    T s = T(3);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(s);
+        Vector<N, T> c = s * a + s;
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <unsigned N, typename T>
+static void BM_Operators_Negate(benchmark::State &state) {
+    Vector<N, T> a(T(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        Vector<N, T> c = -a;
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <unsigned N, typename T>
+static void BM_Operators_Compound(benchmark::State &state) {
+    Vector<N, T> a(T(1)), b(T(2)), c(T(3)), d(T(4));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(b);
+        Vector<N, T> r = a + b * c - d * T(2);
+        benchmark::DoNotOptimize(r);
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <unsigned N, typename T>
+static void BM_Operators_AddAssign(benchmark::State &state) {
+    Vector<N, T> a(T(1)), b(T(2));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(b);
+        a += b;
+        benchmark::DoNotOptimize(a);
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+#define MATHLIB_BENCHMARK_SIZES(name)     \
+    BENCHMARK_TEMPLATE(name, 3, float);   \
+    BENCHMARK_TEMPLATE(name, 3, double);  \
+    BENCHMARK_TEMPLATE(name, 16, float);  \
+    BENCHMARK_TEMPLATE(name, 16, double); \
+    BENCHMARK_TEMPLATE(name, 256, float); \
+    BENCHMARK_TEMPLATE(name, 256, double)
+
+MATHLIB_BENCHMARK_SIZES(BM_Operators_Add);
+MATHLIB_BENCHMARK_SIZES(BM_Operators_Multiply);
+MATHLIB_BENCHMARK_SIZES(BM_Operators_Divide);
+MATHLIB_BENCHMARK_SIZES(BM_Operators_Scalar);
+MATHLIB_BENCHMARK_SIZES(BM_Operators_Negate);
+MATHLIB_BENCHMARK_SIZES(BM_Operators_Compound);
+MATHLIB_BENCHMARK_SIZES(BM_Operators_AddAssign);
+BENCHMARK_TEMPLATE(BM_Operators_Add, 3, int);
+BENCHMARK_TEMPLATE(BM_Operators_Multiply, 3, int);
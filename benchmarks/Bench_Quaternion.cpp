@@ -0,0 +1,209 @@
+#include <benchmark/benchmark.h>
+#include <mathlib/quaternion.h>
+#include <mathlib/quaternion_array.h>
+
+#include <cmath>
+#include <vector>
+
+template <typename T>
+static void BM_Quaternion_Construct(benchmark::State &state) {
+    T x = T(0.1), y = T(0.2), z = T(0.3), w = T(0.9);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(x);
+        Quaternion<T> q(x, y, z, w);
+        benchmark::DoNotOptimize(q);
+    }
+}
+
+template <typename T>
+static void BM_Quaternion_ConstructAxisAngle(benchmark::State &state) {
+    Vector<3, T> axis(T(1), T(2), T(3));
+    T angle = T(0.5);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(axis);
+        benchmark::DoNotOptimize(angle);
+        Quaternion<T> q(axis, angle);
+        benchmark::DoNotOptimize(q);
+    }
+}
+
+template <typename T>
+static void BM_Quaternion_Compose(benchmark::State &state) {
+    Quaternion<T> a(Vector<3, T>(T(1), T(2), T(3)), T(0.5));
+    Quaternion<T> b(Vector<3, T>(T(3), T(2), T(1)), T(0.25));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(b);
+        Quaternion<T> c = a * b;
+        benchmark::DoNotOptimize(c);
+    }
+}
+
+template <typename T>
+static void BM_Quaternion_Rotate(benchmark::State &state) {
+    Quaternion<T> q(Vector<3, T>(T(1), T(2), T(3)), T(0.5));
+    Vector<3, T> v(T(1), T(0), T(2));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(q);
+        benchmark::DoNotOptimize(v);
+        Vector<3, T> r = q * v;
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+template <typename T>
+static void BM_Quaternion_RotateBulk(benchmark::State &state) {
+    Quaternion<T> q(Vector<3, T>(T(1), T(2), T(3)), T(0.5));
+    std::vector<Vector<3, T>> points(state.range(0), Vector<3, T>(T(1), T(0), T(2)));
+    for (auto _ : state) {
+        q.rotate(points);
+        benchmark::DoNotOptimize(points.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void BM_Quaternion_Inverse(benchmark::State &state) {
+    Quaternion<T> q(Vector<3, T>(T(1), T(2), T(3)), T(0.5));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(q);
+        Quaternion<T> i = q.inverse();
+        benchmark::DoNotOptimize(i);
+    }
+}
+
+template <typename T>
+static void BM_Quaternion_Interpolate(benchmark::State &state) {
+    const std::size_t n = std::size_t(state.range(0));
+    std::vector<Quaternion<T>> a(n, Quaternion<T>(Vector<3, T>(T(1), T(2), T(3)), T(0.5)));
+    std::vector<Quaternion<T>> b(n, Quaternion<T>(Vector<3, T>(T(3), T(2), T(1)), T(-1.5)));
+    std::vector<Quaternion<T>> out(n);
+    std::vector<T> t(n);
+    for (std::size_t i = 0; i < n; ++i)
+        t[i] = T(i % 101) / T(100);
+    for (auto _ : state) {
+        switch (state.range(1)) {
+            case 0:
+                mathlib::slerp(a.data(), b.data(), t.data(), out.data(), n);
+                break;
+            case 1:
+                mathlib::nlerp(a.data(), b.data(), t.data(), out.data(), n);
+                break;
+            default:
+                mathlib::fastSlerp(a.data(), b.data(), t.data(), out.data(), n);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void BM_Quaternion_ComposeBulk(benchmark::State &state) {
+    std::vector<Quaternion<T>> a(state.range(0), Quaternion<T>(Vector<3, T>(T(1), T(2), T(3)), T(0.5)));
+    std::vector<Quaternion<T>> b(state.range(0), Quaternion<T>(Vector<3, T>(T(3), T(2), T(1)), T(0.25)));
+    std::vector<Quaternion<T>> c(state.range(0));
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < a.size(); ++i)
+            c[i] = a[i] * b[i];
+        benchmark::DoNotOptimize(c.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void BM_QuaternionArray_Compose(benchmark::State &state) {
+    QuaternionArray<T> a(state.range(0), Quaternion<T>(Vector<3, T>(T(1), T(2), T(3)), T(0.5)));
+    QuaternionArray<T> b(state.range(0), Quaternion<T>(Vector<3, T>(T(3), T(2), T(1)), T(0.25)));
+    for (auto _ : state) {
+        a *= b;
+        benchmark::DoNotOptimize(a.data(0));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * Angular velocities of many bodies, different for every body.
+ */
+template <typename T>
+static std::vector<Vector<3, T>> angularVelocities(std::size_t count) {
+    std::vector<Vector<3, T>> ret(count);
+    for (std::size_t i = 0; i < count; ++i)
+        ret[i] = Vector<3, T>(T(std::sin(double(i))), T(i % 17) - T(8), T(0.5));
+    return ret;
+}
+
+/**
+ * One integration step per body with an axis-angle quaternion and operator*.
+ */
+template <typename T>
+static void BM_Quaternion_IntegrateAxisAngle(benchmark::State &state) {
+    std::vector<Quaternion<T>> q(state.range(0), Quaternion<T>(Vector<3, T>(T(1), T(2), T(3)), T(0.5)));
+    const std::vector<Vector<3, T>> omega = angularVelocities<T>(q.size());
+    const T dt = T(1e-3);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < q.size(); ++i) {
+            q[i] = Quaternion<T>(omega[i], omega[i].norm() * dt) * q[i];
+            q[i].normalize();
+        }
+        benchmark::DoNotOptimize(q.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void BM_Quaternion_Integrate(benchmark::State &state) {
+    std::vector<Quaternion<T>> q(state.range(0), Quaternion<T>(Vector<3, T>(T(1), T(2), T(3)), T(0.5)));
+    const std::vector<Vector<3, T>> omega = angularVelocities<T>(q.size());
+    for (auto _ : state) {
+        mathlib::integrate(q.data(), omega.data(), T(1e-3), q.size(), unsigned(state.range(1)));
+        benchmark::DoNotOptimize(q.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void BM_QuaternionArray_Integrate(benchmark::State &state) {
+    QuaternionArray<T> q(state.range(0), Quaternion<T>(Vector<3, T>(T(1), T(2), T(3)), T(0.5)));
+    const std::vector<Vector<3, T>> velocities = angularVelocities<T>(q.size());
+    VectorArray<3, T> omega(q.size());
+    for (std::size_t i = 0; i < q.size(); ++i)
+        omega[i] = velocities[i];
+    for (auto _ : state) {
+        q.integrate(omega, T(1e-3), unsigned(state.range(1)));
+        benchmark::DoNotOptimize(q.data(0));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_Quaternion_Construct, float);
+BENCHMARK_TEMPLATE(BM_Quaternion_Construct, double);
+BENCHMARK_TEMPLATE(BM_Quaternion_ConstructAxisAngle, float);
+BENCHMARK_TEMPLATE(BM_Quaternion_ConstructAxisAngle, double);
+BENCHMARK_TEMPLATE(BM_Quaternion_Compose, float);
+BENCHMARK_TEMPLATE(BM_Quaternion_Compose, double);
+BENCHMARK_TEMPLATE(BM_Quaternion_Rotate, float);
+BENCHMARK_TEMPLATE(BM_Quaternion_Rotate, double);
+BENCHMARK_TEMPLATE(BM_Quaternion_RotateBulk, float)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_Quaternion_RotateBulk, double)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_Quaternion_Inverse, float);
+BENCHMARK_TEMPLATE(BM_Quaternion_Inverse, double);
+// Second argument: 0 = slerp, 1 = nlerp, 2 = fastSlerp.
+BENCHMARK_TEMPLATE(BM_Quaternion_Interpolate, float)->ArgsProduct({{1 << 10, 200000}, {0, 1, 2}});
+BENCHMARK_TEMPLATE(BM_Quaternion_Interpolate, double)->ArgsProduct({{1 << 10, 200000}, {0, 1, 2}});
+BENCHMARK_TEMPLATE(BM_Quaternion_ComposeBulk, float)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_Quaternion_ComposeBulk, double)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_QuaternionArray_Compose, float)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_QuaternionArray_Compose, double)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_Quaternion_IntegrateAxisAngle, float)->Arg(500000);
+BENCHMARK_TEMPLATE(BM_Quaternion_IntegrateAxisAngle, double)->Arg(500000);
+BENCHMARK_TEMPLATE(BM_Quaternion_Integrate, float)->Args({500000, 1})->Args({500000, 0});
+BENCHMARK_TEMPLATE(BM_Quaternion_Integrate, double)->Args({500000, 1})->Args({500000, 0});
+BENCHMARK_TEMPLATE(BM_QuaternionArray_Integrate, float)->Args({500000, 1})->Args({500000, 0});
+BENCHMARK_TEMPLATE(BM_QuaternionArray_Integrate, double)->Args({500000, 1})->Args({500000, 0});
@@ -0,0 +1,45 @@
+#include <benchmark/benchmark.h>
+#include <mathlib/reduce.h>
+
+#include <vector>
+
+template <typename T>
+static void BM_Reduce_Sum(benchmark::State &state) {
+    std::vector<Vector<3, T>> points(state.range(0), Vector<3, T>(T(1), T(0), T(2)));
+    const unsigned threads = unsigned(state.range(1));
+    for (auto _ : state) {
+        Vector<3, T> s = mathlib::sum(points, threads);
+        benchmark::DoNotOptimize(s);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void BM_Reduce_BoundingBox(benchmark::State &state) {
+    std::vector<Vector<3, T>> points(state.range(0), Vector<3, T>(T(1), T(0), T(2)));
+    const unsigned threads = unsigned(state.range(1));
+    for (auto _ : state) {
+        auto box = mathlib::boundingBox(points, threads);
+        benchmark::DoNotOptimize(box);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void BM_Reduce_Dot(benchmark::State &state) {
+    std::vector<Vector<3, T>> a(state.range(0), Vector<3, T>(T(1), T(0), T(2)));
+    std::vector<Vector<3, T>> b(state.range(0), Vector<3, T>(T(2), T(1), T(0)));
+    const unsigned threads = unsigned(state.range(1));
+    for (auto _ : state) {
+        T d = mathlib::dot(a, b, threads);
+        benchmark::DoNotOptimize(d);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_Reduce_Sum, float)->ArgsProduct({{1 << 10, 1 << 16, 1 << 22}, {1, 0}})->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Reduce_Sum, double)->ArgsProduct({{1 << 10, 1 << 16, 1 << 22}, {1, 0}})->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Reduce_BoundingBox, float)->ArgsProduct({{1 << 10, 1 << 16, 1 << 22}, {1, 0}})->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Reduce_BoundingBox, double)->ArgsProduct({{1 << 10, 1 << 16, 1 << 22}, {1, 0}})->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Reduce_Dot, float)->ArgsProduct({{1 << 10, 1 << 16, 1 << 22}, {1, 0}})->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Reduce_Dot, double)->ArgsProduct({{1 << 10, 1 << 16, 1 << 22}, {1, 0}})->UseRealTime();
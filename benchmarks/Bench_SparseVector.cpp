@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+#include <mathlib/sparse_vector.h>
+
+#include <memory>
+
+namespace {
+
+constexpr unsigned dimension = 4096;
+
+/**
+ * @brief A sparse vector with every stride-th value set, starting at offset.
+ */
+SparseVector<dimension, float> makeSparse(unsigned stride, unsigned offset) {
+    Vector<dimension, float> dense;
+    for (unsigned i = offset; i < dimension; i += stride)
+        dense[i] = 0.5f + float(i % 7);
+    return SparseVector<dimension, float>(dense);
+}
+
+}  // namespace
+
+/**
+ * state.range(0) is the percentage of non-zeros.
+ */
+static void BM_SparseVector_DotDense(benchmark::State &state) {
+    const SparseVector<dimension, float> a = makeSparse(unsigned(100 / state.range(0)), 0);
+    auto b = std::make_unique<Vector<dimension, float>>(1.5f);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(a.dot(*b));
+    state.counters["non_zeros"] = double(a.nonZeros());
+}
+
+static void BM_SparseVector_DotSparse(benchmark::State &state) {
+    const SparseVector<dimension, float> a = makeSparse(unsigned(100 / state.range(0)), 0);
+    const SparseVector<dimension, float> b = makeSparse(unsigned(100 / state.range(0)) + 1, 1);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(a.dot(b));
+    state.counters["non_zeros"] = double(a.nonZeros());
+}
+
+static void BM_SparseVector_Axpy(benchmark::State &state) {
+    const SparseVector<dimension, float> a = makeSparse(unsigned(100 / state.range(0)), 0);
+    auto y = std::make_unique<Vector<dimension, float>>(1.5f);
+    for (auto _ : state) {
+        a.axpy(1e-3f, *y);
+        benchmark::DoNotOptimize(&(*y)[0]);
+    }
+}
+
+/**
+ * The dense baselines of the same size.
+ */
+static void BM_SparseVector_DenseDot(benchmark::State &state) {
+    auto a = std::make_unique<Vector<dimension, float>>(makeSparse(20, 0).toVector());
+    auto b = std::make_unique<Vector<dimension, float>>(1.5f);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(a->dot(*b));
+}
+
+static void BM_SparseVector_DenseAxpy(benchmark::State &state) {
+    auto a = std::make_unique<Vector<dimension, float>>(makeSparse(20, 0).toVector());
+    auto y = std::make_unique<Vector<dimension, float>>(1.5f);
+    for (auto _ : state) {
+        *y += *a * 1e-3f;
+        benchmark::DoNotOptimize(&(*y)[0]);
+    }
+}
+
+BENCHMARK(BM_SparseVector_DotDense)->Arg(1)->Arg(5)->Arg(20);
+BENCHMARK(BM_SparseVector_DotSparse)->Arg(1)->Arg(5)->Arg(20);
+BENCHMARK(BM_SparseVector_Axpy)->Arg(1)->Arg(5)->Arg(20);
+BENCHMARK(BM_SparseVector_DenseDot);
+BENCHMARK(BM_SparseVector_DenseAxpy);
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+#include <mathlib/text.h>
+#include <mathlib/vector.h>
+
+#include <sstream>
+
+template <unsigned N, typename T>
+static void BM_Stream_Write(benchmark::State &state) {
+    Vector<N, T> v(T(1.5));
+    for (auto _ : state) {
+        std::ostringstream ss;
+        ss << v;
+        benchmark::DoNotOptimize(ss.str());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <unsigned N, typename T>
+static void BM_Stream_Read(benchmark::State &state) {
+    std::ostringstream out;
+    out << Vector<N, T>(T(1.5));
+    const std::string text = out.str();
+    Vector<N, T> v;
+    for (auto _ : state) {
+        std::istringstream ss(text);
+        ss >> v;
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <unsigned N, typename T>
+static void BM_Stream_ToString(benchmark::State &state) {
+    Vector<N, T> v(T(1.5));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(v);
+        benchmark::DoNotOptimize(v.to_string());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <unsigned N, typename T>
+static void BM_Stream_Format(benchmark::State &state) {
+    Vector<N, T> v(T(1.5));
+    char buffer[N * 33];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(v);
+        benchmark::DoNotOptimize(mathlib::format(buffer, buffer + sizeof(buffer), v).ptr);
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <unsigned N, typename T>
+static void BM_Stream_Parse(benchmark::State &state) {
+    const std::string text = mathlib::format(Vector<N, T>(T(1.5)));
+    Vector<N, T> v;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(mathlib::parse(text, v));
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+#define MATHLIB_BENCHMARK_SIZES(name)    \
+    BENCHMARK_TEMPLATE(name, 3, float);  \
+    BENCHMARK_TEMPLATE(name, 3, double); \
+    BENCHMARK_TEMPLATE(name, 3, int);    \
+    BENCHMARK_TEMPLATE(name, 16, double)
+
+MATHLIB_BENCHMARK_SIZES(BM_Stream_Write);
+MATHLIB_BENCHMARK_SIZES(BM_Stream_Read);
+MATHLIB_BENCHMARK_SIZES(BM_Stream_ToString);
+MATHLIB_BENCHMARK_SIZES(BM_Stream_Format);
+MATHLIB_BENCHMARK_SIZES(BM_Stream_Parse);
@@ -0,0 +1,251 @@
+#include <benchmark/benchmark.h>
+#include <mathlib/vector.h>
+
+#include <cmath>
+#include <memory>
+
+namespace {
+
+template <unsigned N, typename T>
+Vector<N, T> makeVector(T offset) {
+    Vector<N, T> v;
+    for (unsigned i = 0; i < N; ++i)
+        v[i] = T(i % 7) + offset;
+    return v;
+}
+
+}  // namespace
+
+template <unsigned N, typename T>
+static void BM_Vector_ConstructZero(benchmark::State &state) {
+    for (auto _ : state) {
+        Vector<N, T> v;
+        benchmark::DoNotOptimize(v);
+    }
+}
+
+template <unsigned N, typename T>
+static void BM_Vector_ConstructValue(benchmark::State &state) {
+    T value = T(1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(value);
+        Vector<N, T> v(value);
+        benchmark::DoNotOptimize(v);
+    }
+}
+
+template <unsigned N, typename T>
+static void BM_Vector_ConstructStdVector(benchmark::State &state) {
+    std::vector<T> data(N, T(1));
+    for (auto _ : state) {
+        Vector<N, T> v(data);
+        benchmark::DoNotOptimize(v);
+    }
+}
+
+template <unsigned N, typename T>
+static void BM_Vector_Copy(benchmark::State &state) {
+    Vector<N, T> a = makeVector<N, T>(T(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        Vector<N, T> b(a);
+        benchmark::DoNotOptimize(b);
+    }
+}
+
+template <unsigned N, typename T>
+static void BM_Vector_CommaInit(benchmark::State &state) {
+    Vector<N, T> v;
+    for (auto _ : state) {
+        if constexpr (N == 3)
+            v << T(1), T(2), T(3);
+        else
+            v << T(1), T(2), T(3), T(4);
+        benchmark::DoNotOptimize(v);
+    }
+}
+
+template <unsigned N, typename T>
+static void BM_Vector_Dot(benchmark::State &state) {
+    Vector<N, T> a = makeVector<N, T>(T(1));
+    Vector<N, T> b = makeVector<N, T>(T(2));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(b);
+        benchmark::DoNotOptimize(a.dot(b));
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <unsigned N, typename T>
+static void BM_Vector_SquaredNorm(benchmark::State &state) {
+    Vector<N, T> a = makeVector<N, T>(T(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(a.squaredNorm());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <unsigned N, typename T>
+static void BM_Vector_Norm(benchmark::State &state) {
+    Vector<N, T> a = makeVector<N, T>(T(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(a.norm());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <unsigned N, typename T>
+static void BM_Vector_Normalize(benchmark::State &state) {
+    Vector<N, T> a = makeVector<N, T>(T(1));
+    for (auto _ : state) {
+        Vector<N, T> b = a;
+        b.normalize();
+        benchmark::DoNotOptimize(b);
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <unsigned N, typename T>
+static void BM_Vector_Normalized(benchmark::State &state) {
+    Vector<N, T> a = makeVector<N, T>(T(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        Vector<N, T> b = a.normalized();
+        benchmark::DoNotOptimize(b);
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <unsigned N, typename T>
+static void BM_Vector_NormalizeFast(benchmark::State &state) {
+    Vector<N, T> a = makeVector<N, T>(T(1));
+    for (auto _ : state) {
+        Vector<N, T> b = a;
+        b.normalize(mathlib::fast);
+        benchmark::DoNotOptimize(b);
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <typename T>
+static void BM_Vector_Cross(benchmark::State &state) {
+    Vector<3, T> a = makeVector<3, T>(T(1));
+    Vector<3, T> b = makeVector<3, T>(T(2));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        Vector<3, T> c = a.cross(b);
+        benchmark::DoNotOptimize(c);
+    }
+}
+
+template <unsigned N, typename T>
+static void BM_Vector_Sum(benchmark::State &state) {
+    Vector<N, T> a = makeVector<N, T>(T(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(a.sum());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <unsigned N, typename T>
+static void BM_Vector_MinMax(benchmark::State &state) {
+    Vector<N, T> a = makeVector<N, T>(T(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(a.min());
+        benchmark::DoNotOptimize(a.max());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+/**
+ * Large vector reductions, state.range(0) selects the kernel:
+ * 0 serial sum, 1 sum(), 2 sum(compensated), 3 serial dot, 4 dot(), 5 dot(compensated).
+ * The rel_error counter is the relative error against a long double reference.
+ */
+template <unsigned N, typename T>
+static void BM_Vector_Reduce(benchmark::State &state) {
+    auto a = std::make_unique<Vector<N, T>>();
+    auto b = std::make_unique<Vector<N, T>>();
+    for (unsigned i = 0; i < N; ++i) {
+        (*a)[i] = T(0.1) * T(i % 13 + 1);
+        (*b)[i] = T(1.1) - T(0.01) * T(i % 17);
+    }
+    const int mode = int(state.range(0));
+    const bool products = mode >= 3;
+    long double exact = 0.;
+    for (unsigned i = 0; i < N; ++i)
+        exact += products ? (long double)(*a)[i] * (long double)(*b)[i] : (long double)(*a)[i];
+
+    T result(0.);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(&(*a)[0]);
+        switch (mode) {
+            case 0:
+            case 3:
+                result = T(0.);
+                for (unsigned i = 0; i < N; ++i)
+                    result += products ? (*a)[i] * (*b)[i] : (*a)[i];
+                break;
+            case 1:
+                result = a->sum();
+                break;
+            case 2:
+                result = a->sum(mathlib::compensated);
+                break;
+            case 4:
+                result = a->dot(*b);
+                break;
+            default:
+                result = a->dot(*b, mathlib::compensated);
+                break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    static const char *labels[] = {"serial sum", "sum", "compensated sum", "serial dot", "dot", "compensated dot"};
+    state.SetLabel(labels[mode]);
+    state.counters["rel_error"] = double(std::fabs((long double)result - exact) / exact);
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+#define MATHLIB_BENCHMARK_SIZES(name)    \
+    BENCHMARK_TEMPLATE(name, 3, float);  \
+    BENCHMARK_TEMPLATE(name, 3, double); \
+    BENCHMARK_TEMPLATE(name, 4, float);  \
+    BENCHMARK_TEMPLATE(name, 4, double); \
+    BENCHMARK_TEMPLATE(name, 16, float); \
+    BENCHMARK_TEMPLATE(name, 16, double); \
+    BENCHMARK_TEMPLATE(name, 256, float); \
+    BENCHMARK_TEMPLATE(name, 256, double)
+
+MATHLIB_BENCHMARK_SIZES(BM_Vector_ConstructZero);
+MATHLIB_BENCHMARK_SIZES(BM_Vector_ConstructValue);
+MATHLIB_BENCHMARK_SIZES(BM_Vector_ConstructStdVector);
+MATHLIB_BENCHMARK_SIZES(BM_Vector_Copy);
+MATHLIB_BENCHMARK_SIZES(BM_Vector_Dot);
+MATHLIB_BENCHMARK_SIZES(BM_Vector_SquaredNorm);
+MATHLIB_BENCHMARK_SIZES(BM_Vector_Norm);
+MATHLIB_BENCHMARK_SIZES(BM_Vector_Normalize);
+MATHLIB_BENCHMARK_SIZES(BM_Vector_Normalized);
+BENCHMARK_TEMPLATE(BM_Vector_NormalizeFast, 3, float);
+BENCHMARK_TEMPLATE(BM_Vector_NormalizeFast, 3, double);
+BENCHMARK_TEMPLATE(BM_Vector_NormalizeFast, 4, float);
+MATHLIB_BENCHMARK_SIZES(BM_Vector_Sum);
+MATHLIB_BENCHMARK_SIZES(BM_Vector_MinMax);
+BENCHMARK_TEMPLATE(BM_Vector_Dot, 3, int);
+BENCHMARK_TEMPLATE(BM_Vector_Sum, 3, int);
+BENCHMARK_TEMPLATE(BM_Vector_CommaInit, 3, float);
+BENCHMARK_TEMPLATE(BM_Vector_CommaInit, 3, double);
+BENCHMARK_TEMPLATE(BM_Vector_CommaInit, 4, double);
+BENCHMARK_TEMPLATE(BM_Vector_Reduce, 256, float)->DenseRange(0, 5);
+BENCHMARK_TEMPLATE(BM_Vector_Reduce, 1024, float)->DenseRange(0, 5);
+BENCHMARK_TEMPLATE(BM_Vector_Reduce, 4096, float)->DenseRange(0, 5);
+BENCHMARK_TEMPLATE(BM_Vector_Reduce, 16384, float)->DenseRange(0, 5);
+BENCHMARK_TEMPLATE(BM_Vector_Reduce, 256, double)->DenseRange(0, 5);
+BENCHMARK_TEMPLATE(BM_Vector_Reduce, 16384, double)->DenseRange(0, 5);
+BENCHMARK_TEMPLATE(BM_Vector_Cross, float);
+BENCHMARK_TEMPLATE(BM_Vector_Cross, double);
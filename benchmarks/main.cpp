@@ -0,0 +1,29 @@
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <vector>
+
+/**
+ * Runs all registered benchmarks.
+ *
+ * Results are written as JSON to stdout, unless another format is requested with --benchmark_format.
+ * Use --benchmark_out=<file> to additionally store them in a file.
+ */
+int main(int argc, char *argv[]) {
+    std::vector<char *> args(argv, argv + argc);
+    bool has_format = false;
+    for (int i = 1; i < argc; ++i)
+        if (std::strncmp(argv[i], "--benchmark_format", 18) == 0)
+            has_format = true;
+    char json_format[] = "--benchmark_format=json";
+    if (!has_format)
+        args.push_back(json_format);
+
+    int args_count = static_cast<int>(args.size());
+    ::benchmark::Initialize(&args_count, args.data());
+    if (::benchmark::ReportUnrecognizedArguments(args_count, args.data()))
+        return 1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+    return 0;
+}
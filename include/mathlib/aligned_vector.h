@@ -0,0 +1,467 @@
+#ifndef __MATHLIB_ALIGNED_VECTOR_H__
+#define __MATHLIB_ALIGNED_VECTOR_H__
+
+#include <mathlib/expression.h>
+#include <mathlib/matrix.h>
+#include <mathlib/parallel.h>
+#include <mathlib/simd.h>
+#include <mathlib/unroll.h>
+#include <mathlib/vector.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+namespace mathlib::detail {
+
+/**
+ * @brief The number of stored values of an AlignedVector.
+ * @param n The size of the vector.
+ * @return The smallest power of two not less than n.
+ */
+constexpr unsigned paddedSize(unsigned n) {
+    unsigned ret = 1;
+    while (ret < n)
+        ret *= 2;
+    return ret;
+}
+
+/**
+ * @brief The alignment of an AlignedVector in bytes.
+ * @param bytes The padded size in bytes.
+ * @return The padded size, at most the size of a cache line.
+ */
+constexpr std::size_t paddedAlignment(std::size_t bytes) {
+    return bytes < 64 ? bytes : 64;
+}
+
+}  // namespace mathlib::detail
+
+/**
+ * @brief %Vector padded to a power of two and aligned to its size, for SIMD-friendly storage.
+ *
+ * An AlignedVector<3, float> takes 16 bytes instead of 12, so every element of an array sits in one aligned
+ * 128 bit lane and all arithmetic runs on full registers. The padding values stay zero as long as all values are finite.
+ * Converts implicitly from and to Vector, and takes part in the same expressions.
+ * @tparam N The size of the vector.
+ * @tparam T The underlying data type of the vector.
+ */
+template <unsigned N, typename T>
+class alignas(mathlib::detail::paddedAlignment(mathlib::detail::paddedSize(N) * sizeof(T))) AlignedVector
+    : public VectorExpression<AlignedVector<N, T>, N, T> {
+public:
+    using type = T;  ///< The underlying data type.
+
+    /**
+     * @brief The number of stored values, including the padding.
+     */
+    constexpr static unsigned padded = mathlib::detail::paddedSize(N);
+
+    /**
+     * @brief The underlying size of the vector.
+     * @return The size.
+     */
+    constexpr static unsigned size() {
+        return N;
+    }
+
+    /**
+     * @brief Construct a zero vector.
+     */
+    constexpr AlignedVector() : m_data{} {}
+
+    /**
+     * @brief Construct a vector from a single value.
+     * @param t The single value
+     */
+    constexpr AlignedVector(T t) : m_data{} {
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] = t; });
+    }
+
+    /**
+     * @brief Construct a vector from given x, y and z values.
+     * @param x The x value
+     * @param y The y value
+     * @param z The z value
+     * @attention Only for size 3 vectors.
+     */
+    constexpr AlignedVector(const T &x, const T &y, const T &z) : m_data{x, y, z} {
+        static_assert(N == 3 && "only for vectors with size 3");
+    }
+
+    /**
+     * @brief Construct a vector from given x, y, z and w values.
+     * @param x The x value
+     * @param y The y value
+     * @param z The z value
+     * @param w The w value
+     * @attention Only for size 4 vectors.
+     */
+    constexpr AlignedVector(const T &x, const T &y, const T &z, const T &w) : m_data{x, y, z, w} {
+        static_assert(N == 4 && "only for vectors with size 4");
+    }
+
+    /**
+     * @brief Construct a vector by evaluating an expression, e.g. a Vector.
+     * @tparam E The expression type.
+     * @param expression The expression to evaluate.
+     */
+    template <typename E>
+    constexpr AlignedVector(const VectorExpression<E, N, T> &expression) : m_data{} {
+        const E &e = expression.derived();
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] = e[i]; });
+    }
+
+    /**
+     * @brief Evaluate an expression into this.
+     * @tparam E The expression type.
+     * @param expression The expression to evaluate.
+     * @return A reference to this vector.
+     */
+    template <typename E>
+    constexpr AlignedVector &operator=(const VectorExpression<E, N, T> &expression) {
+        const E &e = expression.derived();
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] = e[i]; });
+        return *this;
+    }
+
+    /**
+     * @brief Copy this into an unpadded vector.
+     * @return The vector.
+     */
+    constexpr Vector<N, T> vector() const {
+        return Vector<N, T>(*this);
+    }
+
+    /**
+     * @brief Read access to idx.
+     * @param idx The index to read (0-indexed).
+     * @return The value at idx.
+     */
+    constexpr const T &operator[](unsigned idx) const {
+        return m_data[idx];
+    }
+
+    /**
+     * @brief Write access to idx.
+     * @param idx The index to write (0-indexed), only the first N values.
+     * @return A reference to the value at idx.
+     */
+    constexpr T &operator[](unsigned idx) {
+        return m_data[idx];
+    }
+
+    /**
+     * @brief Read access to x.
+     * @return The value at x.
+     */
+    constexpr const T &x() const {
+        return m_data[0];
+    }
+
+    /**
+     * @brief Write access to x.
+     * @return A reference to the value at x.
+     */
+    constexpr T &x() {
+        return m_data[0];
+    }
+
+    /**
+     * @brief Read access to y.
+     * @return The value at y.
+     */
+    constexpr const T &y() const {
+        static_assert(N >= 2 && "only for vectors with size >= 2");
+        return m_data[1];
+    }
+
+    /**
+     * @brief Write access to y.
+     * @return A reference to the value at y.
+     */
+    constexpr T &y() {
+        static_assert(N >= 2 && "only for vectors with size >= 2");
+        return m_data[1];
+    }
+
+    /**
+     * @brief Read access to z.
+     * @return The value at z.
+     */
+    constexpr const T &z() const {
+        static_assert(N >= 3 && "only for vectors with size >= 3");
+        return m_data[2];
+    }
+
+    /**
+     * @brief Write access to z.
+     * @return A reference to the value at z.
+     */
+    constexpr T &z() {
+        static_assert(N >= 3 && "only for vectors with size >= 3");
+        return m_data[2];
+    }
+
+    /**
+     * @brief Access the underlying data, padded values included.
+     * @return A pointer to the padded values.
+     */
+    constexpr const T *data() const {
+        return m_data;
+    }
+
+    /**
+     * @brief Access the underlying data, padded values included.
+     * @return A pointer to the padded values.
+     * @attention The padding must stay zero.
+     */
+    constexpr T *data() {
+        return m_data;
+    }
+
+    /**
+     * @brief Compute the dot-product with other.
+     * @param other The other vector.
+     * @return The dot-product with other.
+     */
+    constexpr T dot(const AlignedVector &other) const {
+        if constexpr (mathlib::simd::supported<T>) {
+            if (!MATHLIB_IS_CONSTANT_EVALUATED())
+                return mathlib::simd::dot<padded>(m_data, other.m_data);
+        }
+        T ret(0.);
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { ret += m_data[i] * other.m_data[i]; });
+        return ret;
+    }
+
+    /**
+     * @brief The squared euclidian norm.
+     * @return The norm \f$ || v ||_2^2 \f$
+     */
+    constexpr T squaredNorm() const {
+        return dot(*this);
+    }
+
+    /**
+     * @brief The euclidian norm.
+     * @return The norm \f$ || v ||_2 \f$
+     * @attention Only for floating point types.
+     */
+    T norm() const {
+        static_assert(std::is_floating_point<T>::value, "base type is not floating point.");
+        return std::sqrt(squaredNorm());
+    }
+
+    /**
+     * @brief Normalize this.
+     * @attention Only for floating point types.
+     */
+    void normalize() {
+        static_assert(std::is_floating_point<T>::value, "base type is not floating point.");
+        *this *= T(1.0) / std::sqrt(squaredNorm() + std::numeric_limits<T>::epsilon());
+    }
+
+    /**
+     * @brief Return a normalized copy of this.
+     * @return The normalized copy.
+     * @attention Only for floating point types.
+     */
+    AlignedVector normalized() const {
+        AlignedVector ret(*this);
+        ret.normalize();
+        return ret;
+    }
+
+    /**
+     * @brief Compute the cross product.
+     * @param other The other vector.
+     * @return The cross product of this and other.
+     * @attention Only for size 3!
+     */
+    constexpr AlignedVector cross(const AlignedVector &other) const {
+        static_assert(N == 3 && "cross is only defined for Vectors with size 3.");
+        return AlignedVector(m_data[1] * other.m_data[2] - m_data[2] * other.m_data[1],
+                             m_data[2] * other.m_data[0] - m_data[0] * other.m_data[2],
+                             m_data[0] * other.m_data[1] - m_data[1] * other.m_data[0]);
+    }
+
+    /**
+     * @brief Add another vector to this.
+     * @param other The other vector.
+     * @return A reference to this vector, with this + other.
+     */
+    constexpr AlignedVector &operator+=(const AlignedVector &other) {
+        return apply<mathlib::simd::AddOp>(other);
+    }
+
+    /**
+     * @brief Subtract another vector from this.
+     * @param other The other vector.
+     * @return A reference to this vector, with this - other.
+     */
+    constexpr AlignedVector &operator-=(const AlignedVector &other) {
+        return apply<mathlib::simd::SubOp>(other);
+    }
+
+    /**
+     * @brief Multiply another vector with this, element by element.
+     * @param other The other vector.
+     * @return A reference to this vector, with this * other.
+     */
+    constexpr AlignedVector &operator*=(const AlignedVector &other) {
+        return apply<mathlib::simd::MulOp>(other);
+    }
+
+    /**
+     * @brief Divide this by another vector, element by element.
+     * @param other The other vector.
+     * @return A reference to this vector, with this / other.
+     */
+    constexpr AlignedVector &operator/=(const AlignedVector &other) {
+        // The padding would compute 0 / 0.
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] /= other.m_data[i]; });
+        return *this;
+    }
+
+    /**
+     * @brief Multiply this by a scalar.
+     * @param value The scalar.
+     * @return A reference to this vector, with this * value.
+     */
+    constexpr AlignedVector &operator*=(const T &value) {
+        mathlib::detail::unroll<padded>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] *= value; });
+        return *this;
+    }
+
+    /**
+     * @brief Divide this by a scalar.
+     * @param value The scalar.
+     * @return A reference to this vector, with this / value.
+     */
+    constexpr AlignedVector &operator/=(const T &value) {
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] /= value; });
+        return *this;
+    }
+
+    /**
+     * @brief Check for equality.
+     * @param lhs The first vector.
+     * @param rhs The second vector.
+     * @return True if the vectors are equal (floating-point comparison).
+     */
+    friend bool operator==(const AlignedVector &lhs, const AlignedVector &rhs) {
+        return lhs.vector() == rhs.vector();
+    }
+
+    /**
+     * @brief Check for inequality.
+     * @param lhs The first vector.
+     * @param rhs The second vector.
+     * @return True if the vectors are not equal (floating-point comparison).
+     */
+    friend bool operator!=(const AlignedVector &lhs, const AlignedVector &rhs) {
+        return !(lhs == rhs);
+    }
+
+    /**
+     * @brief Write a vector to a stream.
+     * @param os The stream.
+     * @param v The vector.
+     * @return The stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const AlignedVector &v) {
+        return os << v.vector();
+    }
+
+private:
+    /**
+     * @brief Compute this[i] = Op(this[i], other[i]) on all padded values.
+     * @tparam Op The element-wise operation, must map zeros to zero.
+     * @param other The other vector.
+     * @return A reference to this vector.
+     */
+    template <typename Op>
+    constexpr AlignedVector &apply(const AlignedVector &other) {
+        // Scalar code over the aligned, padded values compiles to full register operations, and unlike the
+        // intrinsics of mathlib::simd::apply it does not hide the memory accesses from the optimizer.
+        mathlib::detail::unroll<padded>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] = Op::scalar(m_data[i], other.m_data[i]); });
+        return *this;
+    }
+
+private:
+    T m_data[padded];  ///< The underlying data, padded with zeros.
+};
+
+namespace mathlib {
+
+/**
+ * @brief Multiply many vectors with one matrix.
+ *
+ * The columns of the matrix are padded once, then every product is a sum of C full registers.
+ * @param m The matrix.
+ * @param in The vectors.
+ * @param out The products m * in[i]. May be in if R == C.
+ * @param count The number of vectors.
+ * @param threads The number of threads to use for large inputs, 0 for one per hardware thread.
+ */
+template <unsigned R, unsigned C, typename T>
+void transform(const Matrix<R, C, T> &m, const AlignedVector<C, T> *in, AlignedVector<R, T> *out, std::size_t count, unsigned threads = 1) {
+    constexpr unsigned P = AlignedVector<R, T>::padded;
+    alignas(AlignedVector<R, T>) T columns[C * P] = {};
+    for (unsigned c = 0; c < C; ++c)
+        for (unsigned r = 0; r < R; ++r)
+            columns[c * P + r] = m(r, c);
+
+    mathlib::parallelFor(count, threads, std::size_t(1) << 15, [&columns, in, out](std::size_t begin, std::size_t end) {
+        // A private copy of the columns stays in registers.
+        alignas(AlignedVector<R, T>) T cols[C * P];
+        std::copy(columns, columns + C * P, cols);
+        for (std::size_t i = begin; i < end; ++i)
+            mathlib::simd::combine<P, C>(cols, in[i].data(), out[i].data());
+    });
+}
+
+/**
+ * @brief Multiply vectors with one matrix in place.
+ * @param m The matrix.
+ * @param points The vectors.
+ * @param threads The number of threads to use for large inputs, 0 for one per hardware thread.
+ */
+template <unsigned N, typename T, typename Allocator>
+void transform(const Matrix<N, N, T> &m, std::vector<AlignedVector<N, T>, Allocator> &points, unsigned threads = 1) {
+    transform(m, points.data(), points.data(), points.size(), threads);
+}
+
+}  // namespace mathlib
+
+/**
+ * @brief Compute the matrix-vector product.
+ * @param m The matrix.
+ * @param v The vector.
+ * @return The product m * v.
+ */
+template <unsigned R, unsigned C, typename T>
+AlignedVector<R, T> operator*(const Matrix<R, C, T> &m, const AlignedVector<C, T> &v) {
+    AlignedVector<R, T> ret;
+    mathlib::transform(m, &v, &ret, 1);
+    return ret;
+}
+
+/**
+ * @name Defines
+ * @brief Underlying data type definitions.
+ */
+/** @{ */
+using AlignedVector3f = AlignedVector<3, float>;
+using AlignedVector4f = AlignedVector<4, float>;
+using AlignedVector3d = AlignedVector<3, double>;
+using AlignedVector4d = AlignedVector<4, double>;
+/** @} */
+
+#endif /* __MATHLIB_ALIGNED_VECTOR_H__ */
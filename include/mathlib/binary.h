@@ -0,0 +1,542 @@
+#ifndef __MATHLIB_BINARY_H__
+#define __MATHLIB_BINARY_H__
+
+#include <mathlib/quaternion.h>
+#include <mathlib/vector.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+// Only the file mapping API is used. The lean header leaves out rpcndr.h and its small macro. The near and far macros
+// of minwindef.h remain, as later Windows headers expand FAR to far, so mathlib does not use these names.
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mathlib {
+
+/**
+ * @brief Header of the binary array format.
+ *
+ * The file is this 64 byte header followed by count * dimension scalars in the byte order of the writer, so the
+ * values are aligned to 64 bytes in a memory-mapped file.
+ */
+struct BinaryHeader {
+    char magic[4];              ///< Always "MLBA".
+    std::uint32_t byte_order;   ///< 0x01020304 in the byte order of the writer.
+    std::uint32_t dimension;    ///< The number of scalars per element.
+    std::uint16_t version;      ///< The format version.
+    std::uint8_t kind;          ///< The element kind, see BinaryKind.
+    std::uint8_t scalar_kind;   ///< 'i' for signed, 'u' for unsigned integers, 'f' for floating point.
+    std::uint64_t count;        ///< The number of elements.
+    std::uint8_t scalar_size;   ///< The size of a scalar in bytes.
+    std::uint8_t reserved[39];  ///< Reserved, zero.
+};
+
+static_assert(sizeof(BinaryHeader) == 64, "unexpected binary header size.");
+
+/**
+ * @brief Element kinds of the binary array format.
+ */
+enum class BinaryKind : std::uint8_t {
+    Vector = 0,     ///< Vector<N, T>
+    Quaternion = 1  ///< Quaternion<T>
+};
+
+/**
+ * @brief Describes how an element type is stored in the binary array format.
+ * @tparam E The element type.
+ */
+template <typename E>
+struct BinaryTraits;
+
+/**
+ * @brief Vectors are stored as N scalars.
+ * @tparam N The size of the vector.
+ * @tparam T The underlying data type.
+ */
+template <unsigned N, typename T>
+struct BinaryTraits<Vector<N, T>> {
+    using scalar = T;                                      ///< The scalar type.
+    constexpr static BinaryKind kind = BinaryKind::Vector;  ///< The element kind.
+    constexpr static unsigned dimension = N;               ///< The number of scalars.
+};
+
+/**
+ * @brief Quaternions are stored as x, y, z, w.
+ * @tparam T The underlying data type.
+ */
+template <typename T>
+struct BinaryTraits<Quaternion<T>> {
+    using scalar = T;                                          ///< The scalar type.
+    constexpr static BinaryKind kind = BinaryKind::Quaternion;  ///< The element kind.
+    constexpr static unsigned dimension = 4;                   ///< The number of scalars.
+};
+
+namespace detail {
+
+/**
+ * @brief The byte order mark of the binary array format.
+ */
+constexpr std::uint32_t binary_byte_order = 0x01020304;
+
+/**
+ * @brief The current version of the binary array format.
+ */
+constexpr std::uint16_t binary_version = 1;
+
+/**
+ * @brief Create the header for an array.
+ * @tparam E The element type.
+ * @param count The number of elements.
+ * @return The header.
+ */
+template <typename E>
+BinaryHeader binaryHeader(std::uint64_t count) {
+    using T = typename BinaryTraits<E>::scalar;
+    static_assert(std::is_arithmetic<T>::value, "base type is not arithmetic.");
+    static_assert(sizeof(E) == BinaryTraits<E>::dimension * sizeof(T), "element type is not tightly packed.");
+    static_assert(std::is_trivially_copyable<E>::value, "element type is not trivially copyable.");
+
+    BinaryHeader header{};
+    std::memcpy(header.magic, "MLBA", 4);
+    header.byte_order = binary_byte_order;
+    header.dimension = BinaryTraits<E>::dimension;
+    header.version = binary_version;
+    header.kind = static_cast<std::uint8_t>(BinaryTraits<E>::kind);
+    header.scalar_kind = std::is_floating_point<T>::value ? 'f' : (std::is_signed<T>::value ? 'i' : 'u');
+    header.count = count;
+    header.scalar_size = sizeof(T);
+    return header;
+}
+
+/**
+ * @brief Reverse the bytes of a value.
+ * @param p The value.
+ * @param size The size of the value in bytes.
+ */
+inline void swapBytes(void *p, std::size_t size) {
+    unsigned char *bytes = static_cast<unsigned char *>(p);
+    std::reverse(bytes, bytes + size);
+}
+
+/**
+ * @brief Check that a header describes an array of E.
+ *
+ * The count and dimension of a header in foreign byte order are swapped in place.
+ * @tparam E The element type.
+ * @param header The header.
+ * @return True if the file was written with a different byte order.
+ * @throws std::runtime_error If the header does not match E.
+ */
+template <typename E>
+bool checkBinaryHeader(BinaryHeader &header) {
+    if (std::memcmp(header.magic, "MLBA", 4) != 0)
+        throw std::runtime_error("not a binary array file");
+
+    bool swapped = false;
+    if (header.byte_order != binary_byte_order) {
+        swapBytes(&header.byte_order, sizeof(header.byte_order));
+        if (header.byte_order != binary_byte_order)
+            throw std::runtime_error("invalid byte order");
+        swapBytes(&header.dimension, sizeof(header.dimension));
+        swapBytes(&header.version, sizeof(header.version));
+        swapBytes(&header.count, sizeof(header.count));
+        swapped = true;
+    }
+
+    const BinaryHeader expected = binaryHeader<E>(header.count);
+    if (header.version != expected.version)
+        throw std::runtime_error("unsupported binary array version");
+    if (header.kind != expected.kind || header.dimension != expected.dimension || header.scalar_kind != expected.scalar_kind ||
+        header.scalar_size != expected.scalar_size)
+        throw std::runtime_error("binary array type mismatch");
+    return swapped;
+}
+
+/**
+ * @brief A read-only mapping of a whole file.
+ */
+struct FileMapping {
+    void *address = nullptr;  ///< The start of the mapping.
+    std::size_t bytes = 0;    ///< The size of the mapping in bytes.
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;  ///< The file.
+    HANDLE mapping = nullptr;            ///< The file mapping.
+#endif
+};
+
+/**
+ * @brief Unmap a file, the mapping is empty afterwards.
+ * @param m The mapping.
+ */
+inline void unmapFile(FileMapping &m) noexcept {
+#ifdef _WIN32
+    if (m.address)
+        UnmapViewOfFile(m.address);
+    if (m.mapping)
+        CloseHandle(m.mapping);
+    if (m.file != INVALID_HANDLE_VALUE)
+        CloseHandle(m.file);
+#else
+    if (m.address)
+        ::munmap(m.address, m.bytes);
+#endif
+    m = FileMapping();
+}
+
+/**
+ * @brief Map a whole file read-only.
+ * @param path The path of the file.
+ * @return The mapping, without an address if the file is empty.
+ * @throws std::runtime_error If the file can not be mapped.
+ */
+inline FileMapping mapFile(const std::string &path) {
+    FileMapping m;
+#ifdef _WIN32
+    m.file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    LARGE_INTEGER size;
+    if (m.file == INVALID_HANDLE_VALUE || !GetFileSizeEx(m.file, &size)) {
+        unmapFile(m);
+        throw std::runtime_error("cannot open " + path);
+    }
+    m.bytes = std::size_t(size.QuadPart);
+    if (m.bytes == 0)
+        return m;
+    m.mapping = CreateFileMappingA(m.file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    m.address = m.mapping ? MapViewOfFile(m.mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!m.address) {
+        unmapFile(m);
+        throw std::runtime_error("cannot map " + path);
+    }
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || ::fstat(fd, &st) != 0) {
+        if (fd >= 0)
+            ::close(fd);
+        throw std::runtime_error("cannot open " + path);
+    }
+    m.bytes = std::size_t(st.st_size);
+    if (m.bytes > 0) {
+        void *address = ::mmap(nullptr, m.bytes, PROT_READ, MAP_SHARED, fd, 0);
+        if (address == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("cannot map " + path);
+        }
+        m.address = address;
+    }
+    ::close(fd);
+#endif
+    return m;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Streams an array to a binary file, element by element.
+ *
+ * The header is written first and its count is updated by close().
+ * @tparam E The element type, a Vector or Quaternion.
+ */
+template <typename E>
+class BinaryWriter {
+public:
+    /**
+     * @brief Create a file and write the header.
+     * @param path The path of the file.
+     * @throws std::runtime_error If the file can not be created.
+     */
+    explicit BinaryWriter(const std::string &path) : m_stream(path, std::ios::binary | std::ios::trunc) {
+        if (!m_stream)
+            throw std::runtime_error("cannot open " + path);
+        const BinaryHeader header = detail::binaryHeader<E>(0);
+        m_stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    }
+
+    /**
+     * @brief Close the file, errors are ignored. Call close() to handle them.
+     */
+    ~BinaryWriter() {
+        try {
+            close();
+        } catch (...) {
+        }
+    }
+
+    /**
+     * @brief Append an element.
+     * @param e The element.
+     */
+    void write(const E &e) {
+        write(&e, 1);
+    }
+
+    /**
+     * @brief Append a range of elements.
+     * @param data The elements.
+     * @param count The number of elements.
+     */
+    void write(const E *data, std::size_t count) {
+        m_stream.write(reinterpret_cast<const char *>(data), std::streamsize(count * sizeof(E)));
+        m_count += count;
+    }
+
+    /**
+     * @brief Append elements.
+     * @param data The elements.
+     */
+    void write(const std::vector<E> &data) {
+        write(data.data(), data.size());
+    }
+
+    /**
+     * @brief The number of elements written so far.
+     * @return The number of elements.
+     */
+    std::uint64_t count() const {
+        return m_count;
+    }
+
+    /**
+     * @brief Write the final count to the header and close the file.
+     * @throws std::runtime_error If writing failed.
+     */
+    void close() {
+        if (!m_stream.is_open())
+            return;
+        m_stream.seekp(offsetof(BinaryHeader, count));
+        m_stream.write(reinterpret_cast<const char *>(&m_count), sizeof(m_count));
+        m_stream.close();
+        if (m_stream.fail())
+            throw std::runtime_error("writing binary array failed");
+    }
+
+private:
+    std::ofstream m_stream;   ///< The file.
+    std::uint64_t m_count = 0;  ///< The number of elements written.
+};
+
+/**
+ * @brief Write a range of elements to a binary file.
+ * @tparam E The element type, a Vector or Quaternion.
+ * @param path The path of the file.
+ * @param data The elements.
+ * @param count The number of elements.
+ * @throws std::runtime_error If writing failed.
+ */
+template <typename E>
+void writeBinary(const std::string &path, const E *data, std::size_t count) {
+    BinaryWriter<E> writer(path);
+    writer.write(data, count);
+    writer.close();
+}
+
+/**
+ * @brief Write elements to a binary file.
+ * @tparam E The element type, a Vector or Quaternion.
+ * @param path The path of the file.
+ * @param data The elements.
+ * @throws std::runtime_error If writing failed.
+ */
+template <typename E>
+void writeBinary(const std::string &path, const std::vector<E> &data) {
+    writeBinary(path, data.data(), data.size());
+}
+
+/**
+ * @brief Read a binary file into memory.
+ *
+ * Files written with a different byte order are converted.
+ * @tparam E The element type, a Vector or Quaternion.
+ * @param path The path of the file.
+ * @return The elements.
+ * @throws std::runtime_error If the file can not be read or does not contain elements of type E.
+ */
+template <typename E>
+std::vector<E> readBinary(const std::string &path) {
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream)
+        throw std::runtime_error("cannot open " + path);
+
+    BinaryHeader header;
+    if (!stream.read(reinterpret_cast<char *>(&header), sizeof(header)))
+        throw std::runtime_error("truncated binary array");
+    const bool swapped = detail::checkBinaryHeader<E>(header);
+
+    // Check the count against the file size before allocating, a corrupt count must not exhaust the memory.
+    const std::streamoff data_begin = stream.tellg();
+    stream.seekg(0, std::ios::end);
+    const std::streamoff data_end = stream.tellg();
+    stream.seekg(data_begin);
+    if (data_begin < 0 || data_end < data_begin || header.count > std::uint64_t(data_end - data_begin) / sizeof(E))
+        throw std::runtime_error("truncated binary array");
+
+    std::vector<E> ret(header.count);
+    if (!stream.read(reinterpret_cast<char *>(ret.data()), std::streamsize(ret.size() * sizeof(E))))
+        throw std::runtime_error("truncated binary array");
+    if (swapped) {
+        using T = typename BinaryTraits<E>::scalar;
+        T *scalars = reinterpret_cast<T *>(ret.data());
+        for (std::size_t i = 0; i < ret.size() * BinaryTraits<E>::dimension; ++i)
+            detail::swapBytes(scalars + i, sizeof(T));
+    }
+    return ret;
+}
+
+/**
+ * @brief Read-only, memory-mapped view of a binary file.
+ *
+ * The elements are used in place, nothing is copied.
+ * @tparam E The element type, a Vector or Quaternion.
+ */
+template <typename E>
+class MappedArray {
+public:
+    /**
+     * @brief Map a binary file.
+     * @param path The path of the file.
+     * @throws std::runtime_error If the file can not be mapped, does not contain elements of type E or was written
+     * with a different byte order (use readBinary() for those).
+     */
+    explicit MappedArray(const std::string &path) : m_file(detail::mapFile(path)) {
+        try {
+            if (m_file.bytes < sizeof(BinaryHeader))
+                throw std::runtime_error("truncated binary array");
+            BinaryHeader header;
+            std::memcpy(&header, m_file.address, sizeof(header));
+            if (detail::checkBinaryHeader<E>(header))
+                throw std::runtime_error("binary array has foreign byte order");
+            if (header.count > (m_file.bytes - sizeof(BinaryHeader)) / sizeof(E))
+                throw std::runtime_error("truncated binary array");
+            m_size = std::size_t(header.count);
+        } catch (...) {
+            unmap();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Move a mapping.
+     * @param other The other mapping, empty afterwards.
+     */
+    MappedArray(MappedArray &&other) noexcept {
+        *this = std::move(other);
+    }
+
+    /**
+     * @brief Move a mapping.
+     * @param other The other mapping, empty afterwards.
+     * @return A reference to this mapping.
+     */
+    MappedArray &operator=(MappedArray &&other) noexcept {
+        if (this != &other) {
+            unmap();
+            std::swap(m_file, other.m_file);
+            std::swap(m_size, other.m_size);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Mappings can not be copied.
+     */
+    MappedArray(const MappedArray &) = delete;
+
+    /**
+     * @brief Mappings can not be copied.
+     */
+    MappedArray &operator=(const MappedArray &) = delete;
+
+    /**
+     * @brief Unmap the file.
+     */
+    ~MappedArray() {
+        unmap();
+    }
+
+    /**
+     * @brief The number of elements.
+     * @return The number of elements.
+     */
+    std::size_t size() const {
+        return m_size;
+    }
+
+    /**
+     * @brief Check if the array is empty.
+     * @return True if there are no elements.
+     */
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    /**
+     * @brief The elements.
+     * @return A pointer to size() elements, valid while this mapping exists.
+     */
+    const E *data() const {
+        return reinterpret_cast<const E *>(static_cast<const char *>(m_file.address) + sizeof(BinaryHeader));
+    }
+
+    /**
+     * @brief Iterator to the first element.
+     * @return The iterator.
+     */
+    const E *begin() const {
+        return data();
+    }
+
+    /**
+     * @brief Iterator behind the last element.
+     * @return The iterator.
+     */
+    const E *end() const {
+        return data() + m_size;
+    }
+
+    /**
+     * @brief Read access to idx.
+     * @param idx The index to read (0-indexed).
+     * @return The element at idx.
+     * @attention Does not perform index boundary checks.
+     */
+    const E &operator[](std::size_t idx) const {
+        return data()[idx];
+    }
+
+private:
+    /**
+     * @brief Unmap the file, this is empty afterwards.
+     */
+    void unmap() {
+        detail::unmapFile(m_file);
+        m_size = 0;
+    }
+
+    detail::FileMapping m_file;  ///< The mapped file.
+    std::size_t m_size = 0;      ///< The number of elements.
+};
+
+}  // namespace mathlib
+
+#endif /* __MATHLIB_BINARY_H__ */
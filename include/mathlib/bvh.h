@@ -0,0 +1,563 @@
+#ifndef __MATHLIB_BVH_H__
+#define __MATHLIB_BVH_H__
+
+#include <mathlib/parallel.h>
+#include <mathlib/ray.h>
+#include <mathlib/vector.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief Static bounding volume hierarchy over a set of triangles.
+ *
+ * Built with binned surface area heuristic splits. The nodes are stored in one flat array and the two children of
+ * an inner node are adjacent. The triangles are copied in leaf order as one corner and two edges, so every leaf is
+ * a contiguous block of memory and the Möller–Trumbore test does not recompute the edges.
+ * @tparam T The underlying data type.
+ */
+template <typename T>
+class Bvh {
+public:
+    using type = T;                       ///< The underlying data type.
+    using Vector_t = Vector<3, T>;        ///< The vector type.
+    using Ray_t = Ray<T>;                 ///< The ray type.
+    using Hit_t = RayHit<T>;              ///< The result type.
+    using Triangle_t = Triangle<T>;       ///< The triangle type.
+
+    /**
+     * @brief Index of a missing triangle.
+     */
+    constexpr static std::uint32_t npos = RayHit<T>::npos;
+
+    /**
+     * @brief Create an empty hierarchy.
+     */
+    Bvh() = default;
+
+    /**
+     * @brief Build a hierarchy.
+     * @param triangles The triangles, copied into the hierarchy.
+     * @param count The number of triangles.
+     * @param threads The number of threads, 0 for one per hardware thread.
+     * @param leaf_size The maximal number of triangles per leaf.
+     */
+    Bvh(const Triangle_t *triangles, std::size_t count, unsigned threads = 1, unsigned leaf_size = 4) {
+        assert(count < npos);
+        if (count == 0)
+            return;
+
+        std::vector<Item> items(count);
+        mathlib::parallelFor(count, threads, build_grain, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i)
+                items[i] = Item{triangles[i].bounds(), std::uint32_t(i)};
+        });
+
+        // The large nodes at the top are split one at a time with parallel binning, the remaining subtrees are
+        // independent ranges of items and built in parallel into their own node arrays.
+        const Builder builder{items.data(), std::min(std::max(leaf_size, 1u), max_leaf_size)};
+        std::vector<Task> tasks;
+        m_nodes.emplace_back();
+        builder.split(m_nodes, 0, 0, std::uint32_t(count), builder.bounds(0, std::uint32_t(count), threads), 0, threads, &tasks);
+
+        std::vector<std::vector<Node>> subtrees(tasks.size());
+        mathlib::parallelFor(tasks.size(), threads, 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t t = begin; t < end; ++t) {
+                subtrees[t].emplace_back();
+                builder.split(subtrees[t], 0, tasks[t].begin, tasks[t].end, tasks[t].bounds, tasks[t].depth, 1, nullptr);
+            }
+        });
+        for (std::size_t t = 0; t < tasks.size(); ++t) {
+            // Node k > 0 of a subtree moves to base + k.
+            const std::uint32_t base = std::uint32_t(m_nodes.size()) - 1;
+            const auto remap = [base](Node node) {
+                if (node.count == 0)
+                    node.offset += base;
+                return node;
+            };
+            m_nodes[tasks[t].node] = remap(subtrees[t][0]);
+            for (std::size_t k = 1; k < subtrees[t].size(); ++k)
+                m_nodes.push_back(remap(subtrees[t][k]));
+        }
+
+        m_triangles.resize(count);
+        m_indices.resize(count);
+        mathlib::parallelFor(count, threads, build_grain, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const Triangle_t &triangle = triangles[items[i].index];
+                m_triangles[i] = Edges{triangle.v0, triangle.v1 - triangle.v0, triangle.v2 - triangle.v0};
+                m_indices[i] = items[i].index;
+            }
+        });
+    }
+
+    /**
+     * @brief Build a hierarchy.
+     * @param triangles The triangles, copied into the hierarchy.
+     * @param threads The number of threads, 0 for one per hardware thread.
+     * @param leaf_size The maximal number of triangles per leaf.
+     */
+    explicit Bvh(const std::vector<Triangle_t> &triangles, unsigned threads = 1, unsigned leaf_size = 4)
+        : Bvh(triangles.data(), triangles.size(), threads, leaf_size) {}
+
+    /**
+     * @brief The number of triangles.
+     * @return The number of triangles.
+     */
+    std::size_t size() const {
+        return m_triangles.size();
+    }
+
+    /**
+     * @brief Check if the hierarchy is empty.
+     * @return True if there are no triangles.
+     */
+    bool empty() const {
+        return m_triangles.empty();
+    }
+
+    /**
+     * @brief The bounding box of all triangles.
+     * @return The bounding box, empty for an empty hierarchy.
+     */
+    Aabb<T> bounds() const {
+        return m_nodes.empty() ? Aabb<T>() : m_nodes[0].box;
+    }
+
+    /**
+     * @brief Find the closest triangle hit by a ray.
+     * @param ray The ray.
+     * @return The closest hit within [t_min, t_max], index is npos if no triangle is hit.
+     */
+    Hit_t intersect(const Ray_t &ray) const {
+        Hit_t hit;
+        traverse<false>(ray, hit);
+        return hit;
+    }
+
+    /**
+     * @brief Check if a ray hits any triangle, e.g. for shadow rays.
+     * @param ray The ray.
+     * @return True if a triangle is hit within [t_min, t_max].
+     */
+    bool occluded(const Ray_t &ray) const {
+        Hit_t hit;
+        return traverse<true>(ray, hit);
+    }
+
+    /**
+     * @brief Find the closest triangles hit by a packet of rays.
+     *
+     * The packet visits a node if any of its rays hits the node, so the rays should be coherent, e.g. neighboring
+     * primary rays.
+     * @tparam W The number of rays.
+     * @param rays The rays, t_max is lowered to the closest hit.
+     * @param hits Receives the closest hits, lanes which hit nothing are unchanged.
+     */
+    template <unsigned W>
+    void intersect(RayPacket<W, T> &rays, HitPacket<W, T> &hits) const {
+        if (m_nodes.empty())
+            return;
+
+        std::uint32_t stack[max_depth];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node &node = m_nodes[stack[--top]];
+            const std::uint32_t mask = mathlib::intersect(rays, node.box);
+            if (mask == 0)
+                continue;
+
+            if (node.count > 0) {
+                for (std::uint32_t i = node.offset; i < node.offset + node.count; ++i)
+                    mathlib::detail::intersectTriangle(rays, m_triangles[i].v0, m_triangles[i].e1, m_triangles[i].e2, m_indices[i], hits);
+                continue;
+            }
+
+            // Visit the near child first, as seen by the first active ray.
+            unsigned lane = 0;
+            while (!((mask >> lane) & 1u))
+                ++lane;
+            const bool reverse = rays.direction[node.axis][lane] < T(0);
+            stack[top++] = reverse ? node.offset : node.offset + 1;
+            stack[top++] = reverse ? node.offset + 1 : node.offset;
+        }
+    }
+
+    /**
+     * @brief Find the closest triangles hit by many rays.
+     * @tparam W The number of rays traced together, 1 traces every ray on its own.
+     * @param rays The rays.
+     * @param count The number of rays.
+     * @param hits Receives the closest hits, must hold count values.
+     * @param threads The number of threads, 0 for one per hardware thread.
+     */
+    template <unsigned W = 1>
+    void intersect(const Ray_t *rays, std::size_t count, Hit_t *hits, unsigned threads = 1) const {
+        mathlib::parallelFor(count, threads, query_grain, [&](std::size_t begin, std::size_t end) {
+            if constexpr (W == 1) {
+                for (std::size_t q = begin; q < end; ++q)
+                    hits[q] = intersect(rays[q]);
+            } else {
+                for (std::size_t q = begin; q < end; q += W) {
+                    const unsigned n = unsigned(std::min<std::size_t>(W, end - q));
+                    RayPacket<W, T> packet(rays + q, n);
+                    HitPacket<W, T> packet_hits;
+                    intersect(packet, packet_hits);
+                    for (unsigned l = 0; l < n; ++l)
+                        hits[q + l] = packet_hits.hit(l);
+                }
+            }
+        });
+    }
+
+private:
+    /**
+     * @brief Number of bins of the surface area heuristic along the axis with the largest extent of the centers.
+     */
+    constexpr static unsigned sah_bins = 12;
+
+    /**
+     * @brief Upper bound of the leaf size, leaf counts are stored in 16 bits.
+     */
+    constexpr static unsigned max_leaf_size = 255;
+
+    /**
+     * @brief Depth from which nodes are split at the median, so the depth stays below max_depth.
+     */
+    constexpr static unsigned max_sah_depth = 64;
+
+    /**
+     * @brief Size of the traversal stacks, larger than the depth of any hierarchy with less than 2^32 triangles.
+     */
+    constexpr static unsigned max_depth = 128;
+
+    /**
+     * @brief Subtrees with at most this number of triangles are built on one thread.
+     */
+    constexpr static std::uint32_t task_size = 1u << 12;
+
+    /**
+     * @brief Minimal number of triangles per thread in the parallel parts of the build.
+     */
+    constexpr static std::size_t build_grain = 1u << 14;
+
+    /**
+     * @brief Minimal number of rays per thread in the batched queries.
+     */
+    constexpr static std::size_t query_grain = 256;
+
+    /**
+     * @brief A node of the hierarchy.
+     */
+    struct Node {
+        Aabb<T> box;               ///< The bounding box of the subtree.
+        std::uint32_t offset = 0;  ///< The first child of an inner node, the first triangle of a leaf.
+        std::uint16_t count = 0;   ///< The number of triangles of a leaf, 0 for inner nodes.
+        std::uint16_t axis = 0;    ///< The split axis of an inner node.
+    };
+
+    /**
+     * @brief A triangle as one corner and the two edges leaving it.
+     */
+    struct Edges {
+        Vector_t v0;  ///< The first corner.
+        Vector_t e1;  ///< The edge v1 - v0.
+        Vector_t e2;  ///< The edge v2 - v0.
+    };
+
+    /**
+     * @brief A triangle during the build, the builder reorders these instead of indices to keep its passes sequential.
+     */
+    struct Item {
+        Aabb<T> box;          ///< The bounding box of the triangle.
+        std::uint32_t index;  ///< The input index of the triangle.
+    };
+
+    /**
+     * @brief The bounding boxes of a range of triangles and of their centers.
+     */
+    struct Bounds {
+        Aabb<T> box;      ///< The bounding box of the triangles.
+        Aabb<T> centers;  ///< The bounding box of the centers.
+
+        /**
+         * @brief Add a triangle.
+         * @param item The triangle.
+         * @param center The center of its bounding box.
+         */
+        void extend(const Item &item, const Vector_t &center) {
+            box.extend(item.box);
+            centers.extend(center);
+        }
+
+        /**
+         * @brief Merge the bounds of another range.
+         * @param other The other bounds.
+         */
+        void merge(const Bounds &other) {
+            box.extend(other.box);
+            centers.extend(other.centers);
+        }
+    };
+
+    /**
+     * @brief A subtree left for the parallel phase of the build.
+     */
+    struct Task {
+        std::uint32_t node;   ///< The root of the subtree, its box is already set.
+        std::uint32_t begin;  ///< The first triangle.
+        std::uint32_t end;    ///< Behind the last triangle.
+        Bounds bounds;        ///< The bounds of the triangles.
+        unsigned depth;       ///< The depth of the root.
+    };
+
+    /**
+     * @brief The bins of a range of triangles along the split axis.
+     */
+    struct Bins {
+        Bounds bounds[sah_bins];             ///< The bounds of the triangles per bin.
+        std::uint32_t count[sah_bins] = {};  ///< The number of triangles per bin.
+
+        /**
+         * @brief Merge the bins of another range.
+         * @param other The other bins.
+         */
+        void merge(const Bins &other) {
+            for (unsigned k = 0; k < sah_bins; ++k) {
+                bounds[k].merge(other.bounds[k]);
+                count[k] += other.count[k];
+            }
+        }
+    };
+
+    /**
+     * @brief The state shared by all splits of a build.
+     */
+    struct Builder {
+        Item *items;         ///< The triangles, reordered in place.
+        unsigned leaf_size;  ///< The maximal number of triangles per leaf.
+
+        /**
+         * @brief Combine per-chunk results of a range in parallel.
+         * @tparam R The result type, with a merge(const R &) method.
+         * @tparam F The function type.
+         * @param begin The first triangle.
+         * @param end Behind the last triangle.
+         * @param threads The number of threads.
+         * @param f The function, called as f(result, begin, end) for every chunk.
+         * @return The merged result.
+         */
+        template <typename R, typename F>
+        static R reduce(std::uint32_t begin, std::uint32_t end, unsigned threads, F &&f) {
+            if (threads == 1 || end - begin < 2 * build_grain) {
+                R ret;
+                f(ret, begin, end);
+                return ret;
+            }
+            std::vector<R> partial(mathlib::threadCount(threads));
+            const std::size_t chunks = mathlib::parallelChunks(end - begin, threads, build_grain, [&](std::size_t c, std::size_t b, std::size_t e) {
+                f(partial[c], begin + std::uint32_t(b), begin + std::uint32_t(e));
+            });
+            for (std::size_t c = 1; c < chunks; ++c)
+                partial[0].merge(partial[c]);
+            return partial[0];
+        }
+
+        /**
+         * @brief The bounds of a range of triangles.
+         * @param begin The first triangle.
+         * @param end Behind the last triangle.
+         * @param threads The number of threads.
+         * @return The bounds.
+         */
+        Bounds bounds(std::uint32_t begin, std::uint32_t end, unsigned threads) const {
+            return reduce<Bounds>(begin, end, threads, [this](Bounds &r, std::uint32_t b, std::uint32_t e) {
+                for (std::uint32_t i = b; i < e; ++i)
+                    r.extend(items[i], items[i].box.center());
+            });
+        }
+
+        /**
+         * @brief The bin of a center.
+         * @param value The coordinate of the center.
+         * @param lo The lower bound of the centers.
+         * @param scale The number of bins per unit.
+         * @return The bin.
+         */
+        static unsigned bin(T value, T lo, T scale) {
+            return std::min(unsigned((value - lo) * scale), sah_bins - 1);
+        }
+
+        /**
+         * @brief Build the subtree of [begin, end).
+         * @param nodes The nodes, node is set and its children appended.
+         * @param node The root of the subtree.
+         * @param begin The first triangle.
+         * @param end Behind the last triangle.
+         * @param range The bounds of the triangles.
+         * @param depth The depth of node.
+         * @param threads The number of threads for binning.
+         * @param tasks Receives subtrees with at most task_size triangles instead of building them, may be nullptr.
+         */
+        void split(std::vector<Node> &nodes, std::uint32_t node, std::uint32_t begin, std::uint32_t end, const Bounds &range, unsigned depth,
+                   unsigned threads, std::vector<Task> *tasks) const {
+            nodes[node].box = range.box;
+            const std::uint32_t count = end - begin;
+            if (count <= leaf_size) {
+                nodes[node].offset = begin;
+                nodes[node].count = std::uint16_t(count);
+                return;
+            }
+            if (tasks && count <= task_size) {
+                tasks->push_back(Task{node, begin, end, range, depth});
+                return;
+            }
+
+            const Aabb<T> &c = range.centers;
+            unsigned axis = 0;
+            for (unsigned a = 1; a < 3; ++a)
+                if (c.hi[a] - c.lo[a] > c.hi[axis] - c.lo[axis])
+                    axis = a;
+
+            std::uint32_t mid = begin;
+            Bounds left, right;
+            if (depth < max_sah_depth && c.hi[axis] > c.lo[axis]) {
+                const T lo = c.lo[axis], scale = T(sah_bins) / (c.hi[axis] - c.lo[axis]);
+                const Bins bins = reduce<Bins>(begin, end, threads, [&](Bins &r, std::uint32_t b, std::uint32_t e) {
+                    for (std::uint32_t i = b; i < e; ++i) {
+                        const Vector_t center = items[i].box.center();
+                        const unsigned k = bin(center[axis], lo, scale);
+                        r.bounds[k].extend(items[i], center);
+                        ++r.count[k];
+                    }
+                });
+
+                // Cost of splitting before bin k: area(left) * count(left) + area(right) * count(right).
+                T cost_right[sah_bins];
+                Aabb<T> box;
+                std::uint32_t n = 0;
+                for (unsigned k = sah_bins - 1; k > 0; --k) {
+                    box.extend(bins.bounds[k].box);
+                    n += bins.count[k];
+                    cost_right[k] = box.surfaceArea() * T(n);
+                }
+                T best = std::numeric_limits<T>::max();
+                unsigned best_bin = 0;
+                box = Aabb<T>();
+                n = 0;
+                for (unsigned k = 1; k < sah_bins; ++k) {
+                    box.extend(bins.bounds[k - 1].box);
+                    n += bins.count[k - 1];
+                    const T cost = box.surfaceArea() * T(n) + cost_right[k];
+                    if (n > 0 && n < count && cost < best) {
+                        best = cost;
+                        best_bin = k;
+                    }
+                }
+                if (best_bin > 0) {
+                    for (unsigned k = 0; k < sah_bins; ++k)
+                        (k < best_bin ? left : right).merge(bins.bounds[k]);
+                    mid = std::uint32_t(
+                        std::partition(items + begin, items + end, [&](const Item &item) { return bin(item.box.center()[axis], lo, scale) < best_bin; }) -
+                        items);
+                }
+            }
+            if (mid == begin || mid == end) {
+                // Coincident centers, no useful bin or a very deep tree, split at the median to bound the depth.
+                mid = begin + count / 2;
+                std::nth_element(items + begin, items + mid, items + end, [axis](const Item &a, const Item &b) {
+                    return a.box.lo[axis] + a.box.hi[axis] < b.box.lo[axis] + b.box.hi[axis];
+                });
+                left = bounds(begin, mid, threads);
+                right = bounds(mid, end, threads);
+            }
+
+            const std::uint32_t first = std::uint32_t(nodes.size());
+            nodes[node].offset = first;
+            nodes[node].count = 0;
+            nodes[node].axis = std::uint16_t(axis);
+            nodes.emplace_back();
+            nodes.emplace_back();
+            split(nodes, first, begin, mid, left, depth + 1, threads, tasks);
+            split(nodes, first + 1, mid, end, right, depth + 1, threads, tasks);
+        }
+    };
+
+    /**
+     * @brief Trace a single ray, nearer children first.
+     * @tparam Any Stop at the first hit instead of the closest one.
+     * @param ray The ray.
+     * @param hit Receives the hit.
+     * @return True if a triangle was hit.
+     */
+    template <bool Any>
+    bool traverse(const Ray_t &ray, Hit_t &hit) const {
+        if (m_nodes.empty())
+            return false;
+
+        Ray_t r(ray);
+        const Vector_t inv(T(1) / ray.direction[0], T(1) / ray.direction[1], T(1) / ray.direction[2]);
+        struct Entry {
+            std::uint32_t node;  ///< The subtree.
+            T t;                 ///< The distance at which the ray enters the subtree.
+        };
+        Entry stack[max_depth];
+        int top = 0;
+        T t;
+        if (!mathlib::intersect(r, inv, m_nodes[0].box, t))
+            return false;
+        stack[top++] = Entry{0, t};
+        while (top > 0) {
+            const Entry entry = stack[--top];
+            if (entry.t > r.t_max)
+                continue;
+
+            const Node &node = m_nodes[entry.node];
+            if (node.count > 0) {
+                for (std::uint32_t i = node.offset; i < node.offset + node.count; ++i) {
+                    if (mathlib::detail::intersectTriangle(r, m_triangles[i].v0, m_triangles[i].e1, m_triangles[i].e2, hit)) {
+                        hit.index = m_indices[i];
+                        if (Any)
+                            return true;
+                        r.t_max = hit.t;
+                    }
+                }
+                continue;
+            }
+
+            T t0, t1;
+            const bool hit0 = mathlib::intersect(r, inv, m_nodes[node.offset].box, t0);
+            const bool hit1 = mathlib::intersect(r, inv, m_nodes[node.offset + 1].box, t1);
+            if (hit0 && hit1) {
+                const bool reverse = t1 < t0;
+                stack[top++] = reverse ? Entry{node.offset, t0} : Entry{node.offset + 1, t1};
+                stack[top++] = reverse ? Entry{node.offset + 1, t1} : Entry{node.offset, t0};
+            } else if (hit0) {
+                stack[top++] = Entry{node.offset, t0};
+            } else if (hit1) {
+                stack[top++] = Entry{node.offset + 1, t1};
+            }
+        }
+        return hit.valid();
+    }
+
+    std::vector<Node> m_nodes;             ///< The nodes, children of a node are adjacent.
+    std::vector<Edges> m_triangles;        ///< The triangles, in leaf order.
+    std::vector<std::uint32_t> m_indices;  ///< The input index of every triangle.
+};
+
+/**
+ * @name Defines
+ * @brief Underlying data type definitions.
+ */
+/** @{ */
+using Bvhf = Bvh<float>;
+using Bvhd = Bvh<double>;
+/** @} */
+
+#endif /* __MATHLIB_BVH_H__ */
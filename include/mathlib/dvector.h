@@ -0,0 +1,744 @@
+#ifndef __MATHLIB_DVECTOR_H__
+#define __MATHLIB_DVECTOR_H__
+
+#include <mathlib/memory.h>
+#include <mathlib/simd.h>
+#include <mathlib/vector.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @brief %Vector class with a size chosen at runtime.
+ *
+ * Mirrors the API of Vector. Small vectors are stored inline, larger ones get their memory from the allocator,
+ * e.g. an ArenaAllocator to avoid malloc for short-lived vectors.
+ * @tparam T The underlying data type.
+ * @tparam Allocator The allocator for vectors larger than InlineCapacity.
+ * @tparam InlineCapacity Vectors up to this size are stored inside the object.
+ */
+template <typename T, typename Allocator = std::allocator<T>, unsigned InlineCapacity = 16>
+class DVector {
+public:
+    using type = T;                     ///< The underlying data type.
+    using allocator_type = Allocator;  ///< The allocator type.
+
+    /**
+     * @brief Construct an empty vector.
+     * @param alloc The allocator.
+     */
+    explicit DVector(const Allocator &alloc = Allocator()) : m_alloc(alloc) {}
+
+    /**
+     * @brief Construct a zero vector.
+     * @param size The size of the vector.
+     * @param alloc The allocator.
+     */
+    explicit DVector(std::size_t size, const Allocator &alloc = Allocator()) : DVector(size, T(0.), alloc) {}
+
+    /**
+     * @brief Construct a vector from a single value.
+     * @param size The size of the vector.
+     * @param t The single value
+     * @param alloc The allocator.
+     */
+    DVector(std::size_t size, T t, const Allocator &alloc) : m_alloc(alloc) {
+        allocate(size);
+        std::fill(m_data, m_data + m_size, t);
+    }
+
+    /**
+     * @brief Construct a vector from a single value.
+     * @param size The size of the vector.
+     * @param t The single value
+     */
+    DVector(std::size_t size, T t) : DVector(size, t, Allocator()) {}
+
+    /**
+     * @brief Construct a vector from given data.
+     * @param data The data to use.
+     * @param alloc The allocator.
+     */
+    DVector(std::initializer_list<T> data, const Allocator &alloc = Allocator()) : m_alloc(alloc) {
+        allocate(data.size());
+        std::copy(data.begin(), data.end(), m_data);
+    }
+
+    /**
+     * @brief Construct a vector from a fixed-size vector.
+     * @tparam N The size of the vector.
+     * @param v The vector.
+     * @param alloc The allocator.
+     */
+    template <unsigned N>
+    explicit DVector(const Vector<N, T> &v, const Allocator &alloc = Allocator()) : m_alloc(alloc) {
+        allocate(N);
+        for (unsigned i = 0; i < N; ++i)
+            m_data[i] = v[i];
+    }
+
+    /**
+     * @brief Construct a vector from another vector.
+     * @param other The other vector.
+     */
+    DVector(const DVector &other) : DVector(other, std::allocator_traits<Allocator>::select_on_container_copy_construction(other.m_alloc)) {}
+
+    /**
+     * @brief Construct a vector from another vector, with a different allocator.
+     * @param other The other vector.
+     * @param alloc The allocator.
+     */
+    DVector(const DVector &other, const Allocator &alloc) : m_alloc(alloc) {
+        allocate(other.m_size);
+        std::copy(other.m_data, other.m_data + m_size, m_data);
+    }
+
+    /**
+     * @brief Move a vector, stealing its memory if it is not stored inline.
+     * @param other The other vector, empty afterwards.
+     */
+    DVector(DVector &&other) noexcept : m_alloc(std::move(other.m_alloc)) {
+        steal(other);
+    }
+
+    /**
+     * @brief Assign another vector to this.
+     * @param other The other vector.
+     * @return A reference to this vector.
+     */
+    DVector &operator=(const DVector &other) {
+        if (this != &other) {
+            if (m_size != other.m_size) {
+                deallocate();
+                allocate(other.m_size);
+            }
+            std::copy(other.m_data, other.m_data + m_size, m_data);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Move another vector to this.
+     *
+     * The memory is stolen if both use equal allocators, otherwise the values are copied.
+     * @param other The other vector.
+     * @return A reference to this vector.
+     */
+    DVector &operator=(DVector &&other) noexcept(std::allocator_traits<Allocator>::is_always_equal::value) {
+        if (this == &other)
+            return *this;
+        if (m_alloc == other.m_alloc) {
+            deallocate();
+            steal(other);
+        } else {
+            *this = static_cast<const DVector &>(other);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Free the memory.
+     */
+    ~DVector() {
+        deallocate();
+    }
+
+    /**
+     * @brief The size of the vector.
+     * @return The size.
+     */
+    std::size_t size() const {
+        return m_size;
+    }
+
+    /**
+     * @brief Check if the vector is empty.
+     * @return True if the size is zero.
+     */
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    /**
+     * @brief Check if the values are stored inside the object.
+     * @return True if no memory was taken from the allocator.
+     */
+    bool isInline() const {
+        return m_data == m_inline;
+    }
+
+    /**
+     * @brief Change the size of the vector.
+     * @param size The new size, new values are zero.
+     */
+    void resize(std::size_t size) {
+        if (size == m_size)
+            return;
+        DVector other(size, m_alloc);
+        std::copy(m_data, m_data + std::min(size, m_size), other.m_data);
+        *this = std::move(other);
+    }
+
+    /**
+     * @brief Get the allocator.
+     * @return A copy of the allocator.
+     */
+    Allocator get_allocator() const {
+        return m_alloc;
+    }
+
+    /**
+     * @brief Read access to the underlying data.
+     * @return A pointer to size() values.
+     */
+    const T *data() const {
+        return m_data;
+    }
+
+    /**
+     * @brief Write access to the underlying data.
+     * @return A pointer to size() values.
+     */
+    T *data() {
+        return m_data;
+    }
+
+    /**
+     * @brief Iterator to the first value.
+     * @return The iterator.
+     */
+    const T *begin() const {
+        return m_data;
+    }
+
+    /**
+     * @brief Iterator behind the last value.
+     * @return The iterator.
+     */
+    const T *end() const {
+        return m_data + m_size;
+    }
+
+    /**
+     * @brief Iterator to the first value.
+     * @return The iterator.
+     */
+    T *begin() {
+        return m_data;
+    }
+
+    /**
+     * @brief Iterator behind the last value.
+     * @return The iterator.
+     */
+    T *end() {
+        return m_data + m_size;
+    }
+
+    /**
+     * @brief Convert to a fixed-size vector.
+     * @tparam N The size of the vector, must be size().
+     * @return A copy of this as Vector.
+     */
+    template <unsigned N>
+    Vector<N, T> toVector() const {
+        assert(m_size == N);
+        return Vector<N, T>(m_data);
+    }
+
+    /**
+     * @brief The euclidian norm.
+     * @return The norm \f$ || v ||_2 \f$
+     * @attention Only for floating point types.
+     */
+    T norm() const {
+        static_assert(std::is_floating_point<T>::value, "base type is not floating point.");
+        return std::sqrt(squaredNorm());
+    }
+
+    /**
+     * @brief The squared euclidian norm.
+     * @return The norm \f$ || v ||_2^2 \f$
+     */
+    T squaredNorm() const {
+        return mathlib::simd::dot(m_data, m_data, m_size);
+    }
+
+    /**
+     * @brief Normalize this.
+     * @attention Only for floating point types.
+     */
+    void normalize() {
+        static_assert(std::is_floating_point<T>::value, "base type is not floating point.");
+        T inv_norm = T(1.0) / std::sqrt(squaredNorm() + std::numeric_limits<T>::epsilon());
+        mathlib::simd::scale(m_data, inv_norm, m_size);
+    }
+
+    /**
+     * @brief Return a normalized copy of this.
+     * @return The normalized copy.
+     * @attention Only for floating point types.
+     */
+    DVector normalized() const {
+        DVector ret(*this);
+        ret.normalize();
+        return ret;
+    }
+
+    /**
+     * @brief Read access to idx.
+     * @param idx The index to read (0-indexed).
+     * @return The value at idx.
+     * @attention Does not perform index boundary checks. Use DVector::at instead.
+     */
+    T operator[](std::size_t idx) const {
+        return m_data[idx];
+    }
+
+    /**
+     * @brief Write access to idx.
+     * @param idx The index to write (0-indexed).
+     * @return The value at idx.
+     * @attention Does not perform index boundary checks. Use DVector::at instead.
+     */
+    T &operator[](std::size_t idx) {
+        return m_data[idx];
+    }
+
+    /**
+     * @brief Read access to idx.
+     * @param idx The index to read (0-indexed).
+     * @return The value at idx.
+     * @attention Does not perform index boundary checks. Use DVector::at instead.
+     */
+    T operator()(std::size_t idx) const {
+        return m_data[idx];
+    }
+
+    /**
+     * @brief Write access to idx.
+     * @param idx The index to write (0-indexed).
+     * @return The value at idx.
+     * @attention Does not perform index boundary checks. Use DVector::at instead.
+     */
+    T &operator()(std::size_t idx) {
+        return m_data[idx];
+    }
+
+    /**
+     * @brief Read access to idx.
+     * @param idx The index to read (0-indexed).
+     * @return The value at idx.
+     * @throws std::runtime_error If index is out of range.
+     */
+    T at(std::size_t idx) const {
+        assert_idx(idx);
+        return m_data[idx];
+    }
+
+    /**
+     * @brief Write access to idx.
+     * @param idx The index to write (0-indexed).
+     * @return The value at idx.
+     * @throws std::runtime_error If index is out of range.
+     */
+    T &at(std::size_t idx) {
+        assert_idx(idx);
+        return m_data[idx];
+    }
+
+    /**
+     * @brief Get the sum of this.
+     * @return The sum of all values.
+     */
+    T sum() const {
+        T ret(0.);
+        for (std::size_t i = 0; i < m_size; ++i)
+            ret += m_data[i];
+        return ret;
+    }
+
+    /**
+     * @brief Compute the dot-product with other.
+     * @param other The other vector, same size as this.
+     * @return The dot-product with other.
+     */
+    T dot(const DVector &other) const {
+        assert(other.m_size == m_size);
+        return mathlib::simd::dot(m_data, other.m_data, m_size);
+    }
+
+    /**
+     * @brief Compute the minimum value of this.
+     * @return The minimum value of this.
+     * @attention Only for non-empty vectors.
+     */
+    T min() const {
+        assert(m_size > 0);
+        return *std::min_element(m_data, m_data + m_size);
+    }
+
+    /**
+     * @brief Compute the maximum value of this.
+     * @return The maximum value of this.
+     * @attention Only for non-empty vectors.
+     */
+    T max() const {
+        assert(m_size > 0);
+        return *std::max_element(m_data, m_data + m_size);
+    }
+
+    /**
+     * @brief Get a reference to the minimum value of this.
+     * @return The reference to the minimum value of this.
+     * @attention Only for non-empty vectors.
+     */
+    T &minCoeff() {
+        assert(m_size > 0);
+        return *std::min_element(m_data, m_data + m_size);
+    }
+
+    /**
+     * @brief Get a reference to the maximum value of this.
+     * @return The reference to the maximum value of this.
+     * @attention Only for non-empty vectors.
+     */
+    T &maxCoeff() {
+        assert(m_size > 0);
+        return *std::max_element(m_data, m_data + m_size);
+    }
+
+    /**
+     * @brief Add another vector to this.
+     * @param other The other vector, same size as this.
+     * @return A reference to this vector, with this + other.
+     */
+    DVector &operator+=(const DVector &other) {
+        assert(other.m_size == m_size);
+        mathlib::simd::apply<mathlib::simd::AddOp>(m_data, other.m_data, m_size);
+        return *this;
+    }
+
+    /**
+     * @brief Subtract another vector from this.
+     * @param other The other vector, same size as this.
+     * @return A reference to this vector, with this - other.
+     */
+    DVector &operator-=(const DVector &other) {
+        assert(other.m_size == m_size);
+        mathlib::simd::apply<mathlib::simd::SubOp>(m_data, other.m_data, m_size);
+        return *this;
+    }
+
+    /**
+     * @brief Multiply another vector to this (element-wise).
+     * @param other The other vector, same size as this.
+     * @return A reference to this vector, with this * other.
+     */
+    DVector &operator*=(const DVector &other) {
+        assert(other.m_size == m_size);
+        mathlib::simd::apply<mathlib::simd::MulOp>(m_data, other.m_data, m_size);
+        return *this;
+    }
+
+    /**
+     * @brief Divide this by another vector (element-wise).
+     * @param other The other vector, same size as this.
+     * @return A reference to this vector, with this / other.
+     * @attention Only for floating point types.
+     */
+    DVector &operator/=(const DVector &other) {
+        static_assert(std::is_floating_point<T>::value, "base type is not floating point.");
+        assert(other.m_size == m_size);
+        mathlib::simd::apply<mathlib::simd::DivOp>(m_data, other.m_data, m_size);
+        return *this;
+    }
+
+    /**
+     * @brief Add a scalar to this.
+     * @param value The scalar.
+     * @return A reference to this vector, with this + value.
+     */
+    DVector &operator+=(const T &value) {
+        for (std::size_t i = 0; i < m_size; ++i)
+            m_data[i] += value;
+        return *this;
+    }
+
+    /**
+     * @brief Subtract a scalar from this.
+     * @param value The scalar.
+     * @return A reference to this vector, with this - value.
+     */
+    DVector &operator-=(const T &value) {
+        for (std::size_t i = 0; i < m_size; ++i)
+            m_data[i] -= value;
+        return *this;
+    }
+
+    /**
+     * @brief Multiply this by a scalar.
+     * @param value The scalar.
+     * @return A reference to this vector, with this * value.
+     */
+    DVector &operator*=(const T &value) {
+        mathlib::simd::scale(m_data, value, m_size);
+        return *this;
+    }
+
+    /**
+     * @brief Divide this by a scalar.
+     * @param value The scalar.
+     * @return A reference to this vector, with this / value.
+     * @attention Only for floating point types.
+     */
+    DVector &operator/=(const T &value) {
+        static_assert(std::is_floating_point<T>::value, "base type is not floating point.");
+        for (std::size_t i = 0; i < m_size; ++i)
+            m_data[i] /= value;
+        return *this;
+    }
+
+    /**
+     * @brief Multiply this vector by a scalar
+     * @param value The scalar
+     * @return A new vector with this * value.
+     */
+    DVector operator*(const T &value) const {
+        DVector ret(*this);
+        ret *= value;
+        return ret;
+    }
+
+    /**
+     * @brief Add a scalar to this vector
+     * @param value The scalar
+     * @return A new vector with this + value.
+     */
+    DVector operator+(const T &value) const {
+        DVector ret(*this);
+        ret += value;
+        return ret;
+    }
+
+    /**
+     * @brief Subtract a scalar from this vector
+     * @param value The scalar
+     * @return A new vector with this - value.
+     */
+    DVector operator-(const T &value) const {
+        DVector ret(*this);
+        ret -= value;
+        return ret;
+    }
+
+    /**
+     * @brief Divide this vector by a scalar
+     * @param value The scalar
+     * @return A new vector with this / value.
+     * @attention Only for floating point types.
+     */
+    DVector operator/(const T &value) const {
+        DVector ret(*this);
+        ret /= value;
+        return ret;
+    }
+
+    /**
+     * @brief Check for equality.
+     * @param lhs The first vector.
+     * @param rhs The second vector.
+     * @return True if the vectors have the same size and are equal (floating-point comparison).
+     */
+    friend bool operator==(const DVector &lhs, const DVector &rhs) {
+        if (lhs.m_size != rhs.m_size)
+            return false;
+        for (std::size_t i = 0; i < lhs.m_size; ++i)
+            if (fabs(lhs[i] - rhs[i]) > std::numeric_limits<double>::epsilon())
+                return false;
+        return true;
+    }
+
+    /**
+     * @brief Check for inequality.
+     * @param lhs The first vector.
+     * @param rhs The second vector.
+     * @return True if the vectors are not equal (floating-point comparison).
+     */
+    friend bool operator!=(const DVector &lhs, const DVector &rhs) {
+        return !(lhs == rhs);
+    }
+
+    /**
+     * @brief Write a vector to a stream.
+     * @param os The stream.
+     * @param v The vector.
+     * @return The stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const DVector &v) {
+        for (std::size_t i = 0; i < v.m_size; ++i) {
+            os << v[i];
+            if (i + 1 < v.m_size)
+                os << " ";
+        }
+        return os;
+    }
+
+private:
+    /**
+     * @brief Get storage for size values, inline if possible.
+     * @param size The number of values.
+     */
+    void allocate(std::size_t size) {
+        m_data = size <= InlineCapacity ? m_inline : std::allocator_traits<Allocator>::allocate(m_alloc, size);
+        m_size = size;
+    }
+
+    /**
+     * @brief Give the storage back to the allocator, this is empty afterwards.
+     */
+    void deallocate() {
+        if (m_data != m_inline)
+            std::allocator_traits<Allocator>::deallocate(m_alloc, m_data, m_size);
+        m_data = m_inline;
+        m_size = 0;
+    }
+
+    /**
+     * @brief Take the values of another vector, which is empty afterwards.
+     * @param other The other vector.
+     */
+    void steal(DVector &other) noexcept {
+        if (other.m_data == other.m_inline) {
+            std::copy(other.m_inline, other.m_inline + other.m_size, m_inline);
+            m_data = m_inline;
+        } else {
+            m_data = other.m_data;
+        }
+        m_size = other.m_size;
+        other.m_data = other.m_inline;
+        other.m_size = 0;
+    }
+
+    /**
+     * @brief Assert a given index is in range.
+     * @param idx The index.
+     * @throws std::runtime_error If index is out of range.
+     */
+    void assert_idx(std::size_t idx) const {
+        if (idx >= m_size)
+            throw std::runtime_error("idx >= size");
+    }
+
+private:
+    Allocator m_alloc;                                               ///< The allocator.
+    std::size_t m_size = 0;                                          ///< The size.
+    T m_inline[InlineCapacity > 0 ? InlineCapacity : 1];             ///< The inline storage.
+    T *m_data = m_inline;                                            ///< The values, either m_inline or allocated.
+};
+
+/**
+ * @brief Add two vectors.
+ * @param a The first vector.
+ * @param b The second vector, same size as a.
+ * @return a + b
+ */
+template <typename T, typename Allocator, unsigned InlineCapacity>
+DVector<T, Allocator, InlineCapacity> operator+(DVector<T, Allocator, InlineCapacity> a, const DVector<T, Allocator, InlineCapacity> &b) {
+    a += b;
+    return a;
+}
+
+/**
+ * @brief Subtract two vectors.
+ * @param a The first vector.
+ * @param b The second vector, same size as a.
+ * @return a - b
+ */
+template <typename T, typename Allocator, unsigned InlineCapacity>
+DVector<T, Allocator, InlineCapacity> operator-(DVector<T, Allocator, InlineCapacity> a, const DVector<T, Allocator, InlineCapacity> &b) {
+    a -= b;
+    return a;
+}
+
+/**
+ * @brief Multiply two vectors.
+ * @param a The first vector.
+ * @param b The second vector, same size as a.
+ * @return a * b
+ */
+template <typename T, typename Allocator, unsigned InlineCapacity>
+DVector<T, Allocator, InlineCapacity> operator*(DVector<T, Allocator, InlineCapacity> a, const DVector<T, Allocator, InlineCapacity> &b) {
+    a *= b;
+    return a;
+}
+
+/**
+ * @brief Divide two vectors.
+ * @param a The first vector.
+ * @param b The second vector, same size as a.
+ * @return a / b
+ * @attention Only supported for floating point vector types!
+ */
+template <typename T, typename Allocator, unsigned InlineCapacity>
+DVector<T, Allocator, InlineCapacity> operator/(DVector<T, Allocator, InlineCapacity> a, const DVector<T, Allocator, InlineCapacity> &b) {
+    a /= b;
+    return a;
+}
+
+/**
+ * @brief Add a scalar to the vector
+ * @param value The scalar
+ * @param v The vector
+ * @return A new vector with v + value, elementwise
+ */
+template <typename T, typename Allocator, unsigned InlineCapacity>
+DVector<T, Allocator, InlineCapacity> operator+(const typename mathlib::detail::NonDeduced<T>::type &value, DVector<T, Allocator, InlineCapacity> v) {
+    v += value;
+    return v;
+}
+
+/**
+ * @brief Multiply a scalar with the vector
+ * @param value The scalar
+ * @param v The vector
+ * @return A new vector with v * value, elementwise
+ */
+template <typename T, typename Allocator, unsigned InlineCapacity>
+DVector<T, Allocator, InlineCapacity> operator*(const typename mathlib::detail::NonDeduced<T>::type &value, DVector<T, Allocator, InlineCapacity> v) {
+    v *= value;
+    return v;
+}
+
+/**
+ * @brief Negate a vector.
+ * @param v The vector.
+ * @return A new vector which is negative elementwise.
+ */
+template <typename T, typename Allocator, unsigned InlineCapacity>
+DVector<T, Allocator, InlineCapacity> operator-(DVector<T, Allocator, InlineCapacity> v) {
+    for (T &value : v)
+        value = T(-value);
+    return v;
+}
+
+/**
+ * @name Defines
+ * @brief Underlying data type definitions.
+ */
+/** @{ */
+using DVectorf = DVector<float>;
+using DVectord = DVector<double>;
+template <typename T>
+using ArenaDVector = DVector<T, ArenaAllocator<T>>;  ///< Vector taking its memory from a MonotonicArena.
+/** @} */
+
+#endif /* __MATHLIB_DVECTOR_H__ */
@@ -0,0 +1,293 @@
+#ifndef __MATHLIB_EXPRESSION_H__
+#define __MATHLIB_EXPRESSION_H__
+
+#include <mathlib/unroll.h>
+
+#include <type_traits>
+
+template <unsigned N, typename T>
+class Vector;
+
+/**
+ * @brief Base class of all lazily evaluated vector expressions.
+ *
+ * Arithmetic on vectors does not compute a result right away, but builds a small expression tree instead.
+ * The tree is evaluated element by element in a single loop as soon as it is assigned to a Vector.
+ * @tparam E The derived expression type (CRTP).
+ * @tparam N The size of the expression.
+ * @tparam T The underlying data type of the expression.
+ * @attention Expressions keep references to the vectors they are built from.
+ * Do not store them (e.g. with auto) beyond the lifetime of their operands, use eval() instead.
+ */
+template <typename E, unsigned N, typename T>
+class VectorExpression {
+public:
+    using type = T;  ///< The underlying data type.
+
+    /**
+     * @brief The underlying size of the expression.
+     * @return The size.
+     */
+    constexpr static unsigned size() {
+        return N;
+    }
+
+    /**
+     * @brief Access the derived expression.
+     * @return A reference to the derived expression.
+     */
+    constexpr const E &derived() const {
+        return static_cast<const E &>(*this);
+    }
+
+    /**
+     * @brief Evaluate this expression into a new vector.
+     * @return The evaluated vector.
+     */
+    constexpr Vector<N, T> eval() const {
+        return Vector<N, T>(*this);
+    }
+
+    /**
+     * @brief Multiply this expression by a scalar
+     * @param value The scalar
+     * @return An expression for this * value.
+     */
+    constexpr auto operator*(const T &value) const;
+
+    /**
+     * @brief Add a scalar to this expression
+     * @param value The scalar
+     * @return An expression for this + value.
+     */
+    constexpr auto operator+(const T &value) const;
+
+    /**
+     * @brief Subtract a scalar from this expression
+     * @param value The scalar
+     * @return An expression for this - value.
+     */
+    constexpr auto operator-(const T &value) const;
+
+    /**
+     * @brief Divide this expression by a scalar
+     * @param value The scalar
+     * @return An expression for this / value.
+     * @attention Only for floating point types.
+     */
+    constexpr auto operator/(const T &value) const;
+};
+
+namespace mathlib::detail {
+
+/**
+ * @brief Element-wise addition.
+ */
+struct Add {
+    template <typename T>
+    MATHLIB_ALWAYS_INLINE constexpr static T apply(const T &a, const T &b) {
+        return a + b;
+    }
+};
+
+/**
+ * @brief Element-wise subtraction.
+ */
+struct Subtract {
+    template <typename T>
+    MATHLIB_ALWAYS_INLINE constexpr static T apply(const T &a, const T &b) {
+        return a - b;
+    }
+};
+
+/**
+ * @brief Element-wise multiplication.
+ */
+struct Multiply {
+    template <typename T>
+    MATHLIB_ALWAYS_INLINE constexpr static T apply(const T &a, const T &b) {
+        return a * b;
+    }
+};
+
+/**
+ * @brief Element-wise division.
+ */
+struct Divide {
+    template <typename T>
+    MATHLIB_ALWAYS_INLINE constexpr static T apply(const T &a, const T &b) {
+        return a / b;
+    }
+};
+
+/**
+ * @brief Element-wise negation.
+ */
+struct Negate {
+    template <typename T>
+    MATHLIB_ALWAYS_INLINE constexpr static T apply(const T &a) {
+        return T(-a);
+    }
+};
+
+/**
+ * @brief How an operand is held inside an expression node.
+ *
+ * Vectors are referenced, intermediate expression nodes are small and held by value,
+ * so that temporaries created while building an expression do not dangle.
+ * @tparam E The operand type.
+ */
+template <typename E>
+struct ExpressionOperand {
+    using type = const E &;  ///< Leaves are stored by reference.
+};
+
+/**
+ * @brief Prevent template argument deduction for scalar operands.
+ * @tparam T The scalar type.
+ */
+template <typename T>
+struct NonDeduced {
+    using type = T;  ///< The scalar type.
+};
+
+}  // namespace mathlib::detail
+
+/**
+ * @brief Lazily evaluated element-wise operation of two expressions.
+ * @tparam L The left expression.
+ * @tparam R The right expression.
+ * @tparam Op The element-wise operation.
+ */
+template <typename L, typename R, typename Op>
+class VectorBinaryExpression : public VectorExpression<VectorBinaryExpression<L, R, Op>, L::size(), typename L::type> {
+public:
+    /**
+     * @brief Create the expression from its operands.
+     * @param lhs The left operand.
+     * @param rhs The right operand.
+     */
+    constexpr VectorBinaryExpression(const L &lhs, const R &rhs) : m_lhs(lhs), m_rhs(rhs) {}
+
+    /**
+     * @brief Evaluate the expression at idx.
+     * @param idx The index to evaluate (0-indexed).
+     * @return The value at idx.
+     */
+    MATHLIB_ALWAYS_INLINE constexpr typename L::type operator[](unsigned idx) const {
+        return Op::apply(m_lhs[idx], m_rhs[idx]);
+    }
+
+private:
+    typename mathlib::detail::ExpressionOperand<L>::type m_lhs;  ///< The left operand.
+    typename mathlib::detail::ExpressionOperand<R>::type m_rhs;  ///< The right operand.
+};
+
+/**
+ * @brief Lazily evaluated element-wise operation of an expression and a scalar.
+ * @tparam E The expression.
+ * @tparam Op The element-wise operation, applied as Op(expression, scalar).
+ */
+template <typename E, typename Op>
+class VectorScalarExpression : public VectorExpression<VectorScalarExpression<E, Op>, E::size(), typename E::type> {
+public:
+    using T = typename E::type;  ///< The underlying data type.
+
+    /**
+     * @brief Create the expression from its operands.
+     * @param expression The vector operand.
+     * @param value The scalar operand.
+     */
+    constexpr VectorScalarExpression(const E &expression, const T &value) : m_expression(expression), m_value(value) {}
+
+    /**
+     * @brief Evaluate the expression at idx.
+     * @param idx The index to evaluate (0-indexed).
+     * @return The value at idx.
+     */
+    MATHLIB_ALWAYS_INLINE constexpr T operator[](unsigned idx) const {
+        return Op::apply(m_expression[idx], m_value);
+    }
+
+private:
+    typename mathlib::detail::ExpressionOperand<E>::type m_expression;  ///< The vector operand.
+    T m_value;                                                          ///< The scalar operand.
+};
+
+/**
+ * @brief Lazily evaluated element-wise operation of a single expression.
+ * @tparam E The expression.
+ * @tparam Op The element-wise operation.
+ */
+template <typename E, typename Op>
+class VectorUnaryExpression : public VectorExpression<VectorUnaryExpression<E, Op>, E::size(), typename E::type> {
+public:
+    /**
+     * @brief Create the expression from its operand.
+     * @param expression The operand.
+     */
+    constexpr explicit VectorUnaryExpression(const E &expression) : m_expression(expression) {}
+
+    /**
+     * @brief Evaluate the expression at idx.
+     * @param idx The index to evaluate (0-indexed).
+     * @return The value at idx.
+     */
+    MATHLIB_ALWAYS_INLINE constexpr typename E::type operator[](unsigned idx) const {
+        return Op::apply(m_expression[idx]);
+    }
+
+private:
+    typename mathlib::detail::ExpressionOperand<E>::type m_expression;  ///< The operand.
+};
+
+namespace mathlib::detail {
+
+/**
+ * @brief Binary expression nodes are stored by value.
+ */
+template <typename L, typename R, typename Op>
+struct ExpressionOperand<VectorBinaryExpression<L, R, Op>> {
+    using type = const VectorBinaryExpression<L, R, Op>;  ///< Nodes are stored by value.
+};
+
+/**
+ * @brief Scalar expression nodes are stored by value.
+ */
+template <typename E, typename Op>
+struct ExpressionOperand<VectorScalarExpression<E, Op>> {
+    using type = const VectorScalarExpression<E, Op>;  ///< Nodes are stored by value.
+};
+
+/**
+ * @brief Unary expression nodes are stored by value.
+ */
+template <typename E, typename Op>
+struct ExpressionOperand<VectorUnaryExpression<E, Op>> {
+    using type = const VectorUnaryExpression<E, Op>;  ///< Nodes are stored by value.
+};
+
+}  // namespace mathlib::detail
+
+template <typename E, unsigned N, typename T>
+constexpr auto VectorExpression<E, N, T>::operator*(const T &value) const {
+    return VectorScalarExpression<E, mathlib::detail::Multiply>(derived(), value);
+}
+
+template <typename E, unsigned N, typename T>
+constexpr auto VectorExpression<E, N, T>::operator+(const T &value) const {
+    return VectorScalarExpression<E, mathlib::detail::Add>(derived(), value);
+}
+
+template <typename E, unsigned N, typename T>
+constexpr auto VectorExpression<E, N, T>::operator-(const T &value) const {
+    return VectorScalarExpression<E, mathlib::detail::Subtract>(derived(), value);
+}
+
+template <typename E, unsigned N, typename T>
+constexpr auto VectorExpression<E, N, T>::operator/(const T &value) const {
+    static_assert(std::is_floating_point<T>::value, "base type is not floating point.");
+    return VectorScalarExpression<E, mathlib::detail::Divide>(derived(), value);
+}
+
+#endif /* __MATHLIB_EXPRESSION_H__ */
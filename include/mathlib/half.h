@@ -0,0 +1,395 @@
+#ifndef __MATHLIB_HALF_H__
+#define __MATHLIB_HALF_H__
+
+#include <mathlib/simd.h>
+#include <mathlib/vector.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace mathlib {
+
+namespace detail {
+
+/**
+ * @brief Reinterpret the bits of a float.
+ * @param f The float.
+ * @return The bits of f.
+ */
+inline std::uint32_t floatBits(float f) {
+    std::uint32_t ret;
+    std::memcpy(&ret, &f, sizeof(ret));
+    return ret;
+}
+
+/**
+ * @brief Reinterpret bits as a float.
+ * @param u The bits.
+ * @return The float with the bits u.
+ */
+inline float bitsFloat(std::uint32_t u) {
+    float ret;
+    std::memcpy(&ret, &u, sizeof(ret));
+    return ret;
+}
+
+/**
+ * @brief Convert a float to IEEE 754 binary16, rounding to nearest even.
+ *
+ * Overflow gives infinity, NaN stays a (quiet) NaN, small values become subnormal.
+ * @param f The float.
+ * @return The bits of the half.
+ */
+inline std::uint16_t floatToHalf(float f) {
+    // All three cases are computed and selected without branches, so the bulk loops vectorize.
+    std::uint32_t u = floatBits(f);
+    const std::uint32_t sign = (u >> 16) & 0x8000u;
+    u &= 0x7fffffffu;
+    // Too large for a half, infinity or NaN.
+    const std::uint32_t inf_nan = 0x7c00u | ((0u - std::uint32_t(u > 0x7f800000u)) & 0x0200u);
+    // Subnormal or zero, let the float addition round the mantissa.
+    const std::uint32_t subnormal = floatBits(bitsFloat(u) + bitsFloat(0x3f000000u)) - 0x3f000000u;
+    // Normal, rebias the exponent and round the mantissa.
+    const std::uint32_t normal = (u + 0xc8000fffu + ((u >> 13) & 1u)) >> 13;
+    const std::uint32_t large = 0u - std::uint32_t(u >= 0x47800000u);
+    const std::uint32_t subnormal_mask = 0u - std::uint32_t(u < 0x38800000u);
+    const std::uint32_t ret = (inf_nan & large) | (subnormal & subnormal_mask) | (normal & ~(large | subnormal_mask));
+    return std::uint16_t(ret | sign);
+}
+
+/**
+ * @brief Convert IEEE 754 binary16 to a float, which is exact.
+ * @param h The bits of the half.
+ * @return The float.
+ */
+inline float halfToFloat(std::uint16_t h) {
+    // Shift exponent and mantissa in place, then fix the exponent bias with one multiplication.
+    // This also normalizes subnormals.
+    const std::uint32_t u = floatBits(bitsFloat(std::uint32_t(h & 0x7fffu) << 13) * bitsFloat(0x77800000u));
+    // Infinity and NaN keep the maximal exponent.
+    const std::uint32_t inf_nan = (0u - std::uint32_t(u >= 0x47800000u)) & 0x7f800000u;
+    return bitsFloat(u | inf_nan | (std::uint32_t(h & 0x8000u) << 16));
+}
+
+/**
+ * @brief Convert a float to bfloat16, rounding to nearest even.
+ * @param f The float.
+ * @return The bits of the bfloat16.
+ */
+inline std::uint16_t floatToBfloat16(float f) {
+    const std::uint32_t u = floatBits(f);
+    const std::uint32_t nan = 0u - std::uint32_t((u & 0x7fffffffu) > 0x7f800000u);
+    const std::uint32_t rounded = (u + 0x7fffu + ((u >> 16) & 1u)) >> 16;
+    // NaN is truncated and made quiet instead, rounding could carry it into infinity.
+    return std::uint16_t((((u >> 16) | 0x40u) & nan) | (rounded & ~nan));
+}
+
+/**
+ * @brief Convert bfloat16 to a float, which is exact.
+ * @param b The bits of the bfloat16.
+ * @return The float.
+ */
+inline float bfloat16ToFloat(std::uint16_t b) {
+    return bitsFloat(std::uint32_t(b) << 16);
+}
+
+}  // namespace detail
+
+/**
+ * @brief 16 bit IEEE 754 floating point number (binary16), for storage only.
+ *
+ * Converts implicitly to float for all arithmetic, so e.g. Vector<3, half> halves the memory of a Vector3f.
+ * The precision is about 3 decimal digits, the largest value is 65504.
+ * Use mathlib::convert to convert whole arrays.
+ */
+class half {
+public:
+    /**
+     * @brief Construct a zero.
+     */
+    constexpr half() : m_bits(0) {}
+
+    /**
+     * @brief Construct from a float, rounding to nearest even.
+     * @param f The value.
+     */
+    half(float f) : m_bits(detail::floatToHalf(f)) {}
+
+    /**
+     * @brief Construct from another arithmetic type, converted to float first.
+     * @tparam S The arithmetic type.
+     * @param value The value.
+     */
+    template <typename S, typename std::enable_if<std::is_arithmetic<S>::value && !std::is_same<S, float>::value>::type * = nullptr>
+    explicit half(S value) : half(float(value)) {}
+
+    /**
+     * @brief Create a half from its bits.
+     * @param bits The IEEE 754 binary16 bits.
+     * @return The half.
+     */
+    static constexpr half fromBits(std::uint16_t bits) {
+        half ret;
+        ret.m_bits = bits;
+        return ret;
+    }
+
+    /**
+     * @brief The bits of this.
+     * @return The IEEE 754 binary16 bits.
+     */
+    constexpr std::uint16_t bits() const {
+        return m_bits;
+    }
+
+    /**
+     * @brief Convert to float, which is exact.
+     * @return The value.
+     */
+    operator float() const {
+        return detail::halfToFloat(m_bits);
+    }
+
+    /**
+     * @brief Add a value, computed in float.
+     * @param value The value.
+     * @return A reference to this.
+     */
+    half &operator+=(float value) {
+        return *this = half(float(*this) + value);
+    }
+
+    /**
+     * @brief Subtract a value, computed in float.
+     * @param value The value.
+     * @return A reference to this.
+     */
+    half &operator-=(float value) {
+        return *this = half(float(*this) - value);
+    }
+
+    /**
+     * @brief Multiply with a value, computed in float.
+     * @param value The value.
+     * @return A reference to this.
+     */
+    half &operator*=(float value) {
+        return *this = half(float(*this) * value);
+    }
+
+    /**
+     * @brief Divide by a value, computed in float.
+     * @param value The value.
+     * @return A reference to this.
+     */
+    half &operator/=(float value) {
+        return *this = half(float(*this) / value);
+    }
+
+private:
+    std::uint16_t m_bits;  ///< The IEEE 754 binary16 bits.
+};
+
+/**
+ * @brief 16 bit brain floating point number (the upper half of a float), for storage only.
+ *
+ * Has the range of a float but only about 2 decimal digits. Converts implicitly to float for all arithmetic.
+ */
+class bfloat16 {
+public:
+    /**
+     * @brief Construct a zero.
+     */
+    constexpr bfloat16() : m_bits(0) {}
+
+    /**
+     * @brief Construct from a float, rounding to nearest even.
+     * @param f The value.
+     */
+    bfloat16(float f) : m_bits(detail::floatToBfloat16(f)) {}
+
+    /**
+     * @brief Construct from another arithmetic type, converted to float first.
+     * @tparam S The arithmetic type.
+     * @param value The value.
+     */
+    template <typename S, typename std::enable_if<std::is_arithmetic<S>::value && !std::is_same<S, float>::value>::type * = nullptr>
+    explicit bfloat16(S value) : bfloat16(float(value)) {}
+
+    /**
+     * @brief Create a bfloat16 from its bits.
+     * @param bits The bits.
+     * @return The bfloat16.
+     */
+    static constexpr bfloat16 fromBits(std::uint16_t bits) {
+        bfloat16 ret;
+        ret.m_bits = bits;
+        return ret;
+    }
+
+    /**
+     * @brief The bits of this.
+     * @return The upper 16 bits of the float.
+     */
+    constexpr std::uint16_t bits() const {
+        return m_bits;
+    }
+
+    /**
+     * @brief Convert to float, which is exact.
+     * @return The value.
+     */
+    operator float() const {
+        return detail::bfloat16ToFloat(m_bits);
+    }
+
+    /**
+     * @brief Add a value, computed in float.
+     * @param value The value.
+     * @return A reference to this.
+     */
+    bfloat16 &operator+=(float value) {
+        return *this = bfloat16(float(*this) + value);
+    }
+
+    /**
+     * @brief Subtract a value, computed in float.
+     * @param value The value.
+     * @return A reference to this.
+     */
+    bfloat16 &operator-=(float value) {
+        return *this = bfloat16(float(*this) - value);
+    }
+
+    /**
+     * @brief Multiply with a value, computed in float.
+     * @param value The value.
+     * @return A reference to this.
+     */
+    bfloat16 &operator*=(float value) {
+        return *this = bfloat16(float(*this) * value);
+    }
+
+    /**
+     * @brief Divide by a value, computed in float.
+     * @param value The value.
+     * @return A reference to this.
+     */
+    bfloat16 &operator/=(float value) {
+        return *this = bfloat16(float(*this) / value);
+    }
+
+private:
+    std::uint16_t m_bits;  ///< The upper 16 bits of a float.
+};
+
+static_assert(sizeof(half) == 2 && sizeof(bfloat16) == 2, "16 bit types must not be padded.");
+
+/**
+ * @brief Convert halves to floats.
+ *
+ * Uses the F16C instructions where available (e.g. with -mf16c or -march=native).
+ * @param in The halves.
+ * @param out The floats.
+ * @param count The number of values.
+ */
+inline void convert(const half *in, float *out, std::size_t count) {
+    std::size_t i = 0;
+#if defined(MATHLIB_SIMD_F16C)
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i))));
+#endif
+    for (; i < count; ++i)
+        out[i] = detail::halfToFloat(in[i].bits());
+}
+
+/**
+ * @brief Convert floats to halves, rounding to nearest even.
+ *
+ * Uses the F16C instructions where available (e.g. with -mf16c or -march=native).
+ * @param in The floats.
+ * @param out The halves.
+ * @param count The number of values.
+ */
+inline void convert(const float *in, half *out, std::size_t count) {
+    std::size_t i = 0;
+#if defined(MATHLIB_SIMD_F16C)
+    for (; i + 8 <= count; i += 8)
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+#endif
+    for (; i < count; ++i)
+        out[i] = half::fromBits(detail::floatToHalf(in[i]));
+}
+
+/**
+ * @brief Convert bfloat16 values to floats.
+ *
+ * This is a shift, which the compiler vectorizes.
+ * @param in The bfloat16 values.
+ * @param out The floats.
+ * @param count The number of values.
+ */
+inline void convert(const bfloat16 *in, float *out, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = detail::bfloat16ToFloat(in[i].bits());
+}
+
+/**
+ * @brief Convert floats to bfloat16 values, rounding to nearest even.
+ * @param in The floats.
+ * @param out The bfloat16 values.
+ * @param count The number of values.
+ */
+inline void convert(const float *in, bfloat16 *out, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = bfloat16::fromBits(detail::floatToBfloat16(in[i]));
+}
+
+/**
+ * @brief Convert an array of vectors between float and a 16 bit storage type.
+ * @tparam N The size of the vectors.
+ * @tparam S The source type, float, half or bfloat16.
+ * @tparam D The destination type, float, half or bfloat16.
+ * @param in The vectors.
+ * @param out The converted vectors.
+ * @param count The number of vectors.
+ */
+template <unsigned N, typename S, typename D>
+void convert(const Vector<N, S> *in, Vector<N, D> *out, std::size_t count) {
+    static_assert(sizeof(Vector<N, S>) == N * sizeof(S) && sizeof(Vector<N, D>) == N * sizeof(D), "vectors must be unpadded.");
+    convert(reinterpret_cast<const S *>(in), reinterpret_cast<D *>(out), count * N);
+}
+
+/**
+ * @brief Convert a std::vector of vectors between float and a 16 bit storage type.
+ * @tparam D The destination type, float, half or bfloat16.
+ * @tparam N The size of the vectors.
+ * @tparam S The source type, float, half or bfloat16.
+ * @param in The vectors.
+ * @return The converted vectors.
+ */
+template <typename D, unsigned N, typename S>
+std::vector<Vector<N, D>> convert(const std::vector<Vector<N, S>> &in) {
+    std::vector<Vector<N, D>> ret(in.size());
+    convert(in.data(), ret.data(), in.size());
+    return ret;
+}
+
+}  // namespace mathlib
+
+/**
+ * @name Defines
+ * @brief 16 bit storage type definitions.
+ */
+/** @{ */
+using Vector2h = Vector<2, mathlib::half>;
+using Vector3h = Vector<3, mathlib::half>;
+using Vector4h = Vector<4, mathlib::half>;
+using Vector3bf = Vector<3, mathlib::bfloat16>;
+using Vector4bf = Vector<4, mathlib::bfloat16>;
+/** @} */
+
+#endif /* __MATHLIB_HALF_H__ */
@@ -0,0 +1,247 @@
+#ifndef __MATHLIB_HASH_GRID_H__
+#define __MATHLIB_HASH_GRID_H__
+
+#include <mathlib/vector.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Uniform grid over a set of points, storing only the occupied cells in an open-addressing hash table.
+ *
+ * The points are sorted into their cells with a counting sort, so every cell refers to a contiguous range of
+ * point indices. Rebuilding reuses the memory of the previous build.
+ * @tparam N The size of the vectors.
+ * @tparam T The underlying data type of the vectors.
+ * @attention Only for floating point types.
+ */
+template <unsigned N, typename T>
+class SpatialHashGrid {
+public:
+    static_assert(std::is_floating_point<T>::value, "base type is not floating point.");
+
+    using type = T;                 ///< The underlying data type.
+    using Vector_t = Vector<N, T>;  ///< The point type.
+    using Cell_t = Vector<N, int>;  ///< The integer coordinates of a cell.
+    using Range_t = std::pair<const std::uint32_t *, const std::uint32_t *>;  ///< Point indices of a cell.
+
+    /**
+     * @brief Create an empty grid.
+     * @param cell_size The edge length of the cells, usually the interaction radius.
+     */
+    explicit SpatialHashGrid(T cell_size) : m_cell_size(cell_size), m_inv_cell_size(T(1.) / cell_size) {
+        assert(cell_size > T(0.));
+    }
+
+    /**
+     * @brief Create a grid.
+     * @param cell_size The edge length of the cells, usually the interaction radius.
+     * @param points The points.
+     * @param count The number of points.
+     */
+    SpatialHashGrid(T cell_size, const Vector_t *points, std::size_t count) : SpatialHashGrid(cell_size) {
+        build(points, count);
+    }
+
+    /**
+     * @brief Create a grid.
+     * @param cell_size The edge length of the cells, usually the interaction radius.
+     * @param points The points.
+     */
+    SpatialHashGrid(T cell_size, const std::vector<Vector_t> &points) : SpatialHashGrid(cell_size, points.data(), points.size()) {}
+
+    /**
+     * @brief Sort points into the grid, replacing the previous points.
+     * @param points The points. Only their indices are stored.
+     * @param count The number of points.
+     */
+    void build(const Vector_t *points, std::size_t count) {
+        assert(count < std::numeric_limits<std::uint32_t>::max());
+        std::size_t capacity = 16;
+        while (capacity < count + count / 2)
+            capacity *= 2;
+        m_table.assign(capacity, Entry{Cell_t(), 0, 0});
+        m_cells = 0;
+
+        // Count the points per cell.
+        m_slots.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::size_t slot = insert(cell(points[i]));
+            ++m_table[slot].count;
+            m_slots[i] = std::uint32_t(slot);
+        }
+
+        // Assign every cell its range, then fill the ranges in point order.
+        std::uint32_t begin = 0;
+        for (Entry &entry : m_table) {
+            entry.begin = begin;
+            begin += entry.count;
+            entry.count = 0;
+        }
+        m_indices.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            Entry &entry = m_table[m_slots[i]];
+            m_indices[entry.begin + entry.count++] = std::uint32_t(i);
+        }
+    }
+
+    /**
+     * @brief Sort points into the grid, replacing the previous points.
+     * @param points The points. Only their indices are stored.
+     */
+    void build(const std::vector<Vector_t> &points) {
+        build(points.data(), points.size());
+    }
+
+    /**
+     * @brief The edge length of the cells.
+     * @return The cell size.
+     */
+    T cellSize() const {
+        return m_cell_size;
+    }
+
+    /**
+     * @brief The number of points.
+     * @return The number of points.
+     */
+    std::size_t size() const {
+        return m_indices.size();
+    }
+
+    /**
+     * @brief The number of occupied cells.
+     * @return The number of cells with at least one point.
+     */
+    std::size_t cells() const {
+        return m_cells;
+    }
+
+    /**
+     * @brief Compute the cell of a position.
+     * @param position The position.
+     * @return The integer coordinates of the cell.
+     */
+    Cell_t cell(const Vector_t &position) const {
+        Cell_t ret;
+        for (unsigned c = 0; c < N; ++c)
+            ret[c] = int(std::floor(position[c] * m_inv_cell_size));
+        return ret;
+    }
+
+    /**
+     * @brief Get the points of a cell.
+     * @param cell The cell.
+     * @return The range of point indices in the cell, in increasing order. Empty if the cell has no points.
+     */
+    Range_t points(const Cell_t &cell) const {
+        const std::size_t mask = m_table.size() - 1;
+        for (std::size_t slot = std::size_t(mathlib::hashValue(cell)) & mask; !m_table.empty(); slot = (slot + 1) & mask) {
+            const Entry &entry = m_table[slot];
+            if (entry.count == 0)
+                break;
+            if (equal(entry.key, cell)) {
+                const std::uint32_t *first = m_indices.data() + entry.begin;
+                return Range_t(first, first + entry.count);
+            }
+        }
+        return Range_t(nullptr, nullptr);
+    }
+
+    /**
+     * @brief Visit all points in the cell of a position and its neighbor cells.
+     *
+     * With a cell size of at least r, this visits all points within distance r of position.
+     * @tparam F The visitor type.
+     * @param position The position.
+     * @param f The visitor, called as f(index) for every point in the 3^N cells around position.
+     */
+    template <typename F>
+    void forEachNeighbor(const Vector_t &position, F &&f) const {
+        const Cell_t center = cell(position);
+        Cell_t offset(-1);
+        while (true) {
+            Cell_t current(center);
+            current += offset;
+            const Range_t range = points(current);
+            for (const std::uint32_t *i = range.first; i != range.second; ++i)
+                f(std::size_t(*i));
+
+            // Advance the offset in [-1, 1]^N like an odometer.
+            unsigned c = 0;
+            while (c < N && offset[c] == 1)
+                offset[c++] = -1;
+            if (c == N)
+                break;
+            ++offset[c];
+        }
+    }
+
+private:
+    /**
+     * @brief An entry of the hash table.
+     */
+    struct Entry {
+        Cell_t key;           ///< The cell.
+        std::uint32_t begin;  ///< The first point index of the cell in m_indices.
+        std::uint32_t count;  ///< The number of points in the cell, 0 for empty entries.
+    };
+
+    /**
+     * @brief Compare two cells.
+     * @param a The first cell.
+     * @param b The second cell.
+     * @return True if the cells are equal.
+     */
+    static bool equal(const Cell_t &a, const Cell_t &b) {
+        for (unsigned c = 0; c < N; ++c)
+            if (a[c] != b[c])
+                return false;
+        return true;
+    }
+
+    /**
+     * @brief Find the entry of a cell, inserting it if needed.
+     * @param key The cell.
+     * @return The slot of the entry.
+     */
+    std::size_t insert(const Cell_t &key) {
+        const std::size_t mask = m_table.size() - 1;
+        std::size_t slot = std::size_t(mathlib::hashValue(key)) & mask;
+        while (m_table[slot].count != 0 && !equal(m_table[slot].key, key))
+            slot = (slot + 1) & mask;
+        if (m_table[slot].count == 0) {
+            m_table[slot].key = key;
+            ++m_cells;
+        }
+        return slot;
+    }
+
+private:
+    T m_cell_size;                         ///< The edge length of the cells.
+    T m_inv_cell_size;                     ///< The inverse edge length of the cells.
+    std::vector<Entry> m_table;            ///< The hash table of the occupied cells.
+    std::vector<std::uint32_t> m_indices;  ///< The point indices, sorted by cell.
+    std::vector<std::uint32_t> m_slots;    ///< The table slot of every point, only used while building.
+    std::size_t m_cells = 0;               ///< The number of occupied cells.
+};
+
+/**
+ * @name Defines
+ * @brief Underlying data type definitions.
+ */
+/** @{ */
+using SpatialHashGrid2f = SpatialHashGrid<2, float>;
+using SpatialHashGrid3f = SpatialHashGrid<3, float>;
+using SpatialHashGrid2d = SpatialHashGrid<2, double>;
+using SpatialHashGrid3d = SpatialHashGrid<3, double>;
+/** @} */
+
+#endif /* __MATHLIB_HASH_GRID_H__ */
@@ -0,0 +1,322 @@
+#ifndef __MATHLIB_KDTREE_H__
+#define __MATHLIB_KDTREE_H__
+
+#include <mathlib/parallel.h>
+#include <mathlib/vector.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+/**
+ * @brief Static k-d tree over a set of points.
+ *
+ * The nodes are stored in one flat array in depth-first order, the left child of a node directly follows it.
+ * The points are copied in leaf order, so every leaf is a contiguous block of memory.
+ * Distances are squared euclidian distances, i.e. (a - b).squaredNorm().
+ * @tparam N The size of the vectors.
+ * @tparam T The underlying data type of the vectors.
+ */
+template <unsigned N, typename T>
+class KdTree {
+public:
+    using type = T;                 ///< The underlying data type.
+    using Vector_t = Vector<N, T>;  ///< The point type.
+
+    /**
+     * @brief Result of a query.
+     */
+    struct Neighbor {
+        std::size_t index;   ///< The index of the point in the input of the constructor.
+        T squared_distance;  ///< The squared distance to the query point.
+    };
+
+    /**
+     * @brief Index of a missing neighbor, if a tree has less than k points.
+     */
+    constexpr static std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * @brief Create an empty tree.
+     */
+    KdTree() = default;
+
+    /**
+     * @brief Build a tree.
+     * @param points The points, copied into the tree.
+     * @param count The number of points.
+     * @param leaf_size The maximal number of points per leaf.
+     */
+    KdTree(const Vector_t *points, std::size_t count, unsigned leaf_size = 16) {
+        assert(count < std::numeric_limits<std::uint32_t>::max());
+        std::vector<std::uint32_t> order(count);
+        std::iota(order.begin(), order.end(), std::uint32_t(0));
+        if (count > 0)
+            build(points, order, 0, std::uint32_t(count), std::max(leaf_size, 1u));
+
+        m_points.resize(count);
+        m_indices.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            m_points[i] = points[order[i]];
+            m_indices[i] = order[i];
+        }
+    }
+
+    /**
+     * @brief Build a tree.
+     * @param points The points, copied into the tree.
+     * @param leaf_size The maximal number of points per leaf.
+     */
+    explicit KdTree(const std::vector<Vector_t> &points, unsigned leaf_size = 16) : KdTree(points.data(), points.size(), leaf_size) {}
+
+    /**
+     * @brief The number of points.
+     * @return The number of points.
+     */
+    std::size_t size() const {
+        return m_points.size();
+    }
+
+    /**
+     * @brief Check if the tree is empty.
+     * @return True if there are no points.
+     */
+    bool empty() const {
+        return m_points.empty();
+    }
+
+    /**
+     * @brief Find the nearest point.
+     * @param query The query point.
+     * @return The nearest point, index is npos for an empty tree.
+     */
+    Neighbor nearest(const Vector_t &query) const {
+        Neighbor ret{npos, std::numeric_limits<T>::max()};
+        T bound = std::numeric_limits<T>::max();
+        search(query, bound, [&](std::size_t i, T d) {
+            if (d < ret.squared_distance || (d == ret.squared_distance && m_indices[i] < ret.index)) {
+                ret = Neighbor{m_indices[i], d};
+                bound = d;
+            }
+        });
+        return ret;
+    }
+
+    /**
+     * @brief Find the k nearest points.
+     *
+     * Points with equal distance are ordered by index.
+     * @param query The query point.
+     * @param k The number of points.
+     * @return Up to k points, sorted by distance.
+     */
+    std::vector<Neighbor> knn(const Vector_t &query, unsigned k) const {
+        std::vector<Neighbor> ret;
+        if (k == 0)
+            return ret;
+        ret.reserve(k);
+        T bound = std::numeric_limits<T>::max();
+        search(query, bound, [&](std::size_t i, T d) {
+            const Neighbor n{m_indices[i], d};
+            if (ret.size() < k) {
+                ret.push_back(n);
+                std::push_heap(ret.begin(), ret.end(), closer);
+            } else if (closer(n, ret.front())) {
+                std::pop_heap(ret.begin(), ret.end(), closer);
+                ret.back() = n;
+                std::push_heap(ret.begin(), ret.end(), closer);
+            }
+            if (ret.size() == k)
+                bound = ret.front().squared_distance;
+        });
+        std::sort_heap(ret.begin(), ret.end(), closer);
+        return ret;
+    }
+
+    /**
+     * @brief Find all points within a radius.
+     * @param query The query point.
+     * @param radius The radius, points at exactly this distance are included.
+     * @return The points, sorted by distance.
+     */
+    std::vector<Neighbor> radius(const Vector_t &query, T radius) const {
+        std::vector<Neighbor> ret;
+        T bound = radius * radius;
+        search(query, bound, [&](std::size_t i, T d) { ret.push_back(Neighbor{m_indices[i], d}); });
+        std::sort(ret.begin(), ret.end(), closer);
+        return ret;
+    }
+
+    /**
+     * @brief Find the k nearest points for many queries.
+     * @param queries The query points.
+     * @param count The number of queries.
+     * @param k The number of points per query.
+     * @param indices The indices of the neighbors, must hold count * k values. Missing neighbors are npos.
+     * @param squared_distances The squared distances, must hold count * k values or be nullptr.
+     * @param threads The number of threads, 0 for one per hardware thread.
+     */
+    void knn(const Vector_t *queries, std::size_t count, unsigned k, std::size_t *indices, T *squared_distances, unsigned threads = 1) const {
+        mathlib::parallelFor(count, threads, query_grain, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t q = begin; q < end; ++q) {
+                const std::vector<Neighbor> neighbors = knn(queries[q], k);
+                for (unsigned j = 0; j < k; ++j) {
+                    const bool found = j < neighbors.size();
+                    indices[q * k + j] = found ? neighbors[j].index : npos;
+                    if (squared_distances)
+                        squared_distances[q * k + j] = found ? neighbors[j].squared_distance : std::numeric_limits<T>::max();
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Find all points within a radius for many queries.
+     * @param queries The query points.
+     * @param count The number of queries.
+     * @param radius The radius.
+     * @param threads The number of threads, 0 for one per hardware thread.
+     * @return The points per query, sorted by distance.
+     */
+    std::vector<std::vector<Neighbor>> radius(const Vector_t *queries, std::size_t count, T radius, unsigned threads = 1) const {
+        std::vector<std::vector<Neighbor>> ret(count);
+        mathlib::parallelFor(count, threads, query_grain, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t q = begin; q < end; ++q)
+                ret[q] = this->radius(queries[q], radius);
+        });
+        return ret;
+    }
+
+private:
+    /**
+     * @brief A node of the tree.
+     */
+    struct Node {
+        T split;              ///< The split value of an inner node.
+        std::uint32_t begin;  ///< The first point of the subtree.
+        std::uint32_t end;    ///< Behind the last point of the subtree.
+        std::uint32_t right;  ///< The index of the right child, 0 for leaves.
+        std::uint32_t axis;   ///< The split axis of an inner node.
+    };
+
+    /**
+     * @brief Order neighbors by distance, then by index.
+     * @param a The first neighbor.
+     * @param b The second neighbor.
+     * @return True if a is closer than b.
+     */
+    static bool closer(const Neighbor &a, const Neighbor &b) {
+        return a.squared_distance < b.squared_distance || (a.squared_distance == b.squared_distance && a.index < b.index);
+    }
+
+    /**
+     * @brief Build the subtree of [begin, end), splitting at the median of the axis with the largest extent.
+     * @param points The points.
+     * @param order The permutation of the points, reordered in place.
+     * @param begin The first point.
+     * @param end Behind the last point.
+     * @param leaf_size The maximal number of points per leaf.
+     */
+    void build(const Vector_t *points, std::vector<std::uint32_t> &order, std::uint32_t begin, std::uint32_t end, unsigned leaf_size) {
+        const std::size_t node = m_nodes.size();
+        m_nodes.push_back(Node{T(0), begin, end, 0, 0});
+        if (end - begin <= leaf_size)
+            return;
+
+        Vector_t lo(points[order[begin]]), hi(points[order[begin]]);
+        for (std::uint32_t i = begin + 1; i < end; ++i) {
+            for (unsigned c = 0; c < N; ++c) {
+                lo[c] = std::min(lo[c], points[order[i]][c]);
+                hi[c] = std::max(hi[c], points[order[i]][c]);
+            }
+        }
+        unsigned axis = 0;
+        for (unsigned c = 1; c < N; ++c)
+            if (hi[c] - lo[c] > hi[axis] - lo[axis])
+                axis = c;
+        if (!(hi[axis] > lo[axis]))
+            return;
+
+        const std::uint32_t mid = begin + (end - begin) / 2;
+        std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+                         [points, axis](std::uint32_t a, std::uint32_t b) { return points[a][axis] < points[b][axis]; });
+        m_nodes[node].split = points[order[mid]][axis];
+        m_nodes[node].axis = axis;
+        build(points, order, begin, mid, leaf_size);
+        m_nodes[node].right = std::uint32_t(m_nodes.size());
+        build(points, order, mid, end, leaf_size);
+    }
+
+    /**
+     * @brief Visit all points which may be within bound of a query, nearer subtrees first.
+     * @tparam F The visitor type.
+     * @param query The query point.
+     * @param bound The squared search radius, may be lowered by f.
+     * @param f The visitor, called as f(i, squared_distance) for every point i in leaf order with squared_distance <= bound.
+     */
+    template <typename F>
+    void search(const Vector_t &query, T &bound, F &&f) const {
+        if (m_nodes.empty())
+            return;
+
+        struct Entry {
+            std::uint32_t node;  ///< The subtree.
+            T distance;          ///< Lower bound of the squared distance to the subtree.
+        };
+        Entry stack[64];
+        int top = 0;
+        stack[top++] = Entry{0, T(0)};
+        while (top > 0) {
+            const Entry entry = stack[--top];
+            if (entry.distance > bound)
+                continue;
+
+            std::uint32_t n = entry.node;
+            while (m_nodes[n].right != 0) {
+                const Node &node = m_nodes[n];
+                const T diff = query[node.axis] - node.split;
+                const T distance = diff * diff;
+                if (distance <= bound)
+                    stack[top++] = Entry{diff <= T(0) ? node.right : n + 1, distance};
+                n = diff <= T(0) ? n + 1 : node.right;
+            }
+
+            for (std::uint32_t i = m_nodes[n].begin; i < m_nodes[n].end; ++i) {
+                T d(0);
+                for (unsigned c = 0; c < N; ++c) {
+                    const T diff = m_points[i][c] - query[c];
+                    d += diff * diff;
+                }
+                if (d <= bound)
+                    f(i, d);
+            }
+        }
+    }
+
+private:
+    /**
+     * @brief Minimal number of queries per thread in the batched queries.
+     */
+    constexpr static std::size_t query_grain = 256;
+
+    std::vector<Node> m_nodes;             ///< The nodes, in depth-first order.
+    std::vector<Vector_t> m_points;        ///< The points, in leaf order.
+    std::vector<std::uint32_t> m_indices;  ///< The input index of every point.
+};
+
+/**
+ * @name Defines
+ * @brief Underlying data type definitions.
+ */
+/** @{ */
+using KdTree2f = KdTree<2, float>;
+using KdTree3f = KdTree<3, float>;
+using KdTree2d = KdTree<2, double>;
+using KdTree3d = KdTree<3, double>;
+/** @} */
+
+#endif /* __MATHLIB_KDTREE_H__ */
@@ -1,10 +1,28 @@
 #ifndef __MATHLIB_MATHLIB_H__
 #define __MATHLIB_MATHLIB_H__
 
+#include <mathlib/aligned_vector.h>
+#include <mathlib/binary.h>
+#include <mathlib/bvh.h>
 #include <mathlib/defines.h>
+#include <mathlib/dvector.h>
+#include <mathlib/expression.h>
+#include <mathlib/half.h>
+#include <mathlib/hash_grid.h>
+#include <mathlib/kdtree.h>
+#include <mathlib/matrix.h>
 #include <mathlib/operators.h>
+#include <mathlib/parallel.h>
+#include <mathlib/precision.h>
 #include <mathlib/vector.h>
 #include <mathlib/quaternion.h>
+#include <mathlib/quaternion_array.h>
+#include <mathlib/ray.h>
+#include <mathlib/reduce.h>
+#include <mathlib/sparse_vector.h>
+#include <mathlib/text.h>
+#include <mathlib/vector_array.h>
+#include <mathlib/vector_view.h>
 
 
 #endif /* __MATHLIB_MATHLIB_H__  */
\ No newline at end of file
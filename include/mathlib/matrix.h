@@ -0,0 +1,408 @@
+#ifndef __MATHLIB_MATRIX_H__
+#define __MATHLIB_MATRIX_H__
+
+#include <mathlib/simd.h>
+#include <mathlib/vector.h>
+
+#include <cmath>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+
+/**
+ * @brief Fixed-size %Matrix class.
+ *
+ * The values are stored row-major. Products of 3x3 and 4x4 matrices are unrolled,
+ * 4x4 matrix-matrix products use SIMD registers where available.
+ * @tparam R The number of rows.
+ * @tparam C The number of columns.
+ * @tparam T The underlying data type.
+ */
+template <unsigned R, unsigned C, typename T>
+class Matrix {
+public:
+    using type = T;  ///< The underlying data type.
+
+    /**
+     * @brief The number of rows.
+     * @return The number of rows.
+     */
+    constexpr static unsigned rows() {
+        return R;
+    }
+
+    /**
+     * @brief The number of columns.
+     * @return The number of columns.
+     */
+    constexpr static unsigned cols() {
+        return C;
+    }
+
+    /**
+     * @brief Construct a zero matrix.
+     */
+    constexpr Matrix() : m_data{} {}
+
+    /**
+     * @brief Construct a matrix from a single value.
+     * @param t The single value
+     */
+    constexpr explicit Matrix(T t) : m_data{} {
+        for (unsigned i = 0; i < R * C; ++i)
+            m_data[i] = t;
+    }
+
+    /**
+     * @brief Construct a matrix from all of its values, row by row.
+     * @param values The R * C values, row-major.
+     */
+    template <typename... Args, typename std::enable_if<sizeof...(Args) == R * C && (R * C > 1), int>::type = 0>
+    constexpr Matrix(const Args &...values) : m_data{static_cast<T>(values)...} {}
+
+    /**
+     * @brief Create an identity matrix.
+     * @return The identity matrix.
+     */
+    constexpr static Matrix Identity() {
+        Matrix ret;
+        for (unsigned i = 0; i < R && i < C; ++i)
+            ret(i, i) = T(1.);
+        return ret;
+    }
+
+    /**
+     * @brief Read access to an element.
+     * @param r The row (0-indexed).
+     * @param c The column (0-indexed).
+     * @return The element.
+     * @attention Does not perform index boundary checks.
+     */
+    constexpr T operator()(unsigned r, unsigned c) const {
+        return m_data[r * C + c];
+    }
+
+    /**
+     * @brief Write access to an element.
+     * @param r The row (0-indexed).
+     * @param c The column (0-indexed).
+     * @return The element.
+     * @attention Does not perform index boundary checks.
+     */
+    constexpr T &operator()(unsigned r, unsigned c) {
+        return m_data[r * C + c];
+    }
+
+    /**
+     * @brief Read access to the underlying data.
+     * @return A pointer to the R * C values, row-major.
+     */
+    constexpr const T *data() const {
+        return m_data;
+    }
+
+    /**
+     * @brief Write access to the underlying data.
+     * @return A pointer to the R * C values, row-major.
+     */
+    constexpr T *data() {
+        return m_data;
+    }
+
+    /**
+     * @brief Get a row.
+     * @param r The row (0-indexed).
+     * @return A copy of the row.
+     */
+    constexpr Vector<C, T> row(unsigned r) const {
+        Vector<C, T> ret;
+        for (unsigned c = 0; c < C; ++c)
+            ret[c] = (*this)(r, c);
+        return ret;
+    }
+
+    /**
+     * @brief Get a column.
+     * @param c The column (0-indexed).
+     * @return A copy of the column.
+     */
+    constexpr Vector<R, T> col(unsigned c) const {
+        Vector<R, T> ret;
+        for (unsigned r = 0; r < R; ++r)
+            ret[r] = (*this)(r, c);
+        return ret;
+    }
+
+    /**
+     * @brief Set a row.
+     * @param r The row (0-indexed).
+     * @param v The new values.
+     */
+    constexpr void setRow(unsigned r, const Vector<C, T> &v) {
+        for (unsigned c = 0; c < C; ++c)
+            (*this)(r, c) = v[c];
+    }
+
+    /**
+     * @brief Set a column.
+     * @param c The column (0-indexed).
+     * @param v The new values.
+     */
+    constexpr void setCol(unsigned c, const Vector<R, T> &v) {
+        for (unsigned r = 0; r < R; ++r)
+            (*this)(r, c) = v[r];
+    }
+
+    /**
+     * @brief Compute the transpose.
+     * @return The transposed matrix.
+     */
+    constexpr Matrix<C, R, T> transpose() const {
+        Matrix<C, R, T> ret;
+        for (unsigned r = 0; r < R; ++r)
+            for (unsigned c = 0; c < C; ++c)
+                ret(c, r) = (*this)(r, c);
+        return ret;
+    }
+
+    /**
+     * @brief Multiply a vector with this.
+     * @param v The vector.
+     * @return The product this * v.
+     */
+    constexpr Vector<R, T> operator*(const Vector<C, T> &v) const {
+        Vector<R, T> ret;
+        if constexpr (R == 3 && C == 3) {
+            ret[0] = m_data[0] * v[0] + m_data[1] * v[1] + m_data[2] * v[2];
+            ret[1] = m_data[3] * v[0] + m_data[4] * v[1] + m_data[5] * v[2];
+            ret[2] = m_data[6] * v[0] + m_data[7] * v[1] + m_data[8] * v[2];
+        } else if constexpr (R == 4 && C == 4) {
+            ret[0] = m_data[0] * v[0] + m_data[1] * v[1] + m_data[2] * v[2] + m_data[3] * v[3];
+            ret[1] = m_data[4] * v[0] + m_data[5] * v[1] + m_data[6] * v[2] + m_data[7] * v[3];
+            ret[2] = m_data[8] * v[0] + m_data[9] * v[1] + m_data[10] * v[2] + m_data[11] * v[3];
+            ret[3] = m_data[12] * v[0] + m_data[13] * v[1] + m_data[14] * v[2] + m_data[15] * v[3];
+        } else {
+            for (unsigned r = 0; r < R; ++r) {
+                T sum(0.);
+                for (unsigned c = 0; c < C; ++c)
+                    sum += (*this)(r, c) * v[c];
+                ret[r] = sum;
+            }
+        }
+        return ret;
+    }
+
+    /**
+     * @brief Multiply another matrix with this.
+     * @tparam K The number of columns of the other matrix.
+     * @param other The other matrix.
+     * @return The product this * other.
+     */
+    template <unsigned K>
+    constexpr Matrix<R, K, T> operator*(const Matrix<C, K, T> &other) const {
+        Matrix<R, K, T> ret;
+        if constexpr (R == 4 && C == 4 && K == 4 && mathlib::simd::Pack<T, 4>::available) {
+            if (!MATHLIB_IS_CONSTANT_EVALUATED()) {
+                // Every row of the result is a linear combination of the rows of other.
+                using P = mathlib::simd::Pack<T, 4>;
+                const typename P::reg b0 = P::load(other.data());
+                const typename P::reg b1 = P::load(other.data() + 4);
+                const typename P::reg b2 = P::load(other.data() + 8);
+                const typename P::reg b3 = P::load(other.data() + 12);
+                for (unsigned r = 0; r < 4; ++r) {
+                    const T *a = m_data + 4 * r;
+                    typename P::reg acc = P::add(P::mul(P::set1(a[0]), b0), P::mul(P::set1(a[1]), b1));
+                    acc = P::add(acc, P::add(P::mul(P::set1(a[2]), b2), P::mul(P::set1(a[3]), b3)));
+                    P::store(ret.data() + 4 * r, acc);
+                }
+                return ret;
+            }
+        }
+        for (unsigned r = 0; r < R; ++r) {
+            for (unsigned k = 0; k < K; ++k) {
+                T sum(0.);
+                for (unsigned c = 0; c < C; ++c)
+                    sum += (*this)(r, c) * other(c, k);
+                ret(r, k) = sum;
+            }
+        }
+        return ret;
+    }
+
+    /**
+     * @brief Add another matrix.
+     * @param other The other matrix.
+     * @return The sum this + other.
+     */
+    constexpr Matrix operator+(const Matrix &other) const {
+        Matrix ret;
+        for (unsigned i = 0; i < R * C; ++i)
+            ret.m_data[i] = m_data[i] + other.m_data[i];
+        return ret;
+    }
+
+    /**
+     * @brief Subtract another matrix.
+     * @param other The other matrix.
+     * @return The difference this - other.
+     */
+    constexpr Matrix operator-(const Matrix &other) const {
+        Matrix ret;
+        for (unsigned i = 0; i < R * C; ++i)
+            ret.m_data[i] = m_data[i] - other.m_data[i];
+        return ret;
+    }
+
+    /**
+     * @brief Multiply this matrix by a scalar
+     * @param value The scalar
+     * @return A new matrix with this * value.
+     */
+    constexpr Matrix operator*(const T &value) const {
+        Matrix ret;
+        for (unsigned i = 0; i < R * C; ++i)
+            ret.m_data[i] = m_data[i] * value;
+        return ret;
+    }
+
+    /**
+     * @brief Compute the determinant.
+     * @return The determinant.
+     * @attention Only for square matrices up to size 4.
+     */
+    constexpr T determinant() const {
+        static_assert(R == C && R >= 1 && R <= 4 && "determinant is only implemented for square matrices up to size 4.");
+        const Matrix &a = *this;
+        if constexpr (R == 1) {
+            return a(0, 0);
+        } else if constexpr (R == 2) {
+            return a(0, 0) * a(1, 1) - a(0, 1) * a(1, 0);
+        } else if constexpr (R == 3) {
+            return a(0, 0) * (a(1, 1) * a(2, 2) - a(1, 2) * a(2, 1)) + a(0, 1) * (a(1, 2) * a(2, 0) - a(1, 0) * a(2, 2)) +
+                   a(0, 2) * (a(1, 0) * a(2, 1) - a(1, 1) * a(2, 0));
+        } else {
+            const T s0 = a(0, 0) * a(1, 1) - a(1, 0) * a(0, 1), s1 = a(0, 0) * a(1, 2) - a(1, 0) * a(0, 2);
+            const T s2 = a(0, 0) * a(1, 3) - a(1, 0) * a(0, 3), s3 = a(0, 1) * a(1, 2) - a(1, 1) * a(0, 2);
+            const T s4 = a(0, 1) * a(1, 3) - a(1, 1) * a(0, 3), s5 = a(0, 2) * a(1, 3) - a(1, 2) * a(0, 3);
+            const T c5 = a(2, 2) * a(3, 3) - a(3, 2) * a(2, 3), c4 = a(2, 1) * a(3, 3) - a(3, 1) * a(2, 3);
+            const T c3 = a(2, 1) * a(3, 2) - a(3, 1) * a(2, 2), c2 = a(2, 0) * a(3, 3) - a(3, 0) * a(2, 3);
+            const T c1 = a(2, 0) * a(3, 2) - a(3, 0) * a(2, 2), c0 = a(2, 0) * a(3, 1) - a(3, 0) * a(2, 1);
+            return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+        }
+    }
+
+    /**
+     * @brief Compute the inverse.
+     * @return The inverse of this.
+     * @throws std::runtime_error If the matrix is singular.
+     * @attention Only for floating point square matrices up to size 4.
+     */
+    constexpr Matrix inverse() const {
+        static_assert(std::is_floating_point<T>::value, "base type is not floating point.");
+        static_assert(R == C && R >= 1 && R <= 4 && "inverse is only implemented for square matrices up to size 4.");
+        const Matrix &a = *this;
+        Matrix ret;
+        T det(0.);
+        if constexpr (R == 1) {
+            det = a(0, 0);
+            ret(0, 0) = T(1.);
+        } else if constexpr (R == 2) {
+            det = determinant();
+            ret = Matrix(a(1, 1), -a(0, 1), -a(1, 0), a(0, 0));
+        } else if constexpr (R == 3) {
+            ret = Matrix(a(1, 1) * a(2, 2) - a(1, 2) * a(2, 1), a(0, 2) * a(2, 1) - a(0, 1) * a(2, 2), a(0, 1) * a(1, 2) - a(0, 2) * a(1, 1),  //
+                         a(1, 2) * a(2, 0) - a(1, 0) * a(2, 2), a(0, 0) * a(2, 2) - a(0, 2) * a(2, 0), a(0, 2) * a(1, 0) - a(0, 0) * a(1, 2),  //
+                         a(1, 0) * a(2, 1) - a(1, 1) * a(2, 0), a(0, 1) * a(2, 0) - a(0, 0) * a(2, 1), a(0, 0) * a(1, 1) - a(0, 1) * a(1, 0));
+            det = a(0, 0) * ret(0, 0) + a(0, 1) * ret(1, 0) + a(0, 2) * ret(2, 0);
+        } else {
+            const T s0 = a(0, 0) * a(1, 1) - a(1, 0) * a(0, 1), s1 = a(0, 0) * a(1, 2) - a(1, 0) * a(0, 2);
+            const T s2 = a(0, 0) * a(1, 3) - a(1, 0) * a(0, 3), s3 = a(0, 1) * a(1, 2) - a(1, 1) * a(0, 2);
+            const T s4 = a(0, 1) * a(1, 3) - a(1, 1) * a(0, 3), s5 = a(0, 2) * a(1, 3) - a(1, 2) * a(0, 3);
+            const T c5 = a(2, 2) * a(3, 3) - a(3, 2) * a(2, 3), c4 = a(2, 1) * a(3, 3) - a(3, 1) * a(2, 3);
+            const T c3 = a(2, 1) * a(3, 2) - a(3, 1) * a(2, 2), c2 = a(2, 0) * a(3, 3) - a(3, 0) * a(2, 3);
+            const T c1 = a(2, 0) * a(3, 2) - a(3, 0) * a(2, 2), c0 = a(2, 0) * a(3, 1) - a(3, 0) * a(2, 1);
+            det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+            ret = Matrix(a(1, 1) * c5 - a(1, 2) * c4 + a(1, 3) * c3, -a(0, 1) * c5 + a(0, 2) * c4 - a(0, 3) * c3,  //
+                         a(3, 1) * s5 - a(3, 2) * s4 + a(3, 3) * s3, -a(2, 1) * s5 + a(2, 2) * s4 - a(2, 3) * s3,  //
+                         -a(1, 0) * c5 + a(1, 2) * c2 - a(1, 3) * c1, a(0, 0) * c5 - a(0, 2) * c2 + a(0, 3) * c1,  //
+                         -a(3, 0) * s5 + a(3, 2) * s2 - a(3, 3) * s1, a(2, 0) * s5 - a(2, 2) * s2 + a(2, 3) * s1,  //
+                         a(1, 0) * c4 - a(1, 1) * c2 + a(1, 3) * c0, -a(0, 0) * c4 + a(0, 1) * c2 - a(0, 3) * c0,  //
+                         a(3, 0) * s4 - a(3, 1) * s2 + a(3, 3) * s0, -a(2, 0) * s4 + a(2, 1) * s2 - a(2, 3) * s0,  //
+                         -a(1, 0) * c3 + a(1, 1) * c1 - a(1, 2) * c0, a(0, 0) * c3 - a(0, 1) * c1 + a(0, 2) * c0,  //
+                         -a(3, 0) * s3 + a(3, 1) * s1 - a(3, 2) * s0, a(2, 0) * s3 - a(2, 1) * s1 + a(2, 2) * s0);
+        }
+        if (det == T(0.))
+            throw std::runtime_error("matrix is singular");
+        return ret * (T(1.) / det);
+    }
+
+    /**
+     * @brief Check for equality.
+     * @param lhs The first matrix.
+     * @param rhs The second matrix.
+     * @return True if the matrices are equal (floating-point comparison).
+     */
+    friend bool operator==(const Matrix &lhs, const Matrix &rhs) {
+        for (unsigned i = 0; i < R * C; ++i)
+            if (fabs(lhs.m_data[i] - rhs.m_data[i]) > std::numeric_limits<double>::epsilon())
+                return false;
+        return true;
+    }
+
+    /**
+     * @brief Check for inequality.
+     * @param lhs The first matrix.
+     * @param rhs The second matrix.
+     * @return True if the matrices are not equal (floating-point comparison).
+     */
+    friend bool operator!=(const Matrix &lhs, const Matrix &rhs) {
+        return !(lhs == rhs);
+    }
+
+    /**
+     * @brief Write a matrix to a stream, one row per line.
+     * @param os The stream.
+     * @param m The matrix.
+     * @return The stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const Matrix &m) {
+        for (unsigned r = 0; r < R; ++r) {
+            os << m.row(r);
+            if (r < R - 1)
+                os << "\n";
+        }
+        return os;
+    }
+
+private:
+    T m_data[R * C];  ///< The underlying data, row-major.
+};
+
+/**
+ * @brief Multiply a scalar with the matrix
+ * @tparam R The number of rows.
+ * @tparam C The number of columns.
+ * @tparam T The underlying data type.
+ * @param value The scalar
+ * @param m The matrix
+ * @return A new matrix with m * value, elementwise
+ */
+template <unsigned R, unsigned C, typename T>
+constexpr Matrix<R, C, T> operator*(const typename mathlib::detail::NonDeduced<T>::type &value, const Matrix<R, C, T> &m) {
+    return m * value;
+}
+
+/**
+ * @name Defines
+ * @brief Underlying data type definitions.
+ */
+/** @{ */
+using Matrix2f = Matrix<2, 2, float>;
+using Matrix3f = Matrix<3, 3, float>;
+using Matrix4f = Matrix<4, 4, float>;
+using Matrix2d = Matrix<2, 2, double>;
+using Matrix3d = Matrix<3, 3, double>;
+using Matrix4d = Matrix<4, 4, double>;
+/** @} */
+
+#endif /* __MATHLIB_MATRIX_H__ */
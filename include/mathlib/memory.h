@@ -0,0 +1,234 @@
+#ifndef __MATHLIB_MEMORY_H__
+#define __MATHLIB_MEMORY_H__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <vector>
+
+/**
+ * @brief Allocator returning memory aligned to a given boundary.
+ *
+ * Used for contiguous storage which is processed with (aligned) SIMD loads.
+ * @tparam T The value type.
+ * @tparam Alignment The alignment in bytes, defaults to a cache line.
+ */
+template <typename T, std::size_t Alignment = 64>
+class AlignedAllocator {
+public:
+    static_assert(Alignment >= alignof(T), "alignment is smaller than the alignment of the value type.");
+    static_assert((Alignment & (Alignment - 1)) == 0, "alignment is not a power of two.");
+
+    using value_type = T;  ///< The value type.
+
+    /**
+     * @brief Rebind helper for other value types.
+     * @tparam U The other value type.
+     */
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;  ///< The rebound allocator.
+    };
+
+    /**
+     * @brief Create an allocator.
+     */
+    AlignedAllocator() noexcept = default;
+
+    /**
+     * @brief Create an allocator from an allocator of another value type.
+     */
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept {}
+
+    /**
+     * @brief Allocate aligned memory.
+     * @param n The number of elements.
+     * @return A pointer to the memory, aligned to Alignment.
+     * @throws std::bad_alloc If the allocation fails.
+     */
+    T *allocate(std::size_t n) {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_alloc();
+        return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    /**
+     * @brief Free memory obtained by allocate().
+     * @param p The pointer to the memory.
+     */
+    void deallocate(T *p, std::size_t) noexcept {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    /**
+     * @brief All aligned allocators with the same alignment are interchangeable.
+     * @return Always true.
+     */
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment> &) const noexcept {
+        return true;
+    }
+
+    /**
+     * @brief All aligned allocators with the same alignment are interchangeable.
+     * @return Always false.
+     */
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment> &) const noexcept {
+        return false;
+    }
+};
+
+/**
+ * @brief Monotonic arena, hands out memory from large blocks and frees everything at once.
+ *
+ * Allocating is a pointer bump, deallocating single allocations is a no-op.
+ * Use it with ArenaAllocator for short-lived objects, e.g. all vectors of one request.
+ */
+class MonotonicArena {
+public:
+    /**
+     * @brief Create an arena.
+     * @param block_size The size of the memory blocks in bytes, larger allocations get their own block.
+     */
+    explicit MonotonicArena(std::size_t block_size = 1 << 16) : m_block_size(std::max<std::size_t>(block_size, 64)) {}
+
+    /**
+     * @brief Arenas can not be copied.
+     */
+    MonotonicArena(const MonotonicArena &) = delete;
+
+    /**
+     * @brief Arenas can not be copied.
+     */
+    MonotonicArena &operator=(const MonotonicArena &) = delete;
+
+    /**
+     * @brief Free all memory.
+     */
+    ~MonotonicArena() {
+        release();
+    }
+
+    /**
+     * @brief Allocate memory.
+     * @param bytes The number of bytes.
+     * @param alignment The alignment, a power of two.
+     * @return A pointer to the memory, valid until release() is called.
+     * @throws std::bad_alloc If the allocation fails.
+     */
+    void *allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+        std::uintptr_t p = (m_current + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+        if (m_current == 0 || p + bytes > m_end) {
+            const std::size_t size = std::max(m_block_size, bytes + alignment);
+            m_blocks.push_back(::operator new(size));
+            m_current = reinterpret_cast<std::uintptr_t>(m_blocks.back());
+            m_end = m_current + size;
+            p = (m_current + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+        }
+        m_current = p + bytes;
+        return reinterpret_cast<void *>(p);
+    }
+
+    /**
+     * @brief Free all memory handed out by this arena.
+     */
+    void release() {
+        for (void *block : m_blocks)
+            ::operator delete(block);
+        m_blocks.clear();
+        m_current = 0;
+        m_end = 0;
+    }
+
+    /**
+     * @brief The number of blocks obtained from the system.
+     * @return The number of blocks.
+     */
+    std::size_t blocks() const {
+        return m_blocks.size();
+    }
+
+private:
+    std::size_t m_block_size;      ///< The default size of a block.
+    std::vector<void *> m_blocks;  ///< All blocks.
+    std::uintptr_t m_current = 0;  ///< The next free byte in the current block.
+    std::uintptr_t m_end = 0;      ///< The end of the current block.
+};
+
+/**
+ * @brief Allocator handing out memory from a MonotonicArena.
+ * @tparam T The value type.
+ * @attention The arena must outlive all containers using it.
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;  ///< The value type.
+
+    /**
+     * @brief Create an allocator for an arena.
+     * @param arena The arena.
+     */
+    ArenaAllocator(MonotonicArena &arena) noexcept : m_arena(&arena) {}
+
+    /**
+     * @brief Create an allocator from an allocator of another value type.
+     * @param other The other allocator.
+     */
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) noexcept : m_arena(other.arena()) {}
+
+    /**
+     * @brief Allocate memory from the arena.
+     * @param n The number of elements.
+     * @return A pointer to the memory.
+     */
+    T *allocate(std::size_t n) {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_alloc();
+        return static_cast<T *>(m_arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    /**
+     * @brief Does nothing, the memory is freed with the arena.
+     */
+    void deallocate(T *, std::size_t) noexcept {}
+
+    /**
+     * @brief The arena of this allocator.
+     * @return The arena.
+     */
+    MonotonicArena *arena() const noexcept {
+        return m_arena;
+    }
+
+    /**
+     * @brief Allocators are equal if they use the same arena.
+     * @param other The other allocator.
+     * @return True if both use the same arena.
+     */
+    template <typename U>
+    bool operator==(const ArenaAllocator<U> &other) const noexcept {
+        return m_arena == other.arena();
+    }
+
+    /**
+     * @brief Allocators are equal if they use the same arena.
+     * @param other The other allocator.
+     * @return True if the arenas differ.
+     */
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U> &other) const noexcept {
+        return m_arena != other.arena();
+    }
+
+private:
+    MonotonicArena *m_arena;  ///< The arena.
+};
+
+#endif /* __MATHLIB_MEMORY_H__ */
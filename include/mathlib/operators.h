@@ -1,52 +1,66 @@
 #ifndef __MATHLIB_OPERATORS_H__
 #define __MATHLIB_OPERATORS_H__
 
+#include <mathlib/expression.h>
 #include <mathlib/vector.h>
 
 /**
  * @brief Add two vectors.
+ *
+ * The result is evaluated lazily, see VectorExpression.
+ * @tparam E1 The type of the first expression.
+ * @tparam E2 The type of the second expression.
  * @tparam N The size of the vectors.
  * @tparam T The underlying data type of the vectors.
  * @param a The first vector.
  * @param b The second vector.
  * @return a + b
  */
-template <unsigned N, typename T>
-Vector<N, T> operator+(Vector<N, T> a, const Vector<N, T> &b) {
-    a += b;
-    return a;
+template <typename E1, typename E2, unsigned N, typename T>
+constexpr VectorBinaryExpression<E1, E2, mathlib::detail::Add> operator+(const VectorExpression<E1, N, T> &a, const VectorExpression<E2, N, T> &b) {
+    return VectorBinaryExpression<E1, E2, mathlib::detail::Add>(a.derived(), b.derived());
 }
 
 /**
  * @brief Subtract two vectors.
+ *
+ * The result is evaluated lazily, see VectorExpression.
+ * @tparam E1 The type of the first expression.
+ * @tparam E2 The type of the second expression.
  * @tparam N The size of the vectors.
  * @tparam T The underlying data type of the vectors.
  * @param a The first vector.
  * @param b The second vector.
  * @return a - b
  */
-template <unsigned N, typename T>
-Vector<N, T> operator-(Vector<N, T> a, const Vector<N, T> &b) {
-    a -= b;
-    return a;
+template <typename E1, typename E2, unsigned N, typename T>
+constexpr VectorBinaryExpression<E1, E2, mathlib::detail::Subtract> operator-(const VectorExpression<E1, N, T> &a, const VectorExpression<E2, N, T> &b) {
+    return VectorBinaryExpression<E1, E2, mathlib::detail::Subtract>(a.derived(), b.derived());
 }
 
 /**
  * @brief Multiply two vectors.
+ *
+ * The result is evaluated lazily, see VectorExpression.
+ * @tparam E1 The type of the first expression.
+ * @tparam E2 The type of the second expression.
  * @tparam N The size of the vectors.
  * @tparam T The underlying data type of the vectors.
  * @param a The first vector.
  * @param b The second vector.
  * @return a * b
  */
-template <unsigned N, typename T>
-Vector<N, T> operator*(Vector<N, T> a, const Vector<N, T> &b) {
-    a *= b;
-    return a;
+template <typename E1, typename E2, unsigned N, typename T>
+constexpr VectorBinaryExpression<E1, E2, mathlib::detail::Multiply> operator*(const VectorExpression<E1, N, T> &a, const VectorExpression<E2, N, T> &b) {
+    return VectorBinaryExpression<E1, E2, mathlib::detail::Multiply>(a.derived(), b.derived());
 }
 
 /**
  * @brief Divide two vectors.
+ *
+ * The result is evaluated lazily, see VectorExpression.
+ * @tparam E1 The type of the first expression.
+ * @tparam E2 The type of the second expression.
  * @tparam N The size of the vectors.
  * @tparam T The underlying data type of the vectors.
  * @param a The first vector.
@@ -54,51 +68,52 @@ Vector<N, T> operator*(Vector<N, T> a, const Vector<N, T> &b) {
  * @return a / b
  * @attention Only supported for floating point vector types!
  */
-template <unsigned N, typename T>
-Vector<N, T> operator/(Vector<N, T> a, const Vector<N, T> &b) {
+template <typename E1, typename E2, unsigned N, typename T>
+constexpr VectorBinaryExpression<E1, E2, mathlib::detail::Divide> operator/(const VectorExpression<E1, N, T> &a, const VectorExpression<E2, N, T> &b) {
     static_assert(std::is_floating_point<T>::value && "base type is not floating point.");
-    a /= b;
-    return a;
+    return VectorBinaryExpression<E1, E2, mathlib::detail::Divide>(a.derived(), b.derived());
 }
 
 /**
  * @brief Add a scalar to the vector
+ * @tparam E The type of the expression.
  * @tparam N The size of the vectors.
  * @tparam T The underlying data type of the vectors.
  * @param value The scalar
  * @param v The vector
- * @return A new vector with v + value, elementwise
+ * @return An expression with v + value, elementwise
  */
-template <unsigned N, typename T>
-Vector<N, T> operator+(const T &value, Vector<N, T> v) {
-    v += value;
-    return v;
+template <typename E, unsigned N, typename T>
+constexpr VectorScalarExpression<E, mathlib::detail::Add> operator+(const typename mathlib::detail::NonDeduced<T>::type &value,
+                                                                    const VectorExpression<E, N, T> &v) {
+    return VectorScalarExpression<E, mathlib::detail::Add>(v.derived(), value);
 }
 
 /**
  * @brief Multiply a scalar with the vector
+ * @tparam E The type of the expression.
  * @tparam N The size of the vectors.
  * @tparam T The underlying data type of the vectors.
  * @param value The scalar
  * @param v The vector
- * @return A new vector with v * value, elementwise
+ * @return An expression with v * value, elementwise
  */
-template <unsigned N, typename T>
-Vector<N, T> operator*(const T &value, Vector<N, T> v) {
-    v *= value;
-    return v;
+template <typename E, unsigned N, typename T>
+constexpr VectorScalarExpression<E, mathlib::detail::Multiply> operator*(const typename mathlib::detail::NonDeduced<T>::type &value,
+                                                                         const VectorExpression<E, N, T> &v) {
+    return VectorScalarExpression<E, mathlib::detail::Multiply>(v.derived(), value);
 }
 
 /**
  * @brief Negate a vector.
+ * @tparam E The type of the expression.
  * @tparam N The size of the vectors.
  * @tparam T The underlying data type of the vectors.
- * @return A new vector which is negative elementwise.
+ * @return An expression which is negative elementwise.
  */
-template <unsigned N, typename T>
-Vector<N, T> operator-(Vector<N, T> v) {
-    v *= T(-1.);
-    return v;
+template <typename E, unsigned N, typename T>
+constexpr VectorUnaryExpression<E, mathlib::detail::Negate> operator-(const VectorExpression<E, N, T> &v) {
+    return VectorUnaryExpression<E, mathlib::detail::Negate>(v.derived());
 }
 
-#endif /* __MATHLIB_OPERATORS_H__ */
\ No newline at end of file
+#endif /* __MATHLIB_OPERATORS_H__ */
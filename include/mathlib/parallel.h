@@ -0,0 +1,74 @@
+#ifndef __MATHLIB_PARALLEL_H__
+#define __MATHLIB_PARALLEL_H__
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace mathlib {
+
+/**
+ * @brief Resolve a requested number of threads.
+ * @param threads The requested number of threads, 0 for one per hardware thread.
+ * @return The number of threads to use, at least 1.
+ */
+inline unsigned threadCount(unsigned threads) {
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+    return std::max(threads, 1u);
+}
+
+/**
+ * @brief Split [0, count) into contiguous chunks and process them in parallel.
+ *
+ * The chunks are fixed by count, threads and grain only, so the partitioning is deterministic.
+ * Inputs smaller than two grains are processed on the calling thread.
+ * @tparam F The function type.
+ * @param count The number of items.
+ * @param threads The number of threads, 0 for one per hardware thread.
+ * @param grain The minimal number of items per chunk.
+ * @param f The function, called as f(chunk, begin, end) for every chunk.
+ * @return The number of chunks.
+ * @attention f must not throw.
+ */
+template <typename F>
+std::size_t parallelChunks(std::size_t count, unsigned threads, std::size_t grain, F &&f) {
+    const std::size_t max_chunks = std::max<std::size_t>(count / std::max<std::size_t>(grain, 1), 1);
+    const std::size_t chunks = max_chunks > 1 ? std::min<std::size_t>(threadCount(threads), max_chunks) : 1;
+    if (chunks <= 1) {
+        f(std::size_t(0), std::size_t(0), count);
+        return 1;
+    }
+
+    const std::size_t chunk_size = (count + chunks - 1) / chunks;
+    std::vector<std::thread> workers;
+    workers.reserve(chunks - 1);
+    for (std::size_t c = 1; c < chunks; ++c) {
+        const std::size_t begin = std::min(c * chunk_size, count);
+        const std::size_t end = std::min(begin + chunk_size, count);
+        workers.emplace_back([&f, c, begin, end]() { f(c, begin, end); });
+    }
+    f(std::size_t(0), std::size_t(0), std::min(chunk_size, count));
+    for (std::thread &worker : workers)
+        worker.join();
+    return chunks;
+}
+
+/**
+ * @brief Process [0, count) in parallel.
+ * @tparam F The function type.
+ * @param count The number of items.
+ * @param threads The number of threads, 0 for one per hardware thread.
+ * @param grain The minimal number of items per thread.
+ * @param f The function, called as f(begin, end) for every chunk.
+ * @attention f must not throw.
+ */
+template <typename F>
+void parallelFor(std::size_t count, unsigned threads, std::size_t grain, F &&f) {
+    parallelChunks(count, threads, grain, [&f](std::size_t, std::size_t begin, std::size_t end) { f(begin, end); });
+}
+
+}  // namespace mathlib
+
+#endif /* __MATHLIB_PARALLEL_H__ */
@@ -0,0 +1,89 @@
+#ifndef __MATHLIB_PRECISION_H__
+#define __MATHLIB_PRECISION_H__
+
+#include <mathlib/simd.h>
+
+#include <cmath>
+#include <type_traits>
+
+namespace mathlib {
+
+/**
+ * @brief Precision policy: results as exact as the default functions.
+ */
+struct ExactMath {};
+
+/**
+ * @brief Precision policy: hardware approximations of the reciprocal (square root), refined with Newton steps.
+ *
+ * Costs a few ULPs (relative error below 5e-7 for float and 1e-13 for double) in exchange for throughput.
+ */
+struct FastMath {};
+
+constexpr ExactMath exact{};  ///< Tag to select ExactMath.
+constexpr FastMath fast{};    ///< Tag to select FastMath.
+
+/**
+ * @brief Check if a type is a precision policy.
+ * @tparam P The type.
+ */
+template <typename P>
+constexpr bool is_precision_policy = std::is_same<P, ExactMath>::value || std::is_same<P, FastMath>::value;
+
+/**
+ * @brief Summation policy: compensated (Kahan-Babuska / Neumaier) summation of sums and dot-products.
+ *
+ * The rounding errors of the additions are accumulated separately and added back, so the result of a reduction
+ * over many values is about as accurate as a single rounding, at a few times the cost of the default reduction.
+ */
+struct Compensated {};
+
+constexpr Compensated compensated{};  ///< Tag to select Compensated.
+
+/**
+ * @brief Reciprocal square root.
+ * @tparam T The underlying data type, floating point.
+ * @param x The value, positive.
+ * @return 1 / sqrt(x).
+ */
+template <typename T>
+T rsqrt(T x, ExactMath) {
+    return T(1.) / std::sqrt(x);
+}
+
+/**
+ * @brief Approximate reciprocal square root.
+ * @tparam T The underlying data type, floating point.
+ * @param x The value, positive and finite.
+ * @return About 1 / sqrt(x).
+ */
+template <typename T>
+T rsqrt(T x, FastMath) {
+    return mathlib::simd::rsqrt(x);
+}
+
+/**
+ * @brief Reciprocal.
+ * @tparam T The underlying data type, floating point.
+ * @param x The value, non-zero.
+ * @return 1 / x.
+ */
+template <typename T>
+T rcp(T x, ExactMath) {
+    return T(1.) / x;
+}
+
+/**
+ * @brief Approximate reciprocal.
+ * @tparam T The underlying data type, floating point.
+ * @param x The value, non-zero and finite.
+ * @return About 1 / x.
+ */
+template <typename T>
+T rcp(T x, FastMath) {
+    return mathlib::simd::rcp(x);
+}
+
+}  // namespace mathlib
+
+#endif /* __MATHLIB_PRECISION_H__ */
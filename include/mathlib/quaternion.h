@@ -1,9 +1,336 @@
 #ifndef __MATHLIB_QUATERNION_H__
 #define __MATHLIB_QUATERNION_H__
 
+#include <mathlib/matrix.h>
 #include <mathlib/operators.h>
+#include <mathlib/parallel.h>
+#include <mathlib/vector_array.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace mathlib {
+
+namespace detail {
+
+/**
+ * @brief Constants of the branch-free kernels invSqrt() and sincos().
+ *
+ * The sine and cosine coefficients are the minimax polynomials of the Cephes library, the arcsine ones interpolate
+ * at the Chebyshev nodes of [0, 1 / 4].
+ * @tparam T The underlying data type.
+ */
+template <typename T>
+struct KernelConstants;
+
+/**
+ * @brief Constants of the branch-free kernels for float.
+ */
+template <>
+struct KernelConstants<float> {
+    using Bits = std::uint32_t;                     ///< Unsigned integer of the same size.
+    constexpr static float round = 12582912.f;      ///< 1.5 * 2^23, adding it rounds to an integer.
+    constexpr static Bits rsqrt_magic = 0x5f375a86;  ///< Initial guess of invSqrt() from the bits.
+    constexpr static unsigned rsqrt_steps = 3;      ///< Newton steps of invSqrt().
+    constexpr static float pio2[3] = {1.5703125f, 4.837512969970703125e-4f, 7.54978995489188216e-8f};  ///< pi / 2 in three parts.
+    constexpr static float sin[3] = {-1.9515295891e-4f, 8.3321608736e-3f, -1.6666654611e-1f};         ///< sin(r) / r - 1 in r^2.
+    constexpr static float cos[3] = {2.443315711809948e-5f, -1.388731625493765e-3f, 4.166664568298827e-2f};  ///< cos(r) in r^2.
+    constexpr static float asin[5] = {3.8085023561e-2f, 2.6554542206e-2f, 4.5001380070e-2f, 7.4988550726e-2f, 1.6666672415e-1f};  ///< asin(a) / a - 1 in a^2.
+};
+
+/**
+ * @brief Constants of the branch-free kernels for double.
+ */
+template <>
+struct KernelConstants<double> {
+    using Bits = std::uint64_t;                              ///< Unsigned integer of the same size.
+    constexpr static double round = 6755399441055744.;       ///< 1.5 * 2^52, adding it rounds to an integer.
+    constexpr static Bits rsqrt_magic = 0x5fe6eb50c7b537a9;  ///< Initial guess of invSqrt() from the bits.
+    constexpr static unsigned rsqrt_steps = 4;               ///< Newton steps of invSqrt().
+    constexpr static double pio2[3] = {1.57079625129699707031, 7.54978941586159635336e-8, 5.39030285815811905290e-15};  ///< pi / 2 in three parts.
+    constexpr static double sin[6] = {1.58962301576546568060e-10, -2.50507477628578072866e-8, 2.75573136213857245213e-6,
+                                      -1.98412698295895385996e-4, 8.33333333332211858878e-3, -1.66666666666666307295e-1};  ///< sin(r) / r - 1 in r^2.
+    constexpr static double cos[6] = {-1.13585365213876817300e-11, 2.08757008419747316778e-9, -2.75573141792967388112e-7,
+                                      2.48015872888517045348e-5, -1.38888888888730564116e-3, 4.16666666666665929218e-2};  ///< cos(r) in r^2.
+    constexpr static double asin[13] = {2.8757851367421566e-2, -1.4851887071247204e-2, 1.7400879442694020e-2, 5.4575067186403580e-3,
+                                        1.0322814350185780e-2, 1.1479177415184906e-2,  1.3971212973552933e-2, 1.7352392720869973e-2,
+                                        2.2372172942149890e-2, 3.0381944138531247e-2,  4.4642857146355430e-2, 7.4999999999984330e-2,
+                                        1.6666666666666669e-1};  ///< asin(a) / a - 1 in a^2.
+};
+
+/**
+ * @brief Compute 1 / sqrt(x) with arithmetic only, so loops calling it vectorize.
+ *
+ * std::sqrt may set errno, which keeps GCC and Clang from vectorizing it without -fno-math-errno. Starts from
+ * the guess of the integer bits and refines it with Newton steps to a few ulp.
+ * @tparam T The underlying data type.
+ * @param x The value, non-negative and finite. Zero gives a large finite value, so x * invSqrt(x) is zero.
+ * @return About 1 / sqrt(x).
+ */
+template <typename T>
+MATHLIB_ALWAYS_INLINE T invSqrt(T x) {
+    using K = KernelConstants<T>;
+    typename K::Bits bits;
+    std::memcpy(&bits, &x, sizeof(T));
+    bits = K::rsqrt_magic - (bits >> 1);
+    T y;
+    std::memcpy(&y, &bits, sizeof(T));
+    const T half_x = T(.5) * x;
+    for (unsigned i = 0; i < K::rsqrt_steps; ++i)
+        y = y * (T(1.5) - half_x * y * y);
+    return y;
+}
+
+/**
+ * @brief Compute the sine and cosine of x without branches, so loops calling it vectorize.
+ *
+ * Reduces x by the multiple of pi / 2 nearest to it in three parts (Cody-Waite), evaluates both polynomials on
+ * [-pi / 4, pi / 4] and swaps and negates them by the quadrant with bit operations. The rounding uses the
+ * addition of 1.5 * 2^(digits - 1) instead of std::nearbyint, which compiles to a call without SSE4.1, except
+ * with -ffast-math, which folds the addition and subtraction. Within a few ulp of std::sin and std::cos for |x|
+ * below 8192 (float) or 1e9 (double).
+ * @tparam T The underlying data type.
+ * @param x The angle in radians.
+ * @param s The sine of x.
+ * @param c The cosine of x.
+ */
+template <typename T>
+MATHLIB_ALWAYS_INLINE void sincos(T x, T& s, T& c) {
+    using K = KernelConstants<T>;
+    using Bits = typename K::Bits;
+    constexpr Bits sign = Bits(1) << (sizeof(T) * 8 - 1);
+
+#if defined(__FAST_MATH__)
+    // Reassociation folds the rounding by addition away.
+    const T j = std::nearbyint(x * T(0.63661977236758134308));
+    const Bits quadrant = Bits(static_cast<typename std::make_signed<Bits>::type>(j));
+#else
+    // The low bits of the rounded sum are the quadrant, in two's complement.
+    const T shifted = x * T(0.63661977236758134308) + K::round;
+    const T j = shifted - K::round;
+    Bits quadrant;
+    std::memcpy(&quadrant, &shifted, sizeof(T));
+#endif
+    const T r = ((x - j * K::pio2[0]) - j * K::pio2[1]) - j * K::pio2[2];
+    const T r_sqr = r * r;
+
+    T ps = K::sin[0];
+    T pc = K::cos[0];
+    for (std::size_t i = 1; i < sizeof(K::sin) / sizeof(T); ++i) {
+        ps = ps * r_sqr + K::sin[i];
+        pc = pc * r_sqr + K::cos[i];
+    }
+    const T sin_r = r + r * r_sqr * ps;
+    const T cos_r = T(1.) - T(.5) * r_sqr + r_sqr * r_sqr * pc;
+
+    // Quadrants 1 and 3 swap sine and cosine, 2 and 3 negate the sine, 1 and 2 the cosine. The swap blends the bits
+    // with a mask instead of comparing, SSE2 has no 64 bit integer comparison.
+    const Bits swap = Bits(0) - (quadrant & 1);
+    Bits sin_bits, cos_bits;
+    std::memcpy(&sin_bits, &sin_r, sizeof(T));
+    std::memcpy(&cos_bits, &cos_r, sizeof(T));
+    const Bits flip = (sin_bits ^ cos_bits) & swap;
+    sin_bits ^= flip ^ ((quadrant << (sizeof(T) * 8 - 2)) & sign);
+    cos_bits ^= flip ^ (((quadrant + 1) << (sizeof(T) * 8 - 2)) & sign);
+    std::memcpy(&s, &sin_bits, sizeof(T));
+    std::memcpy(&c, &cos_bits, sizeof(T));
+}
+
+/**
+ * @brief Select a where x < y and b elsewhere, with bit operations only.
+ *
+ * The bits of non-negative values are ordered like the values, so the sign of their difference is the comparison.
+ * GCC turns a comparison feeding a select back into a branch when one of the values is a constant, which keeps the
+ * loop from vectorizing.
+ * @tparam T The underlying data type.
+ * @param x The first value to compare, non-negative.
+ * @param y The second value to compare, non-negative.
+ * @param a The result if x < y.
+ * @param b The result otherwise.
+ * @return a or b.
+ */
+template <typename T>
+MATHLIB_ALWAYS_INLINE T selectLess(T x, T y, T a, T b) {
+    using Bits = typename KernelConstants<T>::Bits;
+    Bits x_bits, y_bits, a_bits, b_bits;
+    std::memcpy(&x_bits, &x, sizeof(T));
+    std::memcpy(&y_bits, &y, sizeof(T));
+    std::memcpy(&a_bits, &a, sizeof(T));
+    std::memcpy(&b_bits, &b, sizeof(T));
+    const Bits mask = Bits(0) - ((x_bits - y_bits) >> (sizeof(T) * 8 - 1));
+    const Bits ret_bits = (a_bits & mask) | (b_bits & ~mask);
+    T ret;
+    std::memcpy(&ret, &ret_bits, sizeof(T));
+    return ret;
+}
+
+/**
+ * @brief Compute acos(x) for x in [0, 1] without branches, so loops calling it vectorize.
+ *
+ * Evaluates the arcsine polynomial on [0, 1 / 2]: acos(x) = pi / 2 - asin(x) below 1 / 2 and 2 asin(sqrt((1 - x) / 2))
+ * above, which keeps the small angles of x near 1 accurate. Within a few ulp of std::acos. Values just above 1, from
+ * rounding, give a tiny angle.
+ * @tparam T The underlying data type.
+ * @param x The cosine, in [0, 1].
+ * @return The angle in radians, in [0, pi / 2].
+ */
+template <typename T>
+MATHLIB_ALWAYS_INLINE T acos(T x) {
+    using K = KernelConstants<T>;
+    const T half = std::fabs(T(.5) - T(.5) * x);
+    const T a = selectLess(T(.5), x, half * invSqrt(half), x);
+    const T a_sqr = a * a;
+    T p = K::asin[0];
+    for (std::size_t i = 1; i < sizeof(K::asin) / sizeof(T); ++i)
+        p = p * a_sqr + K::asin[i];
+    const T asin_a = a + a * a_sqr * p;
+    return selectLess(T(.5), x, T(2.) * asin_a, T(1.57079632679489661923) - asin_a);
+}
+
+/**
+ * @brief Below this sine of the angle between two quaternions slerp interpolates linearly.
+ */
+constexpr double slerp_threshold = 1e-3;
+
+/**
+ * @brief Compute the weights of the spherical linear interpolation without branches.
+ *
+ * The same weights as Quaternion::slerp() to a few ulp, with acos(), sincos() and invSqrt() instead of the
+ * library functions. The linear fallback for nearly parallel quaternions is selected with selectLess().
+ * @tparam T The underlying data type.
+ * @param d The dot-product of the two quaternions.
+ * @param t The weight of the second quaternion, in [0, 1].
+ * @param wa The weight of the first quaternion.
+ * @param wb The weight of the second quaternion, negative to interpolate along the shorter path.
+ */
+template <typename T>
+MATHLIB_ALWAYS_INLINE void slerpWeights(T d, T t, T& wa, T& wb) {
+    const T cos_theta = std::fabs(d);
+    const T sin_sqr = std::fabs(T(1.) - cos_theta * cos_theta);
+    const T inv_sin_theta = invSqrt(sin_sqr);
+    const T sin_theta = sin_sqr * inv_sin_theta;
+    const T theta = acos(cos_theta);
+    T sin_a, sin_b, unused;
+    sincos((T(1.) - t) * theta, sin_a, unused);
+    sincos(t * theta, sin_b, unused);
+    wa = selectLess(sin_theta, T(slerp_threshold), T(1.) - t, sin_a * inv_sin_theta);
+    wb = std::copysign(selectLess(sin_theta, T(slerp_threshold), t, sin_b * inv_sin_theta), d);
+}
+
+/**
+ * @brief Compute sin(|v|) / |v| and cos(|v|) of a vector v without branches.
+ *
+ * Needs no small-angle case: the sine polynomial returns |v| exactly to rounding for small angles and invSqrt() is
+ * accurate down to the smallest normal |v|^2, so the quotient stays within a few ulp of 1. For v = 0 invSqrt() is
+ * finite and the quotient is 0, which only ever multiplies the zero vector.
+ * @tparam T The underlying data type.
+ * @param v_sqr The squared norm of v.
+ * @param sinc sin(|v|) / |v|.
+ * @param c cos(|v|).
+ */
+template <typename T>
+MATHLIB_ALWAYS_INLINE void sincCos(T v_sqr, T& sinc, T& c) {
+    const T inv_theta = invSqrt(v_sqr);
+    T s;
+    sincos(v_sqr * inv_theta, s, c);
+    sinc = s * inv_theta;
+}
+
+/**
+ * @brief Compute the components of exp((hx, hy, hz, 0)) without branches.
+ * @tparam T The underlying data type.
+ * @param hx The x component of the vector part.
+ * @param hy The y component of the vector part.
+ * @param hz The z component of the vector part.
+ * @param x The x component of the exponential.
+ * @param y The y component of the exponential.
+ * @param z The z component of the exponential.
+ * @param w The w component of the exponential.
+ */
+template <typename T>
+MATHLIB_ALWAYS_INLINE void exp(T hx, T hy, T hz, T& x, T& y, T& z, T& w) {
+    T sinc;
+    sincCos(hx * hx + hy * hy + hz * hz, sinc, w);
+    x = sinc * hx;
+    y = sinc * hy;
+    z = sinc * hz;
+}
+
+/**
+ * @brief Replace q = (x, y, z, w) by the normalized Hamilton product d * q, without branches.
+ * @tparam T The underlying data type.
+ * @param dx The x component of d.
+ * @param dy The y component of d.
+ * @param dz The z component of d.
+ * @param dw The w component of d.
+ * @param x The x component of q, updated.
+ * @param y The y component of q, updated.
+ * @param z The z component of q, updated.
+ * @param w The w component of q, updated.
+ */
+template <typename T>
+MATHLIB_ALWAYS_INLINE void composeNormalized(T dx, T dy, T dz, T dw, T& x, T& y, T& z, T& w) {
+    const T rx = dw * x + dx * w + dy * z - dz * y;
+    const T ry = dw * y - dx * z + dy * w + dz * x;
+    const T rz = dw * z + dx * y - dy * x + dz * w;
+    const T rw = dw * w - dx * x - dy * y - dz * z;
+    const T inv_norm = invSqrt(rx * rx + ry * ry + rz * rz + rw * rw);
+    x = rx * inv_norm;
+    y = ry * inv_norm;
+    z = rz * inv_norm;
+    w = rw * inv_norm;
+}
+
+/**
+ * @brief Minimal number of orientations per thread in the batched integrations.
+ */
+constexpr std::size_t integration_grain = 1 << 14;
+
+/**
+ * @brief Number of orientations per block in the batched integrations.
+ */
+constexpr std::size_t integration_block = 64;
+
+/**
+ * @brief Advance the orientations [begin, end) by their angular velocities over a timestep.
+ *
+ * Works in blocks: the first loop writes the rotations exp(omega * dt / 2) of a block to local arrays, the second
+ * composes them with the orientations and renormalizes. A single loop reads and writes so many arrays that the
+ * compiler gives up on the runtime aliasing checks, the two short loops both vectorize.
+ * @tparam T The underlying data type.
+ * @tparam Omega Called as omega(i, ox, oy, oz) to read the angular velocity i.
+ * @tparam Compose Called as compose(i, dx, dy, dz, dw) to update the orientation i with composeNormalized().
+ * @param begin The first orientation.
+ * @param end One past the last orientation.
+ * @param half_dt Half the timestep.
+ * @param omega Reads the angular velocities.
+ * @param compose Updates the orientations.
+ */
+template <typename T, typename Omega, typename Compose>
+MATHLIB_ALWAYS_INLINE void integrate(std::size_t begin, std::size_t end, T half_dt, Omega&& omega, Compose&& compose) {
+    T dx[integration_block], dy[integration_block], dz[integration_block], dw[integration_block];
+    for (std::size_t first = begin; first < end; first += integration_block) {
+        const std::size_t n = std::min(integration_block, end - first);
+        for (std::size_t j = 0; j < n; ++j) {
+            T ox, oy, oz;
+            omega(first + j, ox, oy, oz);
+            exp(ox * half_dt, oy * half_dt, oz * half_dt, dx[j], dy[j], dz[j], dw[j]);
+        }
+        for (std::size_t j = 0; j < n; ++j)
+            compose(first + j, dx[j], dy[j], dz[j], dw[j]);
+    }
+}
+
+}  // namespace detail
+
+}  // namespace mathlib
 
 /**
  * @brief %Quaternion class
@@ -23,7 +350,13 @@ public:
      * @param z The z compontent.
      * @param w The w compontent.
      */
-    Quaternion(T x, T y, T z, T w) : Vector<4, T>({x, y, z, w}) {}
+    constexpr Quaternion(T x, T y, T z, T w) : Vector<4, T>(x, y, z, w) {}
+
+    /**
+     * @brief Create a quaternion from given values.
+     * @param xyzw The x, y, z and w components.
+     */
+    constexpr explicit Quaternion(const std::array<T, 4>& xyzw) : Vector<4, T>(xyzw) {}
 
     /**
      * @brief Create a quaternion from a given axis and angle.
@@ -38,13 +371,13 @@ public:
     /**
      * @brief Create a zero quaternion.
      */
-    Quaternion() = default;
+    constexpr Quaternion() = default;
 
     /**
      * @brief Create a quaternion from another quaternion
      * @param other The other quaternion.
      */
-    Quaternion(const Quaternion& other) : Vector<4, T>({other.x(), other.y(), other.z(), other.w()}) {}
+    constexpr Quaternion(const Quaternion& other) = default;
 
     /**
      * @brief Create a quaternion as a rotation from a to b.
@@ -58,16 +391,51 @@ public:
         this->normalize();
     }
 
+    /**
+     * @brief Create a quaternion from a rotation matrix.
+     * @param m The rotation matrix, must be orthonormal.
+     */
+    explicit Quaternion(const Matrix<3, 3, T>& m) {
+        const T trace = m(0, 0) + m(1, 1) + m(2, 2);
+        if (trace > T(0.)) {
+            const T s = T(2.) * std::sqrt(trace + T(1.));
+            *this = Quaternion((m(2, 1) - m(1, 2)) / s, (m(0, 2) - m(2, 0)) / s, (m(1, 0) - m(0, 1)) / s, T(0.25) * s);
+        } else if (m(0, 0) > m(1, 1) && m(0, 0) > m(2, 2)) {
+            const T s = T(2.) * std::sqrt(T(1.) + m(0, 0) - m(1, 1) - m(2, 2));
+            *this = Quaternion(T(0.25) * s, (m(0, 1) + m(1, 0)) / s, (m(0, 2) + m(2, 0)) / s, (m(2, 1) - m(1, 2)) / s);
+        } else if (m(1, 1) > m(2, 2)) {
+            const T s = T(2.) * std::sqrt(T(1.) + m(1, 1) - m(0, 0) - m(2, 2));
+            *this = Quaternion((m(0, 1) + m(1, 0)) / s, T(0.25) * s, (m(1, 2) + m(2, 1)) / s, (m(0, 2) - m(2, 0)) / s);
+        } else {
+            const T s = T(2.) * std::sqrt(T(1.) + m(2, 2) - m(0, 0) - m(1, 1));
+            *this = Quaternion((m(0, 2) + m(2, 0)) / s, (m(1, 2) + m(2, 1)) / s, T(0.25) * s, (m(1, 0) - m(0, 1)) / s);
+        }
+    }
+
     /**
      * @brief Default deconstructor
      */
     ~Quaternion() = default;
 
+    /**
+     * @brief Compute the exponential of the pure quaternion (v, 0).
+     *
+     * The result is the unit quaternion (sin|v| * v / |v|, cos|v|), a rotation by 2 |v| around v. Small angles,
+     * down to zero, need no special case.
+     * @param v The vector part.
+     * @return The exponential.
+     */
+    static Quaternion exp(const Vector3_t& v) {
+        Quaternion ret;
+        mathlib::detail::exp(v[0], v[1], v[2], ret[0], ret[1], ret[2], ret[3]);
+        return ret;
+    }
+
     /**
      * @brief Create an identity quaternion.
      * @return The identity quaternion.
      */
-    static Quaternion Identity() {
+    constexpr static Quaternion Identity() {
         return Quaternion(T(0.), T(0.), T(0.), T(1.));
     }
 
@@ -76,11 +444,7 @@ public:
      * @param other The other quaternion.
      * @return A reference to this.
      */
-    Quaternion& operator=(const Quaternion& other) {
-        w() = other.w();
-        setVec(other.vec());
-        return *this;
-    }
+    constexpr Quaternion& operator=(const Quaternion& other) = default;
 
     /**
      * @brief Compute multiplication of two quaternions.
@@ -89,7 +453,7 @@ public:
      * @param other The other quaternion
      * @return The new rotation (quaternion).
      */
-    Quaternion operator*(const Quaternion& other) const {
+    constexpr Quaternion operator*(const Quaternion& other) const {
         Quaternion ret;
 
         if (vec().squaredNorm() < std::numeric_limits<T>::epsilon()) {
@@ -98,8 +462,8 @@ public:
         if (other.vec().squaredNorm() < std::numeric_limits<T>::epsilon())
             return Quaternion(this->x(), this->y(), this->z(), this->w());
 
-        ret.setVec(vec().cross(other.vec()) + w() * other.vec() + other.w() * vec());
-        ret.w() = w() * other.w() - (vec().dot(other.vec()));
+        ret.vec() = vec().cross(other.vec()) + w() * other.vec() + other.w() * vec();
+        ret.w() = w() * other.w() - vec().dot(other.vec());
 
         return ret;
     }
@@ -109,31 +473,131 @@ public:
      * @param other The vector to rotate
      * @return The rotated vector.
      */
-    Vector3_t operator*(const Vector3_t& other) const {
+    constexpr Vector3_t operator*(const Vector3_t& other) const {
         return other + T(2.) * vec().cross(w() * other + vec().cross(other)) / ((*this).squaredNorm() + std::numeric_limits<T>::epsilon());
     }
 
+    /**
+     * @brief Rotate a vector with this, computed with a precision policy.
+     *
+     * With mathlib::FastMath the division by the squared norm uses an approximate reciprocal.
+     * @tparam Policy mathlib::ExactMath or mathlib::FastMath.
+     * @param other The vector to rotate.
+     * @return The rotated vector.
+     */
+    template <typename Policy, typename std::enable_if<mathlib::is_precision_policy<Policy>>::type* = nullptr>
+    Vector3_t rotate(const Vector3_t& other, Policy) const {
+        const T x = (*this)[0], y = (*this)[1], z = (*this)[2], w = (*this)[3];
+        const T k = T(2.) * mathlib::rcp(dot4(*this) + std::numeric_limits<T>::epsilon(), Policy());
+        // t = w * v + q x v, result = v + k * (q x t)
+        const T tx = w * other[0] + y * other[2] - z * other[1];
+        const T ty = w * other[1] + z * other[0] - x * other[2];
+        const T tz = w * other[2] + x * other[1] - y * other[0];
+        return Vector3_t(other[0] + k * (y * tz - z * ty), other[1] + k * (z * tx - x * tz), other[2] + k * (x * ty - y * tx));
+    }
+
+    /**
+     * @brief Compute the rotation matrix of this.
+     *
+     * Applying the matrix gives the same results as operator*(const Vector3_t&) up to rounding,
+     * including the division by the squared norm, but costs only a 3x3 matrix-vector product.
+     * @return The rotation matrix.
+     */
+    constexpr Matrix<3, 3, T> toRotationMatrix() const {
+        const T k = T(2.) / ((*this).squaredNorm() + std::numeric_limits<T>::epsilon());
+        const T x = (*this).x(), y = (*this).y(), z = (*this).z(), w = (*this).w();
+        return Matrix<3, 3, T>(T(1.) - k * (y * y + z * z), k * (x * y - w * z), k * (x * z + w * y),  //
+                               k * (x * y + w * z), T(1.) - k * (x * x + z * z), k * (y * z - w * x),  //
+                               k * (x * z - w * y), k * (y * z + w * x), T(1.) - k * (x * x + y * y));
+    }
+
+    /**
+     * @brief Rotate many vectors with this.
+     *
+     * The rotation matrix is computed once, every vector then costs a 3x3 matrix-vector product.
+     * The results are the same as from operator*(const Vector3_t&), up to rounding.
+     * @param in The vectors to rotate.
+     * @param out The rotated vectors, may be the same as in.
+     * @param count The number of vectors.
+     * @param threads The number of threads to use for large inputs, 0 for one per hardware thread.
+     */
+    void rotate(const Vector3_t* in, Vector3_t* out, std::size_t count, unsigned threads = 1) const {
+        const Matrix<3, 3, T> r = toRotationMatrix();
+        const T* m = r.data();
+        mathlib::parallelFor(count, threads, rotation_grain, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const T x = in[i][0], y = in[i][1], z = in[i][2];
+                out[i][0] = m[0] * x + m[1] * y + m[2] * z;
+                out[i][1] = m[3] * x + m[4] * y + m[5] * z;
+                out[i][2] = m[6] * x + m[7] * y + m[8] * z;
+            }
+        });
+    }
+
+    /**
+     * @brief Rotate many vectors with this, in place.
+     * @param points The vectors to rotate.
+     * @param threads The number of threads to use for large inputs, 0 for one per hardware thread.
+     */
+    void rotate(std::vector<Vector3_t>& points, unsigned threads = 1) const {
+        rotate(points.data(), points.data(), points.size(), threads);
+    }
+
+    /**
+     * @brief Rotate many vectors in a structure-of-arrays layout with this, in place.
+     *
+     * Streams the three component arrays, which the compiler vectorizes across vectors.
+     * @param points The vectors to rotate.
+     * @param threads The number of threads to use for large inputs, 0 for one per hardware thread.
+     */
+    void rotate(VectorArray<3, T>& points, unsigned threads = 1) const {
+        const Matrix<3, 3, T> r = toRotationMatrix();
+        const T* m = r.data();
+        T* px = points.data(0);
+        T* py = points.data(1);
+        T* pz = points.data(2);
+        mathlib::parallelFor(points.size(), threads, rotation_grain, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const T x = px[i], y = py[i], z = pz[i];
+                px[i] = m[0] * x + m[1] * y + m[2] * z;
+                py[i] = m[3] * x + m[4] * y + m[5] * z;
+                pz[i] = m[6] * x + m[7] * y + m[8] * z;
+            }
+        });
+    }
+
     /**
      * @brief Compute the inverse of this quaternion.
      * @return The inverse of this quaternion.
      */
-    Quaternion inverse() const {
+    constexpr Quaternion inverse() const {
         Quaternion ret;
 
         T inv_norm_s = T(1.) / ((*this).squaredNorm() + std::numeric_limits<T>::epsilon());
 
         ret.w() = w() * inv_norm_s;
 
-        ret.setVec(-vec() * inv_norm_s);
+        ret.vec() = -vec() * inv_norm_s;
 
         return ret;
     }
 
+    /**
+     * @brief Compute the inverse of this quaternion with a precision policy.
+     * @tparam Policy mathlib::ExactMath or mathlib::FastMath.
+     * @return The inverse of this quaternion.
+     */
+    template <typename Policy, typename std::enable_if<mathlib::is_precision_policy<Policy>>::type* = nullptr>
+    Quaternion inverse(Policy) const {
+        const T inv_norm_s = mathlib::rcp(dot4(*this) + std::numeric_limits<T>::epsilon(), Policy());
+        return Quaternion(-(*this)[0] * inv_norm_s, -(*this)[1] * inv_norm_s, -(*this)[2] * inv_norm_s, (*this)[3] * inv_norm_s);
+    }
+
     /**
      * @brief Read access to the w component.
      * @return The w component.
      */
-    T w() const {
+    constexpr T w() const {
         return (*this)[3];
     }
 
@@ -141,26 +605,42 @@ public:
      * @brief Write access to the w component.
      * @return The w component.
      */
-    T& w() {
+    constexpr T& w() {
         return (*this)[3];
     }
 
     /**
      * @brief Read access to the vector component.
-     * @return The vector component.
+     * @return A read-only view of the vector component.
+     */
+    constexpr VectorView<3, const T> vec() const& {
+        return this->template head<3>();
+    }
+
+    /**
+     * @brief Write access to the vector component.
+     * @return A writable view of the vector component.
+     */
+    constexpr VectorView<3, T> vec() & {
+        return this->template head<3>();
+    }
+
+    /**
+     * @brief Read access to the vector component of a temporary.
+     * @return A copy of the vector component.
      */
-    Vector3_t vec() const {
+    constexpr Vector3_t vec() && {
         return Vector3_t((*this).x(), (*this).y(), (*this).z());
     }
 
     /**
      * @brief Write access to the vector component.
+     * @tparam E The expression type.
      * @param vec The new vector component.
      */
-    void setVec(const Vector3_t& vec) {
-        (*this).x() = vec.x();
-        (*this).y() = vec.y();
-        (*this).z() = vec.z();
+    template <typename E>
+    constexpr void setVec(const VectorExpression<E, 3, T>& vec) {
+        this->vec() = vec;
     }
 
     /**
@@ -181,8 +661,278 @@ public:
             return Vector3_t(1., 0., 0.);
         return vec().normalized();
     }
+
+    /**
+     * @brief Compute the logarithm of this unit quaternion.
+     *
+     * The inverse of exp() for unit quaternions, i.e. angle() / 2 * axis(). The vector part of the logarithm,
+     * the scalar part log|q| is zero for unit quaternions.
+     * @return The vector part of the logarithm, half the rotation vector.
+     */
+    Vector3_t log() const {
+        const T n = std::sqrt((*this)[0] * (*this)[0] + (*this)[1] * (*this)[1] + (*this)[2] * (*this)[2]);
+        // atan2(n, w) / n tends to 1 / w, the vector part is zero where n is clamped.
+        const T k = std::atan2(n, w()) / std::max(n, std::numeric_limits<T>::min());
+        return Vector3_t(k * (*this)[0], k * (*this)[1], k * (*this)[2]);
+    }
+
+    /**
+     * @brief Advance this orientation by an angular velocity over a timestep.
+     *
+     * Computes exp(omega * dt / 2) * this, renormalized. The same as Quaternion(omega, |omega| * dt) * this for
+     * unit quaternions, up to rounding, but with a single sincos and no special cases.
+     * @param omega The angular velocity in the world frame, in radians per unit of time.
+     * @param dt The timestep.
+     * @return The new orientation.
+     */
+    Quaternion integrated(const Vector3_t& omega, T dt) const {
+        const T half_dt = T(.5) * dt;
+        Quaternion ret(*this);
+        T dx, dy, dz, dw;
+        mathlib::detail::exp(omega[0] * half_dt, omega[1] * half_dt, omega[2] * half_dt, dx, dy, dz, dw);
+        mathlib::detail::composeNormalized(dx, dy, dz, dw, ret[0], ret[1], ret[2], ret[3]);
+        return ret;
+    }
+
+    /**
+     * @brief Normalized linear interpolation between this and other.
+     *
+     * Interpolates along the shorter path, the sign of other is flipped without a branch if needed.
+     * Cheaper than slerp() but the angular velocity is not constant.
+     * @param other The other quaternion.
+     * @param t The weight of other, in [0, 1].
+     * @return The normalized interpolated quaternion.
+     */
+    Quaternion nlerp(const Quaternion& other, T t) const {
+        const T wb = std::copysign(t, dot4(other));
+        const T wa = T(1.) - t;
+        Quaternion ret(wa * (*this)[0] + wb * other[0], wa * (*this)[1] + wb * other[1],  //
+                       wa * (*this)[2] + wb * other[2], wa * (*this)[3] + wb * other[3]);
+        const T inv_norm = T(1.) / std::sqrt(ret.dot4(ret) + std::numeric_limits<T>::epsilon());
+        for (unsigned i = 0; i < 4; ++i)
+            ret[i] *= inv_norm;
+        return ret;
+    }
+
+    /**
+     * @brief Spherical linear interpolation between this and other.
+     *
+     * Interpolates along the shorter path, the sign of other is flipped without a branch if needed.
+     * Falls back to linear interpolation for nearly parallel quaternions.
+     * @param other The other quaternion.
+     * @param t The weight of other, in [0, 1].
+     * @return The interpolated quaternion, unit if both inputs are unit quaternions.
+     */
+    Quaternion slerp(const Quaternion& other, T t) const {
+        const T d = dot4(other);
+        const T cos_theta = std::min(std::fabs(d), T(1.));
+        const T sin_theta = std::sqrt(T(1.) - cos_theta * cos_theta);
+        const T theta = std::acos(cos_theta);
+        const T inv_sin_theta = T(1.) / std::max(sin_theta, std::numeric_limits<T>::epsilon());
+        const bool linear = sin_theta < T(mathlib::detail::slerp_threshold);
+        const T wa = linear ? T(1.) - t : std::sin((T(1.) - t) * theta) * inv_sin_theta;
+        const T wb = std::copysign(linear ? t : std::sin(t * theta) * inv_sin_theta, d);
+        return Quaternion(wa * (*this)[0] + wb * other[0], wa * (*this)[1] + wb * other[1],  //
+                          wa * (*this)[2] + wb * other[2], wa * (*this)[3] + wb * other[3]);
+    }
+
+    /**
+     * @brief Approximate spherical linear interpolation between this and other, without trigonometric functions.
+     *
+     * Evaluates the slerp weights with the polynomial of D. Eberly, "A Fast and Accurate Algorithm for Computing
+     * SLERP". For unit quaternions both weights differ from slerp() by at most 2e-5, i.e. every component of the
+     * result by at most 4e-5. Interpolates along the shorter path, without branches.
+     * @param other The other quaternion.
+     * @param t The weight of other, in [0, 1].
+     * @return The interpolated quaternion.
+     */
+    constexpr Quaternion fastSlerp(const Quaternion& other, T t) const {
+        const T d = dot4(other);
+        const T x_minus_one = (d < T(0.) ? -d : d) - T(1.);
+        const T t_sqr = t * t;
+        const T s = T(1.) - t;
+        const T s_sqr = s * s;
+
+        // Nested Horner scheme of sin(t * theta) / sin(theta) as polynomial in cos(theta) - 1.
+        constexpr T mu = T(1.85298109240830);
+        T wa = T(1.) + (mu / T(8. * 17.) * s_sqr - mu * T(8.) / T(17.)) * x_minus_one;
+        T wb = T(1.) + (mu / T(8. * 17.) * t_sqr - mu * T(8.) / T(17.)) * x_minus_one;
+        for (int i = 6; i >= 0; --i) {
+            const T u = T(1.) / T((i + 1) * (2 * i + 3));
+            const T v = T(i + 1) / T(2 * i + 3);
+            wa = T(1.) + (u * s_sqr - v) * x_minus_one * wa;
+            wb = T(1.) + (u * t_sqr - v) * x_minus_one * wb;
+        }
+        wa *= s;
+        wb *= d < T(0.) ? -t : t;
+        return Quaternion(wa * (*this)[0] + wb * other[0], wa * (*this)[1] + wb * other[1],  //
+                          wa * (*this)[2] + wb * other[2], wa * (*this)[3] + wb * other[3]);
+    }
+
+private:
+    /**
+     * @brief Unrolled dot-product of two quaternions.
+     *
+     * Used by the interpolations instead of Vector::dot so loops over many quaternions vectorize.
+     * @param other The other quaternion.
+     * @return The dot-product.
+     */
+    constexpr T dot4(const Quaternion& other) const {
+        return (*this)[0] * other[0] + (*this)[1] * other[1] + (*this)[2] * other[2] + (*this)[3] * other[3];
+    }
+
+    /**
+     * @brief Minimal number of vectors per thread in the bulk rotations.
+     */
+    constexpr static std::size_t rotation_grain = 1 << 15;
 };
 
+namespace mathlib {
+
+namespace detail {
+
+/**
+ * @brief Minimal number of quaternion pairs per thread in the batched interpolations.
+ */
+constexpr std::size_t interpolation_grain = 1 << 14;
+
+/**
+ * @brief Interpolate many quaternion pairs.
+ * @tparam T The underlying data type.
+ * @tparam F The interpolation type, called as f(a, b, t).
+ * @param a The first quaternions.
+ * @param b The second quaternions.
+ * @param t The weights of b.
+ * @param out The interpolated quaternions, may be the same as a or b.
+ * @param count The number of quaternion pairs.
+ * @param threads The number of threads to use for large inputs, 0 for one per hardware thread.
+ * @param f The interpolation.
+ */
+template <typename T, typename F>
+void interpolate(const Quaternion<T>* a, const Quaternion<T>* b, const T* t, Quaternion<T>* out, std::size_t count, unsigned threads, F&& f) {
+    parallelFor(count, threads, interpolation_grain, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+            out[i] = f(a[i], b[i], t[i]);
+    });
+}
+
+/**
+ * @brief Unrolled dot-product of two quaternions, for the batched interpolations.
+ * @tparam T The underlying data type.
+ * @param a The first quaternion.
+ * @param b The second quaternion.
+ * @return The dot-product.
+ */
+template <typename T>
+MATHLIB_ALWAYS_INLINE T dot4(const Quaternion<T>& a, const Quaternion<T>& b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+}
+
+/**
+ * @brief Weighted sum of two quaternions, for the batched interpolations.
+ * @tparam T The underlying data type.
+ * @param a The first quaternion.
+ * @param b The second quaternion.
+ * @param wa The weight of a.
+ * @param wb The weight of b.
+ * @return wa * a + wb * b.
+ */
+template <typename T>
+MATHLIB_ALWAYS_INLINE Quaternion<T> weighted(const Quaternion<T>& a, const Quaternion<T>& b, T wa, T wb) {
+    return Quaternion<T>(wa * a[0] + wb * b[0], wa * a[1] + wb * b[1], wa * a[2] + wb * b[2], wa * a[3] + wb * b[3]);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Advance many orientations by their angular velocities over a timestep, see Quaternion::integrated().
+ *
+ * Free of branches, with a vectorized sincos and the renormalization fused into the composition.
+ * @tparam T The underlying data type.
+ * @param q The orientations, updated in place.
+ * @param omega The angular velocities in the world frame.
+ * @param dt The timestep.
+ * @param count The number of orientations.
+ * @param threads The number of threads to use for large inputs, 0 for one per hardware thread.
+ */
+template <typename T>
+void integrate(Quaternion<T>* q, const Vector<3, T>* omega, T dt, std::size_t count, unsigned threads = 1) {
+    parallelFor(count, threads, detail::integration_grain, [&](std::size_t begin, std::size_t end) {
+        detail::integrate(
+            begin, end, T(.5) * dt,
+            [omega](std::size_t i, T& ox, T& oy, T& oz) MATHLIB_INLINE_LAMBDA {
+                ox = omega[i][0];
+                oy = omega[i][1];
+                oz = omega[i][2];
+            },
+            [q](std::size_t i, T dx, T dy, T dz, T dw) MATHLIB_INLINE_LAMBDA {
+                detail::composeNormalized(dx, dy, dz, dw, q[i][0], q[i][1], q[i][2], q[i][3]);
+            });
+    });
+}
+
+/**
+ * @brief Normalized linear interpolation of many quaternion pairs, see Quaternion::nlerp().
+ *
+ * Normalizes with invSqrt() instead of std::sqrt, so the compiler vectorizes it.
+ * @tparam T The underlying data type.
+ * @param a The first quaternions.
+ * @param b The second quaternions.
+ * @param t The weights of b.
+ * @param out The interpolated quaternions, may be the same as a or b.
+ * @param count The number of quaternion pairs.
+ * @param threads The number of threads to use for large inputs, 0 for one per hardware thread.
+ */
+template <typename T>
+void nlerp(const Quaternion<T>* a, const Quaternion<T>* b, const T* t, Quaternion<T>* out, std::size_t count, unsigned threads = 1) {
+    detail::interpolate(a, b, t, out, count, threads, [](const Quaternion<T>& qa, const Quaternion<T>& qb, T w) MATHLIB_INLINE_LAMBDA {
+        Quaternion<T> ret = detail::weighted(qa, qb, T(1.) - w, std::copysign(w, detail::dot4(qa, qb)));
+        const T inv_norm = detail::invSqrt(detail::dot4(ret, ret) + std::numeric_limits<T>::epsilon());
+        return Quaternion<T>(ret[0] * inv_norm, ret[1] * inv_norm, ret[2] * inv_norm, ret[3] * inv_norm);
+    });
+}
+
+/**
+ * @brief Spherical linear interpolation of many quaternion pairs, see Quaternion::slerp().
+ *
+ * Free of branches, with the vectorized acos() and sincos() instead of the library functions. Within a few ulp of
+ * Quaternion::slerp().
+ * @tparam T The underlying data type.
+ * @param a The first quaternions.
+ * @param b The second quaternions.
+ * @param t The weights of b.
+ * @param out The interpolated quaternions, may be the same as a or b.
+ * @param count The number of quaternion pairs.
+ * @param threads The number of threads to use for large inputs, 0 for one per hardware thread.
+ */
+template <typename T>
+void slerp(const Quaternion<T>* a, const Quaternion<T>* b, const T* t, Quaternion<T>* out, std::size_t count, unsigned threads = 1) {
+    detail::interpolate(a, b, t, out, count, threads, [](const Quaternion<T>& qa, const Quaternion<T>& qb, T w) MATHLIB_INLINE_LAMBDA {
+        T wa, wb;
+        detail::slerpWeights(detail::dot4(qa, qb), w, wa, wb);
+        return detail::weighted(qa, qb, wa, wb);
+    });
+}
+
+/**
+ * @brief Approximate spherical linear interpolation of many quaternion pairs, see Quaternion::fastSlerp().
+ *
+ * Free of trigonometric functions and branches, so the compiler vectorizes it.
+ * @tparam T The underlying data type.
+ * @param a The first quaternions.
+ * @param b The second quaternions.
+ * @param t The weights of b.
+ * @param out The interpolated quaternions, may be the same as a or b.
+ * @param count The number of quaternion pairs.
+ * @param threads The number of threads to use for large inputs, 0 for one per hardware thread.
+ */
+template <typename T>
+void fastSlerp(const Quaternion<T>* a, const Quaternion<T>* b, const T* t, Quaternion<T>* out, std::size_t count, unsigned threads = 1) {
+    detail::interpolate(a, b, t, out, count, threads, [](const Quaternion<T>& qa, const Quaternion<T>& qb, T w) { return qa.fastSlerp(qb, w); });
+}
+
+}  // namespace mathlib
+
 /**
  * @name Defines
  * @brief Underlying data type definitions.
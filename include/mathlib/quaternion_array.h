@@ -0,0 +1,254 @@
+#ifndef __MATHLIB_QUATERNION_ARRAY_H__
+#define __MATHLIB_QUATERNION_ARRAY_H__
+
+#include <mathlib/parallel.h>
+#include <mathlib/quaternion.h>
+#include <mathlib/vector_array.h>
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief Array of quaternions in a structure-of-arrays layout.
+ *
+ * The components x, y, z and w are stored in data(0) to data(3). The kernels have no data-dependent branches,
+ * so the compiler vectorizes them across quaternions.
+ * @tparam T The underlying data type.
+ * @attention Also supports all other functions of a VectorArray<4, T>, but use with caution!
+ */
+template <typename T>
+class QuaternionArray : public VectorArray<4, T> {
+public:
+    using Quaternion_t = Quaternion<T>;  ///< The element type.
+    using Vector3_t = Vector<3, T>;      ///< Helper for the vector part.
+
+    using VectorArray<4, T>::operator*=;
+
+    /**
+     * @brief Create an empty array.
+     */
+    QuaternionArray() = default;
+
+    /**
+     * @brief Create an array of count copies of value.
+     * @param count The number of quaternions.
+     * @param value The value of all quaternions.
+     */
+    explicit QuaternionArray(std::size_t count, const Quaternion_t &value = Quaternion_t::Identity()) : VectorArray<4, T>(count, value) {}
+
+    /**
+     * @brief Create an array from contiguous quaternions.
+     * @param data The quaternions.
+     * @param count The number of quaternions.
+     */
+    QuaternionArray(const Quaternion_t *data, std::size_t count) {
+        this->resize(count);
+        for (std::size_t i = 0; i < count; ++i)
+            this->set(i, data[i]);
+    }
+
+    /**
+     * @brief Create an array from given quaternions.
+     * @param data The quaternions.
+     */
+    QuaternionArray(const std::vector<Quaternion_t> &data) : QuaternionArray(data.data(), data.size()) {}
+
+    /**
+     * @brief Get a quaternion.
+     * @param idx The index (0-indexed).
+     * @return A copy of the quaternion at idx.
+     */
+    Quaternion_t quaternion(std::size_t idx) const {
+        return Quaternion_t(this->data(0)[idx], this->data(1)[idx], this->data(2)[idx], this->data(3)[idx]);
+    }
+
+    /**
+     * @brief Copy all quaternions to a std::vector.
+     * @return The quaternions.
+     */
+    std::vector<Quaternion_t> toQuaternions() const {
+        std::vector<Quaternion_t> ret(this->size());
+        for (std::size_t i = 0; i < ret.size(); ++i)
+            ret[i] = quaternion(i);
+        return ret;
+    }
+
+    /**
+     * @brief Compose with other, element by element.
+     *
+     * Computes the Hamilton product this[i] * other[i], which is the same as Quaternion::operator* for unit
+     * quaternions, but without the special cases.
+     * @param other The other array, same size as this.
+     * @return The composed rotations.
+     */
+    QuaternionArray operator*(const QuaternionArray &other) const {
+        QuaternionArray ret(*this);
+        ret *= other;
+        return ret;
+    }
+
+    /**
+     * @brief Compose this with other, element by element.
+     * @param other The other array, same size as this. May be this.
+     * @return A reference to this array, with this[i] * other[i].
+     */
+    QuaternionArray &operator*=(const QuaternionArray &other) {
+        assert(other.size() == this->size());
+        const std::size_t n = this->size();
+        T *ax = this->data(0), *ay = this->data(1), *az = this->data(2), *aw = this->data(3);
+        const T *bx = other.data(0), *by = other.data(1), *bz = other.data(2), *bw = other.data(3);
+        for (std::size_t i = 0; i < n; ++i) {
+            const T x = ax[i], y = ay[i], z = az[i], w = aw[i];
+            const T ox = bx[i], oy = by[i], oz = bz[i], ow = bw[i];
+            ax[i] = w * ox + x * ow + y * oz - z * oy;
+            ay[i] = w * oy - x * oz + y * ow + z * ox;
+            az[i] = w * oz + x * oy - y * ox + z * ow;
+            aw[i] = w * ow - x * ox - y * oy - z * oz;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Conjugate all quaternions, i.e. negate the vector parts.
+     */
+    void conjugate() {
+        for (unsigned c = 0; c < 3; ++c) {
+            T *a = this->data(c);
+            for (std::size_t i = 0; i < this->size(); ++i)
+                a[i] = -a[i];
+        }
+    }
+
+    /**
+     * @brief Return a conjugated copy of this.
+     * @return The conjugated copy.
+     */
+    QuaternionArray conjugated() const {
+        QuaternionArray ret(*this);
+        ret.conjugate();
+        return ret;
+    }
+
+    /**
+     * @brief Invert all quaternions.
+     *
+     * Uses the same safe norm as Quaternion::inverse.
+     */
+    void invert() {
+        const std::size_t n = this->size();
+        T *x = this->data(0), *y = this->data(1), *z = this->data(2), *w = this->data(3);
+        for (std::size_t i = 0; i < n; ++i) {
+            const T inv_norm_s = T(1.) / (x[i] * x[i] + y[i] * y[i] + z[i] * z[i] + w[i] * w[i] + std::numeric_limits<T>::epsilon());
+            x[i] *= -inv_norm_s;
+            y[i] *= -inv_norm_s;
+            z[i] *= -inv_norm_s;
+            w[i] *= inv_norm_s;
+        }
+    }
+
+    /**
+     * @brief Compute the inverses of all quaternions.
+     * @return The inverses.
+     */
+    QuaternionArray inverse() const {
+        QuaternionArray ret(*this);
+        ret.invert();
+        return ret;
+    }
+
+    /**
+     * @brief Return a normalized copy of this.
+     * @return The normalized copy.
+     */
+    QuaternionArray normalized() const {
+        QuaternionArray ret(*this);
+        ret.normalize();
+        return ret;
+    }
+
+    /**
+     * @brief Rotate vectors, each with its own quaternion.
+     *
+     * The results are the same as from Quaternion::operator*(const Vector3_t&), up to rounding.
+     * @param in The vectors to rotate, same size as this.
+     * @param out The rotated vectors, resized to size(). May be in.
+     * @param threads The number of threads to use for large inputs, 0 for one per hardware thread.
+     */
+    void rotate(const VectorArray<3, T> &in, VectorArray<3, T> &out, unsigned threads = 1) const {
+        assert(in.size() == this->size());
+        out.resize(this->size());
+        const T *qx = this->data(0), *qy = this->data(1), *qz = this->data(2), *qw = this->data(3);
+        const T *vx = in.data(0), *vy = in.data(1), *vz = in.data(2);
+        T *rx = out.data(0), *ry = out.data(1), *rz = out.data(2);
+        mathlib::parallelFor(this->size(), threads, rotation_grain, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const T x = qx[i], y = qy[i], z = qz[i], w = qw[i];
+                const T k = T(2.) / (x * x + y * y + z * z + w * w + std::numeric_limits<T>::epsilon());
+                const T px = vx[i], py = vy[i], pz = vz[i];
+                // t = w * v + q x v, result = v + k * (q x t)
+                const T tx = w * px + y * pz - z * py;
+                const T ty = w * py + z * px - x * pz;
+                const T tz = w * pz + x * py - y * px;
+                rx[i] = px + k * (y * tz - z * ty);
+                ry[i] = py + k * (z * tx - x * tz);
+                rz[i] = pz + k * (x * ty - y * tx);
+            }
+        });
+    }
+
+    /**
+     * @brief Rotate vectors in place, each with its own quaternion.
+     * @param points The vectors to rotate, same size as this.
+     * @param threads The number of threads to use for large inputs, 0 for one per hardware thread.
+     */
+    void rotate(VectorArray<3, T> &points, unsigned threads = 1) const {
+        rotate(points, points, threads);
+    }
+
+    /**
+     * @brief Advance all orientations by their angular velocities over a timestep, see Quaternion::integrated().
+     *
+     * Streams the seven component arrays without branches, with a vectorized sincos and the renormalization fused
+     * into the composition.
+     * @param omega The angular velocities in the world frame, same size as this.
+     * @param dt The timestep.
+     * @param threads The number of threads to use for large inputs, 0 for one per hardware thread.
+     */
+    void integrate(const VectorArray<3, T> &omega, T dt, unsigned threads = 1) {
+        assert(omega.size() == this->size());
+        T *qx = this->data(0), *qy = this->data(1), *qz = this->data(2), *qw = this->data(3);
+        const T *ox = omega.data(0), *oy = omega.data(1), *oz = omega.data(2);
+        mathlib::parallelFor(this->size(), threads, mathlib::detail::integration_grain, [&](std::size_t begin, std::size_t end) {
+            mathlib::detail::integrate(
+                begin, end, T(.5) * dt,
+                [=](std::size_t i, T &x, T &y, T &z) MATHLIB_INLINE_LAMBDA {
+                    x = ox[i];
+                    y = oy[i];
+                    z = oz[i];
+                },
+                [=](std::size_t i, T dx, T dy, T dz, T dw) MATHLIB_INLINE_LAMBDA {
+                    mathlib::detail::composeNormalized(dx, dy, dz, dw, qx[i], qy[i], qz[i], qw[i]);
+                });
+        });
+    }
+
+private:
+    /**
+     * @brief Minimal number of vectors per thread in the bulk rotations.
+     */
+    constexpr static std::size_t rotation_grain = 1 << 15;
+};
+
+/**
+ * @name Defines
+ * @brief Underlying data type definitions.
+ */
+/** @{ */
+using QuaternionArrayf = QuaternionArray<float>;
+using QuaternionArrayd = QuaternionArray<double>;
+/** @} */
+
+#endif /* __MATHLIB_QUATERNION_ARRAY_H__ */
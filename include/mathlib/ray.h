@@ -0,0 +1,508 @@
+#ifndef __MATHLIB_RAY_H__
+#define __MATHLIB_RAY_H__
+
+#include <mathlib/operators.h>
+#include <mathlib/vector.h>
+
+#include <cstdint>
+#include <limits>
+
+/**
+ * @brief A ray with a valid interval [t_min, t_max] along its direction.
+ * @tparam T The underlying data type.
+ */
+template <typename T>
+struct Ray {
+    using type = T;                 ///< The underlying data type.
+    using Vector_t = Vector<3, T>;  ///< The vector type.
+
+    /**
+     * @brief Create a ray along the x-axis.
+     */
+    constexpr Ray() : direction(T(1), T(0), T(0)) {}
+
+    /**
+     * @brief Create a ray.
+     * @param o The origin.
+     * @param d The direction, does not need to be normalized.
+     * @param t_near The start of the valid interval.
+     * @param t_far The end of the valid interval.
+     */
+    constexpr Ray(const Vector_t &o, const Vector_t &d, T t_near = T(0), T t_far = std::numeric_limits<T>::max())
+        : origin(o), direction(d), t_min(t_near), t_max(t_far) {}
+
+    /**
+     * @brief The point at a distance along the ray.
+     * @param t The distance in multiples of direction.
+     * @return The point origin + t * direction.
+     */
+    constexpr Vector_t at(T t) const {
+        return origin + direction * t;
+    }
+
+    Vector_t origin;                             ///< The origin.
+    Vector_t direction;                          ///< The direction.
+    T t_min = T(0);                              ///< The start of the valid interval.
+    T t_max = std::numeric_limits<T>::max();     ///< The end of the valid interval.
+};
+
+/**
+ * @brief An axis aligned bounding box.
+ * @tparam T The underlying data type.
+ */
+template <typename T>
+struct Aabb {
+    using type = T;                 ///< The underlying data type.
+    using Vector_t = Vector<3, T>;  ///< The vector type.
+
+    /**
+     * @brief Create an empty box, extending it by a point yields the point.
+     */
+    constexpr Aabb() : lo(std::numeric_limits<T>::max()), hi(std::numeric_limits<T>::lowest()) {}
+
+    /**
+     * @brief Create a box from its corners.
+     * @param l The lower corner.
+     * @param h The upper corner.
+     */
+    constexpr Aabb(const Vector_t &l, const Vector_t &h) : lo(l), hi(h) {}
+
+    /**
+     * @brief Check if the box is empty.
+     * @return True if lo > hi in any dimension.
+     */
+    constexpr bool empty() const {
+        return lo[0] > hi[0] || lo[1] > hi[1] || lo[2] > hi[2];
+    }
+
+    /**
+     * @brief Grow the box to contain a point.
+     * @param p The point.
+     */
+    constexpr void extend(const Vector_t &p) {
+        for (unsigned c = 0; c < 3; ++c) {
+            lo[c] = p[c] < lo[c] ? p[c] : lo[c];
+            hi[c] = p[c] > hi[c] ? p[c] : hi[c];
+        }
+    }
+
+    /**
+     * @brief Grow the box to contain another box.
+     * @param other The other box.
+     */
+    constexpr void extend(const Aabb &other) {
+        for (unsigned c = 0; c < 3; ++c) {
+            lo[c] = other.lo[c] < lo[c] ? other.lo[c] : lo[c];
+            hi[c] = other.hi[c] > hi[c] ? other.hi[c] : hi[c];
+        }
+    }
+
+    /**
+     * @brief The center of the box.
+     * @return The center.
+     */
+    constexpr Vector_t center() const {
+        return (lo + hi) * T(0.5);
+    }
+
+    /**
+     * @brief The surface area of the box.
+     * @return The surface area, 0 for an empty box.
+     */
+    constexpr T surfaceArea() const {
+        if (empty())
+            return T(0);
+        const T x = hi[0] - lo[0], y = hi[1] - lo[1], z = hi[2] - lo[2];
+        return T(2) * (x * y + y * z + z * x);
+    }
+
+    Vector_t lo;  ///< The lower corner.
+    Vector_t hi;  ///< The upper corner.
+};
+
+/**
+ * @brief A triangle given by its corners.
+ * @tparam T The underlying data type.
+ */
+template <typename T>
+struct Triangle {
+    using type = T;                 ///< The underlying data type.
+    using Vector_t = Vector<3, T>;  ///< The vector type.
+
+    /**
+     * @brief The bounding box of the triangle.
+     * @return The bounding box.
+     */
+    constexpr Aabb<T> bounds() const {
+        Aabb<T> ret(v0, v0);
+        ret.extend(v1);
+        ret.extend(v2);
+        return ret;
+    }
+
+    Vector_t v0;  ///< The first corner.
+    Vector_t v1;  ///< The second corner.
+    Vector_t v2;  ///< The third corner.
+};
+
+/**
+ * @brief The result of a ray/triangle intersection.
+ *
+ * The hit point is (1 - u - v) * v0 + u * v1 + v * v2, or ray.at(t).
+ * @tparam T The underlying data type.
+ */
+template <typename T>
+struct RayHit {
+    /**
+     * @brief Index of a missing triangle.
+     */
+    constexpr static std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+    /**
+     * @brief Check if a triangle was hit.
+     * @return True if index is valid.
+     */
+    constexpr bool valid() const {
+        return index != npos;
+    }
+
+    T t = std::numeric_limits<T>::max();  ///< The distance along the ray.
+    T u = T(0);                           ///< The first barycentric coordinate.
+    T v = T(0);                           ///< The second barycentric coordinate.
+    std::uint32_t index = npos;           ///< The index of the triangle.
+};
+
+/**
+ * @brief W rays in structure of arrays layout.
+ *
+ * Lanes which were not set are inactive, they never hit anything.
+ * @tparam W The number of rays, at most 32.
+ * @tparam T The underlying data type.
+ */
+template <unsigned W, typename T>
+struct alignas(sizeof(T) * W < 64 ? sizeof(T) * W : 64) RayPacket {
+    static_assert(W >= 1 && W <= 32, "packets hold 1 to 32 rays.");
+    using type = T;                 ///< The underlying data type.
+    constexpr static unsigned width = W;  ///< The number of rays.
+
+    /**
+     * @brief Create a packet with all lanes inactive.
+     */
+    RayPacket() {
+        for (unsigned i = 0; i < W; ++i)
+            clear(i);
+    }
+
+    /**
+     * @brief Create a packet from consecutive rays.
+     * @param rays The rays.
+     * @param count The number of rays, lanes from count on are inactive.
+     */
+    RayPacket(const Ray<T> *rays, unsigned count) : RayPacket() {
+        for (unsigned i = 0; i < count && i < W; ++i)
+            set(i, rays[i]);
+    }
+
+    /**
+     * @brief Store a ray in a lane.
+     * @param lane The lane.
+     * @param ray The ray.
+     */
+    constexpr void set(unsigned lane, const Ray<T> &ray) {
+        for (unsigned c = 0; c < 3; ++c) {
+            origin[c][lane] = ray.origin[c];
+            direction[c][lane] = ray.direction[c];
+            inv_direction[c][lane] = T(1) / ray.direction[c];
+        }
+        t_min[lane] = ray.t_min;
+        t_max[lane] = ray.t_max;
+    }
+
+    /**
+     * @brief Make a lane inactive.
+     * @param lane The lane.
+     */
+    constexpr void clear(unsigned lane) {
+        for (unsigned c = 0; c < 3; ++c) {
+            origin[c][lane] = T(0);
+            direction[c][lane] = T(1);
+            inv_direction[c][lane] = T(1);
+        }
+        t_min[lane] = T(1);
+        t_max[lane] = T(-1);
+    }
+
+    /**
+     * @brief Read the ray of a lane.
+     * @param lane The lane.
+     * @return The ray.
+     */
+    constexpr Ray<T> ray(unsigned lane) const {
+        return Ray<T>(Vector<3, T>(origin[0][lane], origin[1][lane], origin[2][lane]),
+                      Vector<3, T>(direction[0][lane], direction[1][lane], direction[2][lane]), t_min[lane], t_max[lane]);
+    }
+
+    T origin[3][W];         ///< The origins, one row per dimension.
+    T direction[3][W];      ///< The directions, one row per dimension.
+    T inv_direction[3][W];  ///< The reciprocal directions, one row per dimension.
+    T t_min[W];             ///< The starts of the valid intervals.
+    T t_max[W];             ///< The ends of the valid intervals, lowered to the closest hit by the triangle tests.
+};
+
+/**
+ * @brief The results of intersecting a RayPacket, one RayHit per lane in structure of arrays layout.
+ * @tparam W The number of rays.
+ * @tparam T The underlying data type.
+ */
+template <unsigned W, typename T>
+struct alignas(sizeof(T) * W < 64 ? sizeof(T) * W : 64) HitPacket {
+    /**
+     * @brief Create a packet without hits.
+     */
+    HitPacket() {
+        for (unsigned i = 0; i < W; ++i) {
+            t[i] = std::numeric_limits<T>::max();
+            u[i] = v[i] = T(0);
+            index[i] = RayHit<T>::npos;
+        }
+    }
+
+    /**
+     * @brief Read the hit of a lane.
+     * @param lane The lane.
+     * @return The hit.
+     */
+    constexpr RayHit<T> hit(unsigned lane) const {
+        RayHit<T> ret;
+        ret.t = t[lane];
+        ret.u = u[lane];
+        ret.v = v[lane];
+        ret.index = index[lane];
+        return ret;
+    }
+
+    T t[W];                   ///< The distances along the rays.
+    T u[W];                   ///< The first barycentric coordinates.
+    T v[W];                   ///< The second barycentric coordinates.
+    std::uint32_t index[W];   ///< The indices of the triangles, RayHit::npos for misses.
+};
+
+namespace mathlib {
+
+/**
+ * @brief Slab test of a ray against a box.
+ *
+ * Zero direction components are handled by their infinite reciprocal, a ray in the plane of a slab counts as
+ * outside of that slab.
+ * @tparam T The underlying data type.
+ * @param ray The ray.
+ * @param inv_direction The reciprocal of ray.direction, shared by all tests of the ray.
+ * @param box The box.
+ * @param t_entry Set to the distance at which the ray enters the box, clamped to ray.t_min.
+ * @return True if the ray hits the box within [t_min, t_max].
+ */
+template <typename T>
+MATHLIB_ALWAYS_INLINE constexpr bool intersect(const Ray<T> &ray, const Vector<3, T> &inv_direction, const Aabb<T> &box, T &t_entry) {
+    T t0 = ray.t_min, t1 = ray.t_max;
+    for (unsigned c = 0; c < 3; ++c) {
+        const T a = (box.lo[c] - ray.origin[c]) * inv_direction[c];
+        const T b = (box.hi[c] - ray.origin[c]) * inv_direction[c];
+        const T t_near = a < b ? a : b, t_far = a < b ? b : a;
+        t0 = t_near > t0 ? t_near : t0;
+        t1 = t_far < t1 ? t_far : t1;
+    }
+    t_entry = t0;
+    return t0 <= t1;
+}
+
+/**
+ * @brief Slab test of a ray against a box.
+ * @tparam T The underlying data type.
+ * @param ray The ray.
+ * @param box The box.
+ * @param t_entry Set to the distance at which the ray enters the box, clamped to ray.t_min.
+ * @return True if the ray hits the box within [t_min, t_max].
+ */
+template <typename T>
+constexpr bool intersect(const Ray<T> &ray, const Aabb<T> &box, T &t_entry) {
+    const Vector<3, T> inv(T(1) / ray.direction[0], T(1) / ray.direction[1], T(1) / ray.direction[2]);
+    return intersect(ray, inv, box, t_entry);
+}
+
+namespace detail {
+
+/**
+ * @brief Möller–Trumbore test of a ray against a triangle given by a corner and the two edges leaving it.
+ * @tparam T The underlying data type.
+ * @param ray The ray.
+ * @param v0 The first corner.
+ * @param e1 The edge v1 - v0.
+ * @param e2 The edge v2 - v0.
+ * @param hit Receives t, u and v on a hit, unchanged otherwise.
+ * @return True if the ray hits the triangle within [t_min, t_max].
+ */
+template <typename T>
+MATHLIB_ALWAYS_INLINE constexpr bool intersectTriangle(const Ray<T> &ray, const Vector<3, T> &v0, const Vector<3, T> &e1, const Vector<3, T> &e2,
+                                                       RayHit<T> &hit) {
+    const Vector<3, T> p = ray.direction.cross(e2);
+    const T det = e1.dot(p);
+    // Parallel rays give det == 0, the infinite or NaN coordinates below then fail the comparisons.
+    const T inv_det = T(1) / det;
+    const Vector<3, T> s = ray.origin - v0;
+    const T u = s.dot(p) * inv_det;
+    const Vector<3, T> q = s.cross(e1);
+    const T v = ray.direction.dot(q) * inv_det;
+    const T t = e2.dot(q) * inv_det;
+    if (!(det != T(0) && u >= T(0) && v >= T(0) && u + v <= T(1) && t >= ray.t_min && t <= ray.t_max))
+        return false;
+    hit.t = t;
+    hit.u = u;
+    hit.v = v;
+    return true;
+}
+
+/**
+ * @brief Möller–Trumbore test of a packet against a triangle given by a corner and the two edges leaving it.
+ * @tparam W The number of rays.
+ * @tparam T The underlying data type.
+ * @param rays The rays, t_max is lowered to t in every lane which hits.
+ * @param v0 The first corner.
+ * @param e1 The edge v1 - v0.
+ * @param e2 The edge v2 - v0.
+ * @param index The index stored in hits.
+ * @param hits Receives the hits.
+ * @return The mask of the lanes which hit.
+ */
+template <unsigned W, typename T>
+MATHLIB_ALWAYS_INLINE std::uint32_t intersectTriangle(RayPacket<W, T> &rays, const Vector<3, T> &v0, const Vector<3, T> &e1,
+                                                             const Vector<3, T> &e2, std::uint32_t index, HitPacket<W, T> &hits) {
+    const T v0x = v0[0], v0y = v0[1], v0z = v0[2];
+    const T e1x = e1[0], e1y = e1[1], e1z = e1[2];
+    const T e2x = e2[0], e2y = e2[1], e2z = e2[2];
+    // The arithmetic is kept free of conditional stores so the loop is vectorized, the rare hits are written after.
+    T t[W], u[W], v[W], hit[W];
+    MATHLIB_NO_UNROLL
+    for (unsigned i = 0; i < W; ++i) {
+        const T dx = rays.direction[0][i], dy = rays.direction[1][i], dz = rays.direction[2][i];
+        const T px = dy * e2z - dz * e2y, py = dz * e2x - dx * e2z, pz = dx * e2y - dy * e2x;
+        const T det = e1x * px + e1y * py + e1z * pz;
+        const T inv_det = T(1) / det;
+        const T sx = rays.origin[0][i] - v0x, sy = rays.origin[1][i] - v0y, sz = rays.origin[2][i] - v0z;
+        const T qx = sy * e1z - sz * e1y, qy = sz * e1x - sx * e1z, qz = sx * e1y - sy * e1x;
+        u[i] = (sx * px + sy * py + sz * pz) * inv_det;
+        v[i] = (dx * qx + dy * qy + dz * qz) * inv_det;
+        t[i] = (e2x * qx + e2y * qy + e2z * qz) * inv_det;
+        const bool ok = (det != T(0)) & (u[i] >= T(0)) & (v[i] >= T(0)) & (u[i] + v[i] <= T(1)) & (t[i] >= rays.t_min[i]) & (t[i] <= rays.t_max[i]);
+        hit[i] = ok ? T(1) : T(0);
+    }
+    std::uint32_t mask = 0;
+    for (unsigned i = 0; i < W; ++i) {
+        if (hit[i] != T(0)) {
+            rays.t_max[i] = hits.t[i] = t[i];
+            hits.u[i] = u[i];
+            hits.v[i] = v[i];
+            hits.index[i] = index;
+            mask |= std::uint32_t(1) << i;
+        }
+    }
+    return mask;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Möller–Trumbore test of a ray against a triangle.
+ *
+ * Both sides of the triangle are hit, rays parallel to the triangle never hit.
+ * @tparam T The underlying data type.
+ * @param ray The ray.
+ * @param triangle The triangle.
+ * @param hit Receives t, u and v on a hit, unchanged otherwise.
+ * @return True if the ray hits the triangle within [t_min, t_max].
+ */
+template <typename T>
+constexpr bool intersect(const Ray<T> &ray, const Triangle<T> &triangle, RayHit<T> &hit) {
+    return detail::intersectTriangle(ray, triangle.v0, Vector<3, T>(triangle.v1 - triangle.v0), Vector<3, T>(triangle.v2 - triangle.v0), hit);
+}
+
+/**
+ * @brief Slab test of a packet against a box.
+ *
+ * Evaluates all lanes without branches, so the loop is vectorized by the compiler.
+ * @tparam W The number of rays.
+ * @tparam T The underlying data type.
+ * @param rays The rays.
+ * @param box The box.
+ * @param t_entry Receives the distances at which the rays enter the box, may be nullptr.
+ * @return The mask of the lanes which hit the box within [t_min, t_max].
+ */
+template <unsigned W, typename T>
+inline std::uint32_t intersect(const RayPacket<W, T> &rays, const Aabb<T> &box, T *t_entry = nullptr) {
+    const T lo0 = box.lo[0], lo1 = box.lo[1], lo2 = box.lo[2];
+    const T hi0 = box.hi[0], hi1 = box.hi[1], hi2 = box.hi[2];
+    const auto slab = [](T lo, T hi, T origin, T inv, T &t0, T &t1) MATHLIB_INLINE_LAMBDA {
+        const T a = (lo - origin) * inv, b = (hi - origin) * inv;
+        const T t_near = a < b ? a : b, t_far = a < b ? b : a;
+        t0 = t_near > t0 ? t_near : t0;
+        t1 = t_far < t1 ? t_far : t1;
+    };
+    T t0[W], t1[W];
+    MATHLIB_NO_UNROLL
+    for (unsigned i = 0; i < W; ++i) {
+        T t_near = rays.t_min[i], t_far = rays.t_max[i];
+        slab(lo0, hi0, rays.origin[0][i], rays.inv_direction[0][i], t_near, t_far);
+        slab(lo1, hi1, rays.origin[1][i], rays.inv_direction[1][i], t_near, t_far);
+        slab(lo2, hi2, rays.origin[2][i], rays.inv_direction[2][i], t_near, t_far);
+        t0[i] = t_near;
+        t1[i] = t_far;
+    }
+    std::uint32_t mask = 0;
+    for (unsigned i = 0; i < W; ++i)
+        mask |= std::uint32_t(t0[i] <= t1[i]) << i;
+    if (t_entry)
+        for (unsigned i = 0; i < W; ++i)
+            t_entry[i] = t0[i];
+    return mask;
+}
+
+/**
+ * @brief Möller–Trumbore test of a packet against a triangle.
+ *
+ * Evaluates all lanes without branches, so the loop is vectorized by the compiler. Calling it for several
+ * triangles keeps the closest hit of every lane.
+ * @tparam W The number of rays.
+ * @tparam T The underlying data type.
+ * @param rays The rays, t_max is lowered to t in every lane which hits.
+ * @param triangle The triangle.
+ * @param index The index stored in hits.
+ * @param hits Receives the hits.
+ * @return The mask of the lanes which hit.
+ */
+template <unsigned W, typename T>
+inline std::uint32_t intersect(RayPacket<W, T> &rays, const Triangle<T> &triangle, std::uint32_t index, HitPacket<W, T> &hits) {
+    return detail::intersectTriangle(rays, triangle.v0, Vector<3, T>(triangle.v1 - triangle.v0), Vector<3, T>(triangle.v2 - triangle.v0), index,
+                                     hits);
+}
+
+}  // namespace mathlib
+
+/**
+ * @name Defines
+ * @brief Underlying data type definitions.
+ */
+/** @{ */
+using Rayf = Ray<float>;
+using Rayd = Ray<double>;
+using Aabbf = Aabb<float>;
+using Aabbd = Aabb<double>;
+using Trianglef = Triangle<float>;
+using Triangled = Triangle<double>;
+using RayPacket4f = RayPacket<4, float>;
+using RayPacket8f = RayPacket<8, float>;
+using RayPacket16f = RayPacket<16, float>;
+using HitPacket4f = HitPacket<4, float>;
+using HitPacket8f = HitPacket<8, float>;
+using HitPacket16f = HitPacket<16, float>;
+/** @} */
+
+#endif /* __MATHLIB_RAY_H__ */
@@ -0,0 +1,215 @@
+#ifndef __MATHLIB_REDUCE_H__
+#define __MATHLIB_REDUCE_H__
+
+#include <mathlib/parallel.h>
+#include <mathlib/vector.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mathlib {
+
+namespace detail {
+
+/**
+ * @brief The number of items reduced into one partial result.
+ */
+constexpr std::size_t reduce_block = 1 << 12;
+
+/**
+ * @brief Reduce [0, count) block-wise, in parallel.
+ *
+ * The input is split into blocks of reduce_block items independent of the thread count. The partial results are
+ * combined in block order, so the result is the same for every thread count.
+ * @tparam R The result type.
+ * @tparam F The block function type.
+ * @tparam C The combine function type.
+ * @param count The number of items.
+ * @param threads The number of threads, 0 for one per hardware thread.
+ * @param init The identity of combine.
+ * @param block The block function, called as block(begin, end) and returning the partial result of [begin, end).
+ * @param combine The combine function, called as combine(a, b) and returning the combined result.
+ * @return The result of the reduction.
+ */
+template <typename R, typename F, typename C>
+R reduceBlocks(std::size_t count, unsigned threads, const R &init, F &&block, C &&combine) {
+    const std::size_t blocks = (count + reduce_block - 1) / reduce_block;
+    std::vector<R> partials(blocks, init);
+    parallelFor(blocks, threads, 4, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t b = begin; b < end; ++b)
+            partials[b] = block(b * reduce_block, std::min((b + 1) * reduce_block, count));
+    });
+
+    R ret = init;
+    for (const R &partial : partials)
+        ret = combine(ret, partial);
+    return ret;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Sum up a range of vectors.
+ * @tparam N The size of the vectors.
+ * @tparam T The underlying data type.
+ * @param data The vectors.
+ * @param count The number of vectors.
+ * @param threads The number of threads, 0 for one per hardware thread.
+ * @return The sum of all vectors, zero for an empty range.
+ */
+template <unsigned N, typename T>
+Vector<N, T> sum(const Vector<N, T> *data, std::size_t count, unsigned threads = 1) {
+    return detail::reduceBlocks(
+        count, threads, Vector<N, T>(),
+        [data](std::size_t begin, std::size_t end) {
+            Vector<N, T> ret;
+            for (std::size_t i = begin; i < end; ++i)
+                ret += data[i];
+            return ret;
+        },
+        [](Vector<N, T> a, const Vector<N, T> &b) {
+            a += b;
+            return a;
+        });
+}
+
+/**
+ * @brief Sum up vectors.
+ * @tparam N The size of the vectors.
+ * @tparam T The underlying data type.
+ * @param data The vectors.
+ * @param threads The number of threads, 0 for one per hardware thread.
+ * @return The sum of all vectors, zero for no vectors.
+ */
+template <unsigned N, typename T>
+Vector<N, T> sum(const std::vector<Vector<N, T>> &data, unsigned threads = 1) {
+    return sum(data.data(), data.size(), threads);
+}
+
+/**
+ * @brief Compute the mean (centroid) of a range of vectors.
+ * @tparam N The size of the vectors.
+ * @tparam T The underlying data type.
+ * @param data The vectors.
+ * @param count The number of vectors.
+ * @param threads The number of threads, 0 for one per hardware thread.
+ * @return The mean of all vectors, zero for an empty range.
+ * @attention Only for floating point types.
+ */
+template <unsigned N, typename T>
+Vector<N, T> mean(const Vector<N, T> *data, std::size_t count, unsigned threads = 1) {
+    static_assert(std::is_floating_point<T>::value, "base type is not floating point.");
+    if (count == 0)
+        return Vector<N, T>();
+    return sum(data, count, threads) / T(count);
+}
+
+/**
+ * @brief Compute the mean (centroid) of vectors.
+ * @tparam N The size of the vectors.
+ * @tparam T The underlying data type.
+ * @param data The vectors.
+ * @param threads The number of threads, 0 for one per hardware thread.
+ * @return The mean of all vectors, zero for no vectors.
+ * @attention Only for floating point types.
+ */
+template <unsigned N, typename T>
+Vector<N, T> mean(const std::vector<Vector<N, T>> &data, unsigned threads = 1) {
+    return mean(data.data(), data.size(), threads);
+}
+
+/**
+ * @brief Compute the component-wise minimum and maximum (bounding box) of a range of vectors.
+ * @tparam N The size of the vectors.
+ * @tparam T The underlying data type.
+ * @param data The vectors.
+ * @param count The number of vectors.
+ * @param threads The number of threads, 0 for one per hardware thread.
+ * @return The pair (min, max). For an empty range min is the largest and max the lowest value of T.
+ */
+template <unsigned N, typename T>
+std::pair<Vector<N, T>, Vector<N, T>> boundingBox(const Vector<N, T> *data, std::size_t count, unsigned threads = 1) {
+    using Box = std::pair<Vector<N, T>, Vector<N, T>>;
+    const auto combine = [](const Box &a, const Box &b) {
+        Box ret;
+        for (unsigned c = 0; c < N; ++c) {
+            ret.first[c] = std::min(a.first[c], b.first[c]);
+            ret.second[c] = std::max(a.second[c], b.second[c]);
+        }
+        return ret;
+    };
+    const Box init(Vector<N, T>(std::numeric_limits<T>::max()), Vector<N, T>(std::numeric_limits<T>::lowest()));
+    return detail::reduceBlocks(
+        count, threads, init,
+        [data, &init](std::size_t begin, std::size_t end) {
+            Box ret = init;
+            for (std::size_t i = begin; i < end; ++i) {
+                for (unsigned c = 0; c < N; ++c) {
+                    ret.first[c] = std::min(ret.first[c], data[i][c]);
+                    ret.second[c] = std::max(ret.second[c], data[i][c]);
+                }
+            }
+            return ret;
+        },
+        combine);
+}
+
+/**
+ * @brief Compute the component-wise minimum and maximum (bounding box) of vectors.
+ * @tparam N The size of the vectors.
+ * @tparam T The underlying data type.
+ * @param data The vectors.
+ * @param threads The number of threads, 0 for one per hardware thread.
+ * @return The pair (min, max). For no vectors min is the largest and max the lowest value of T.
+ */
+template <unsigned N, typename T>
+std::pair<Vector<N, T>, Vector<N, T>> boundingBox(const std::vector<Vector<N, T>> &data, unsigned threads = 1) {
+    return boundingBox(data.data(), data.size(), threads);
+}
+
+/**
+ * @brief Accumulate the dot-products of two ranges of vectors.
+ * @tparam N The size of the vectors.
+ * @tparam T The underlying data type.
+ * @param a The first vectors.
+ * @param b The second vectors.
+ * @param count The number of vectors in both ranges.
+ * @param threads The number of threads, 0 for one per hardware thread.
+ * @return The sum of a[i].dot(b[i]) over all i.
+ */
+template <unsigned N, typename T>
+T dot(const Vector<N, T> *a, const Vector<N, T> *b, std::size_t count, unsigned threads = 1) {
+    return detail::reduceBlocks(
+        count, threads, T(0),
+        [a, b](std::size_t begin, std::size_t end) {
+            T ret(0);
+            for (std::size_t i = begin; i < end; ++i)
+                ret += a[i].dot(b[i]);
+            return ret;
+        },
+        [](T x, T y) { return T(x + y); });
+}
+
+/**
+ * @brief Accumulate the dot-products of two sets of vectors.
+ * @tparam N The size of the vectors.
+ * @tparam T The underlying data type.
+ * @param a The first vectors.
+ * @param b The second vectors, same size as a.
+ * @param threads The number of threads, 0 for one per hardware thread.
+ * @return The sum of a[i].dot(b[i]) over all i.
+ */
+template <unsigned N, typename T>
+T dot(const std::vector<Vector<N, T>> &a, const std::vector<Vector<N, T>> &b, unsigned threads = 1) {
+    assert(a.size() == b.size());
+    return dot(a.data(), b.data(), a.size(), threads);
+}
+
+}  // namespace mathlib
+
+#endif /* __MATHLIB_REDUCE_H__ */
@@ -0,0 +1,889 @@
+#ifndef __MATHLIB_SIMD_H__
+#define __MATHLIB_SIMD_H__
+
+/**
+ * @file simd.h
+ * @brief Hand-written SSE/AVX/AVX-512 kernels for float and double arrays of compile-time size.
+ *
+ * The widest instruction set enabled for the current compilation (e.g. with -mavx2 or -march=native) is used.
+ * Define MATHLIB_FORCE_SCALAR (or configure with -DMATHLIB_FORCE_SCALAR=ON) to always use the plain scalar loops,
+ * e.g. to compare results.
+ */
+
+#if !defined(MATHLIB_FORCE_SCALAR)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATHLIB_SIMD_SSE2
+#endif
+#if defined(__AVX__)
+#define MATHLIB_SIMD_AVX
+#endif
+#if defined(__AVX512F__)
+#define MATHLIB_SIMD_AVX512
+#endif
+#if defined(__F16C__)
+#define MATHLIB_SIMD_F16C
+#endif
+#endif
+
+#include <mathlib/unroll.h>
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#if defined(MATHLIB_SIMD_SSE2)
+#include <immintrin.h>
+#endif
+
+/**
+ * @def MATHLIB_IS_CONSTANT_EVALUATED
+ * @brief True while a constexpr function is evaluated at compile time.
+ *
+ * The kernels are not constexpr, callers use this to fall back to scalar code during constant evaluation.
+ * Without compiler support, the SIMD kernels are disabled.
+ */
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define MATHLIB_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#endif
+#if !defined(MATHLIB_IS_CONSTANT_EVALUATED) && ((defined(__GNUC__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925))
+#define MATHLIB_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#if !defined(MATHLIB_IS_CONSTANT_EVALUATED)
+#define MATHLIB_IS_CONSTANT_EVALUATED() true
+#undef MATHLIB_SIMD_SSE2
+#undef MATHLIB_SIMD_AVX
+#undef MATHLIB_SIMD_AVX512
+#endif
+
+namespace mathlib::simd {
+
+/**
+ * @brief A SIMD register holding W values of type T.
+ *
+ * Only the specializations for the enabled instruction sets are available.
+ * @tparam T The underlying data type.
+ * @tparam W The number of lanes.
+ */
+template <typename T, unsigned W>
+struct Pack {
+    constexpr static bool available = false;  ///< No register of this width.
+};
+
+/** @cond INTERNAL */
+#if defined(MATHLIB_SIMD_SSE2)
+/**
+ * @brief 4 floats in a SSE register.
+ */
+template <>
+struct Pack<float, 4> {
+    constexpr static bool available = true;  ///< Supported by SSE.
+    using reg = __m128;                      ///< The register type.
+
+    static reg load(const float *p) {
+        return _mm_loadu_ps(p);
+    }
+    static void store(float *p, reg a) {
+        _mm_storeu_ps(p, a);
+    }
+    static reg set1(float a) {
+        return _mm_set1_ps(a);
+    }
+    static reg zero() {
+        return _mm_setzero_ps();
+    }
+    static reg add(reg a, reg b) {
+        return _mm_add_ps(a, b);
+    }
+    static reg sub(reg a, reg b) {
+        return _mm_sub_ps(a, b);
+    }
+    static reg mul(reg a, reg b) {
+        return _mm_mul_ps(a, b);
+    }
+    static reg div(reg a, reg b) {
+        return _mm_div_ps(a, b);
+    }
+    static float hsum(reg a) {
+        __m128 shuf = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1));
+        __m128 sums = _mm_add_ps(a, shuf);
+        shuf = _mm_movehl_ps(shuf, sums);
+        sums = _mm_add_ss(sums, shuf);
+        return _mm_cvtss_f32(sums);
+    }
+};
+
+/**
+ * @brief 2 doubles in a SSE register.
+ */
+template <>
+struct Pack<double, 2> {
+    constexpr static bool available = true;  ///< Supported by SSE2.
+    using reg = __m128d;                     ///< The register type.
+
+    static reg load(const double *p) {
+        return _mm_loadu_pd(p);
+    }
+    static void store(double *p, reg a) {
+        _mm_storeu_pd(p, a);
+    }
+    static reg set1(double a) {
+        return _mm_set1_pd(a);
+    }
+    static reg zero() {
+        return _mm_setzero_pd();
+    }
+    static reg add(reg a, reg b) {
+        return _mm_add_pd(a, b);
+    }
+    static reg sub(reg a, reg b) {
+        return _mm_sub_pd(a, b);
+    }
+    static reg mul(reg a, reg b) {
+        return _mm_mul_pd(a, b);
+    }
+    static reg div(reg a, reg b) {
+        return _mm_div_pd(a, b);
+    }
+    static double hsum(reg a) {
+        return _mm_cvtsd_f64(_mm_add_sd(a, _mm_unpackhi_pd(a, a)));
+    }
+};
+#endif
+
+#if defined(MATHLIB_SIMD_AVX)
+/**
+ * @brief 8 floats in an AVX register.
+ */
+template <>
+struct Pack<float, 8> {
+    constexpr static bool available = true;  ///< Supported by AVX.
+    using reg = __m256;                      ///< The register type.
+
+    static reg load(const float *p) {
+        return _mm256_loadu_ps(p);
+    }
+    static void store(float *p, reg a) {
+        _mm256_storeu_ps(p, a);
+    }
+    static reg set1(float a) {
+        return _mm256_set1_ps(a);
+    }
+    static reg zero() {
+        return _mm256_setzero_ps();
+    }
+    static reg add(reg a, reg b) {
+        return _mm256_add_ps(a, b);
+    }
+    static reg sub(reg a, reg b) {
+        return _mm256_sub_ps(a, b);
+    }
+    static reg mul(reg a, reg b) {
+        return _mm256_mul_ps(a, b);
+    }
+    static reg div(reg a, reg b) {
+        return _mm256_div_ps(a, b);
+    }
+    static float hsum(reg a) {
+        return Pack<float, 4>::hsum(_mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1)));
+    }
+};
+
+/**
+ * @brief 4 doubles in an AVX register.
+ */
+template <>
+struct Pack<double, 4> {
+    constexpr static bool available = true;  ///< Supported by AVX.
+    using reg = __m256d;                     ///< The register type.
+
+    static reg load(const double *p) {
+        return _mm256_loadu_pd(p);
+    }
+    static void store(double *p, reg a) {
+        _mm256_storeu_pd(p, a);
+    }
+    static reg set1(double a) {
+        return _mm256_set1_pd(a);
+    }
+    static reg zero() {
+        return _mm256_setzero_pd();
+    }
+    static reg add(reg a, reg b) {
+        return _mm256_add_pd(a, b);
+    }
+    static reg sub(reg a, reg b) {
+        return _mm256_sub_pd(a, b);
+    }
+    static reg mul(reg a, reg b) {
+        return _mm256_mul_pd(a, b);
+    }
+    static reg div(reg a, reg b) {
+        return _mm256_div_pd(a, b);
+    }
+    static double hsum(reg a) {
+        return Pack<double, 2>::hsum(_mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1)));
+    }
+};
+#endif
+
+#if defined(MATHLIB_SIMD_AVX512)
+/**
+ * @brief Half of an AVX-512 register.
+ *
+ * Uses the masked extraction with an explicit source. GCC 12 implements the casts and unmasked extractions with an
+ * undefined source, which warns with -Wall.
+ * @tparam I 0 for the lower and 1 for the upper 256 bits.
+ * @param a The register.
+ * @return The half.
+ */
+template <int I>
+inline __m256d half512(__m512d a) {
+    return _mm512_mask_extractf64x4_pd(_mm256_setzero_pd(), 0xF, a, I);
+}
+
+/**
+ * @brief 16 floats in an AVX-512 register.
+ */
+template <>
+struct Pack<float, 16> {
+    constexpr static bool available = true;  ///< Supported by AVX-512F.
+    using reg = __m512;                      ///< The register type.
+
+    static reg load(const float *p) {
+        return _mm512_loadu_ps(p);
+    }
+    static void store(float *p, reg a) {
+        _mm512_storeu_ps(p, a);
+    }
+    static reg set1(float a) {
+        return _mm512_set1_ps(a);
+    }
+    static reg zero() {
+        return _mm512_setzero_ps();
+    }
+    static reg add(reg a, reg b) {
+        return _mm512_add_ps(a, b);
+    }
+    static reg sub(reg a, reg b) {
+        return _mm512_sub_ps(a, b);
+    }
+    static reg mul(reg a, reg b) {
+        return _mm512_mul_ps(a, b);
+    }
+    static reg div(reg a, reg b) {
+        return _mm512_div_ps(a, b);
+    }
+    static float hsum(reg a) {
+        // _mm512_extractf32x8_ps would need AVX-512DQ, the 64 bit lanes hold the same bits.
+        const __m512d bits = _mm512_castps_pd(a);
+        return Pack<float, 8>::hsum(_mm256_add_ps(_mm256_castpd_ps(half512<0>(bits)), _mm256_castpd_ps(half512<1>(bits))));
+    }
+};
+
+/**
+ * @brief 8 doubles in an AVX-512 register.
+ */
+template <>
+struct Pack<double, 8> {
+    constexpr static bool available = true;  ///< Supported by AVX-512F.
+    using reg = __m512d;                     ///< The register type.
+
+    static reg load(const double *p) {
+        return _mm512_loadu_pd(p);
+    }
+    static void store(double *p, reg a) {
+        _mm512_storeu_pd(p, a);
+    }
+    static reg set1(double a) {
+        return _mm512_set1_pd(a);
+    }
+    static reg zero() {
+        return _mm512_setzero_pd();
+    }
+    static reg add(reg a, reg b) {
+        return _mm512_add_pd(a, b);
+    }
+    static reg sub(reg a, reg b) {
+        return _mm512_sub_pd(a, b);
+    }
+    static reg mul(reg a, reg b) {
+        return _mm512_mul_pd(a, b);
+    }
+    static reg div(reg a, reg b) {
+        return _mm512_div_pd(a, b);
+    }
+    static double hsum(reg a) {
+        return Pack<double, 4>::hsum(_mm256_add_pd(half512<0>(a), half512<1>(a)));
+    }
+};
+#endif
+/** @endcond */
+
+/**
+ * @brief The widest available register for n values of type T.
+ * @tparam T The underlying data type.
+ * @param n The number of values.
+ * @return The number of lanes, 1 if no register fits (scalar code).
+ */
+template <typename T>
+constexpr unsigned widest(unsigned n) {
+    if (Pack<T, 16>::available && n >= 16)
+        return 16;
+    if (Pack<T, 8>::available && n >= 8)
+        return 8;
+    if (Pack<T, 4>::available && n >= 4)
+        return 4;
+    if (Pack<T, 2>::available && n >= 2)
+        return 2;
+    return 1;
+}
+
+/**
+ * @brief True if SIMD kernels exist for type T.
+ * @tparam T The underlying data type.
+ */
+template <typename T>
+constexpr bool supported = widest<T>(16) > 1;
+
+/**
+ * @brief Element-wise addition.
+ */
+struct AddOp {
+    template <typename P>
+    static typename P::reg pack(typename P::reg a, typename P::reg b) {
+        return P::add(a, b);
+    }
+    template <typename T>
+    static T scalar(T a, T b) {
+        return a + b;
+    }
+};
+
+/**
+ * @brief Element-wise subtraction.
+ */
+struct SubOp {
+    template <typename P>
+    static typename P::reg pack(typename P::reg a, typename P::reg b) {
+        return P::sub(a, b);
+    }
+    template <typename T>
+    static T scalar(T a, T b) {
+        return a - b;
+    }
+};
+
+/**
+ * @brief Element-wise multiplication.
+ */
+struct MulOp {
+    template <typename P>
+    static typename P::reg pack(typename P::reg a, typename P::reg b) {
+        return P::mul(a, b);
+    }
+    template <typename T>
+    static T scalar(T a, T b) {
+        return a * b;
+    }
+};
+
+/**
+ * @brief Element-wise division.
+ */
+struct DivOp {
+    template <typename P>
+    static typename P::reg pack(typename P::reg a, typename P::reg b) {
+        return P::div(a, b);
+    }
+    template <typename T>
+    static T scalar(T a, T b) {
+        return a / b;
+    }
+};
+
+/**
+ * @brief Compute a[i] = Op(a[i], b[i]) for N values.
+ *
+ * Uses the widest register which fits, the remainder is handled by narrower registers.
+ * @tparam N The number of values.
+ * @tparam Op The element-wise operation.
+ * @tparam T The underlying data type.
+ * @param a The first operand and output.
+ * @param b The second operand.
+ */
+template <unsigned N, typename Op, typename T>
+MATHLIB_ALWAYS_INLINE void apply(T *a, const T *b) {
+    constexpr unsigned W = widest<T>(N);
+    if constexpr (W == 1) {
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { a[i] = Op::scalar(a[i], b[i]); });
+    } else {
+        using P = Pack<T, W>;
+        constexpr unsigned M = N / W * W;
+        mathlib::detail::unrollStep<M, W>([&](unsigned i) MATHLIB_INLINE_LAMBDA { P::store(a + i, Op::template pack<P>(P::load(a + i), P::load(b + i))); });
+        apply<N - M, Op>(a + M, b + M);
+    }
+}
+
+/**
+ * @brief Compute a[i] = a[i] * s for N values.
+ * @tparam N The number of values.
+ * @tparam T The underlying data type.
+ * @param a The values.
+ * @param s The scalar.
+ */
+template <unsigned N, typename T>
+MATHLIB_ALWAYS_INLINE void scale(T *a, T s) {
+    constexpr unsigned W = widest<T>(N);
+    if constexpr (W == 1) {
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { a[i] *= s; });
+    } else {
+        using P = Pack<T, W>;
+        constexpr unsigned M = N / W * W;
+        const typename P::reg sv = P::set1(s);
+        mathlib::detail::unrollStep<M, W>([&](unsigned i) MATHLIB_INLINE_LAMBDA { P::store(a + i, P::mul(P::load(a + i), sv)); });
+        scale<N - M>(a + M, s);
+    }
+}
+
+/**
+ * @brief Compute a linear combination of C columns with P values each.
+ * @tparam P The number of values per column.
+ * @tparam C The number of columns.
+ * @tparam T The underlying data type.
+ * @param cols The columns, stored contiguously.
+ * @param v The C weights. May alias out.
+ * @param out The P values of sum_c cols[c] * v[c].
+ */
+template <unsigned P, unsigned C, typename T>
+MATHLIB_ALWAYS_INLINE void combine(const T *cols, const T *v, T *out) {
+    constexpr unsigned W = widest<T>(P);
+    T w[C];
+    mathlib::detail::unroll<C>([&](unsigned c) MATHLIB_INLINE_LAMBDA { w[c] = v[c]; });
+    if constexpr (W == 1) {
+        mathlib::detail::unroll<P>([&](unsigned i) MATHLIB_INLINE_LAMBDA {
+            T acc(0.);
+            mathlib::detail::unroll<C>([&](unsigned c) MATHLIB_INLINE_LAMBDA { acc += cols[c * P + i] * w[c]; });
+            out[i] = acc;
+        });
+    } else {
+        using Pk = Pack<T, W>;
+        constexpr unsigned M = P / W * W;
+        mathlib::detail::unrollStep<M, W>([&](unsigned i) MATHLIB_INLINE_LAMBDA {
+            typename Pk::reg acc = Pk::mul(Pk::load(cols + i), Pk::set1(w[0]));
+            mathlib::detail::unroll<C - 1>([&](unsigned c) MATHLIB_INLINE_LAMBDA { acc = Pk::add(acc, Pk::mul(Pk::load(cols + (c + 1) * P + i), Pk::set1(w[c + 1]))); });
+            Pk::store(out + i, acc);
+        });
+        mathlib::detail::unroll<P - M>([&](unsigned i) MATHLIB_INLINE_LAMBDA {
+            T acc(0.);
+            mathlib::detail::unroll<C>([&](unsigned c) MATHLIB_INLINE_LAMBDA { acc += cols[c * P + M + i] * w[c]; });
+            out[M + i] = acc;
+        });
+    }
+}
+
+/**
+ * @brief Compute a[i] = Op(a[i], b[i]) for n values.
+ * @tparam Op The element-wise operation.
+ * @tparam T The underlying data type.
+ * @param a The first operand and output.
+ * @param b The second operand.
+ * @param n The number of values.
+ */
+template <typename Op, typename T>
+inline void apply(T *a, const T *b, std::size_t n) {
+    constexpr unsigned W = widest<T>(16);
+    std::size_t i = 0;
+    if constexpr (W > 1) {
+        using P = Pack<T, W>;
+        for (; i + W <= n; i += W)
+            P::store(a + i, Op::template pack<P>(P::load(a + i), P::load(b + i)));
+    }
+    for (; i < n; ++i)
+        a[i] = Op::scalar(a[i], b[i]);
+}
+
+/**
+ * @brief Compute a[i] = a[i] * s for n values.
+ * @tparam T The underlying data type.
+ * @param a The values.
+ * @param s The scalar.
+ * @param n The number of values.
+ */
+template <typename T>
+inline void scale(T *a, T s, std::size_t n) {
+    constexpr unsigned W = widest<T>(16);
+    std::size_t i = 0;
+    if constexpr (W > 1) {
+        using P = Pack<T, W>;
+        const typename P::reg sv = P::set1(s);
+        for (; i + W <= n; i += W)
+            P::store(a + i, P::mul(P::load(a + i), sv));
+    }
+    for (; i < n; ++i)
+        a[i] *= s;
+}
+
+/**
+ * @brief Compute the dot-product of n values.
+ * @tparam T The underlying data type.
+ * @param a The first operand.
+ * @param b The second operand.
+ * @param n The number of values.
+ * @return The sum of a[i] * b[i].
+ */
+template <typename T>
+inline T dot(const T *a, const T *b, std::size_t n) {
+    constexpr unsigned W = widest<T>(16);
+    std::size_t i = 0;
+    T ret(0.);
+    if constexpr (W > 1) {
+        using P = Pack<T, W>;
+        typename P::reg acc0 = P::zero(), acc1 = P::zero(), acc2 = P::zero(), acc3 = P::zero();
+        for (; i + 4 * W <= n; i += 4 * W) {
+            acc0 = P::add(acc0, P::mul(P::load(a + i), P::load(b + i)));
+            acc1 = P::add(acc1, P::mul(P::load(a + i + W), P::load(b + i + W)));
+            acc2 = P::add(acc2, P::mul(P::load(a + i + 2 * W), P::load(b + i + 2 * W)));
+            acc3 = P::add(acc3, P::mul(P::load(a + i + 3 * W), P::load(b + i + 3 * W)));
+        }
+        for (; i + W <= n; i += W)
+            acc0 = P::add(acc0, P::mul(P::load(a + i), P::load(b + i)));
+        ret = P::hsum(P::add(P::add(acc0, acc1), P::add(acc2, acc3)));
+    }
+    for (; i < n; ++i)
+        ret += a[i] * b[i];
+    return ret;
+}
+
+/**
+ * @brief Compute the sum of n values.
+ *
+ * Four independent accumulators are used to hide the latency of the additions.
+ * @tparam T The underlying data type.
+ * @param a The values.
+ * @param n The number of values.
+ * @return The sum of a[i].
+ */
+template <typename T>
+inline T sum(const T *a, std::size_t n) {
+    constexpr unsigned W = widest<T>(16);
+    std::size_t i = 0;
+    T ret(0.);
+    if constexpr (W > 1) {
+        using P = Pack<T, W>;
+        typename P::reg acc0 = P::zero(), acc1 = P::zero(), acc2 = P::zero(), acc3 = P::zero();
+        for (; i + 4 * W <= n; i += 4 * W) {
+            acc0 = P::add(acc0, P::load(a + i));
+            acc1 = P::add(acc1, P::load(a + i + W));
+            acc2 = P::add(acc2, P::load(a + i + 2 * W));
+            acc3 = P::add(acc3, P::load(a + i + 3 * W));
+        }
+        for (; i + W <= n; i += W)
+            acc0 = P::add(acc0, P::load(a + i));
+        ret = P::hsum(P::add(P::add(acc0, acc1), P::add(acc2, acc3)));
+    }
+    for (; i < n; ++i)
+        ret += a[i];
+    return ret;
+}
+
+/**
+ * @brief The number of values the pairwise reductions sum up directly, larger inputs are split in halves.
+ */
+constexpr std::size_t pairwise_block = 256;
+
+/**
+ * @brief Compute the sum of n values by pairwise summation.
+ *
+ * Blocks of pairwise_block values are summed with the multi-accumulator kernel, the block sums are added in a
+ * balanced tree. The rounding error grows with log(n) instead of n, at the speed of sum().
+ * @tparam T The underlying data type.
+ * @param a The values.
+ * @param n The number of values.
+ * @return The sum of a[i].
+ */
+template <typename T>
+T pairwiseSum(const T *a, std::size_t n) {
+    if (n <= pairwise_block)
+        return sum(a, n);
+    const std::size_t m = (n + pairwise_block - 1) / pairwise_block / 2 * pairwise_block;
+    return pairwiseSum(a, m) + pairwiseSum(a + m, n - m);
+}
+
+/**
+ * @brief Compute the dot-product of n values by pairwise summation, see pairwiseSum().
+ * @tparam T The underlying data type.
+ * @param a The first operand.
+ * @param b The second operand.
+ * @param n The number of values.
+ * @return The sum of a[i] * b[i].
+ */
+template <typename T>
+T pairwiseDot(const T *a, const T *b, std::size_t n) {
+    if (n <= pairwise_block)
+        return dot(a, b, n);
+    const std::size_t m = (n + pairwise_block - 1) / pairwise_block / 2 * pairwise_block;
+    return pairwiseDot(a, b, m) + pairwiseDot(a + m, b + m, n - m);
+}
+
+/**
+ * @brief Add x to the compensated sum s + c, without branches (Knuth's TwoSum).
+ *
+ * The rounding error of s + x is computed exactly and accumulated in c.
+ * @attention Relies on strict IEEE arithmetic, it is optimized away with -ffast-math.
+ * @tparam T The underlying data type.
+ * @param s The sum.
+ * @param c The accumulated rounding errors.
+ * @param x The value to add.
+ */
+template <typename T>
+MATHLIB_ALWAYS_INLINE void twoSum(T &s, T &c, T x) {
+    const T t = s + x;
+    const T z = t - s;
+    c += (s - (t - z)) + (x - z);
+    s = t;
+}
+
+/**
+ * @brief Compensated summation of n values or products, shared by compensatedSum() and compensatedDot().
+ *
+ * Every lane keeps a TwoSum pair, two registers of pairs hide the latency of the additions.
+ * @tparam Products Sum a[i] * b[i] instead of a[i].
+ * @tparam T The underlying data type.
+ * @param a The values, or the first operand.
+ * @param b The second operand, unused for sums.
+ * @param n The number of values.
+ * @return The compensated sum.
+ */
+template <bool Products, typename T>
+T compensated(const T *a, const T *b, std::size_t n) {
+    constexpr unsigned W = widest<T>(16);
+    std::size_t i = 0;
+    T s(0.), c(0.);
+    if constexpr (W > 1) {
+        using P = Pack<T, W>;
+        using reg = typename P::reg;
+        auto value = [&](std::size_t j) MATHLIB_INLINE_LAMBDA {
+            if constexpr (Products)
+                return P::mul(P::load(a + j), P::load(b + j));
+            else
+                return P::load(a + j);
+        };
+        auto add = [](reg &rs, reg &rc, reg x) MATHLIB_INLINE_LAMBDA {
+            const reg t = P::add(rs, x);
+            const reg z = P::sub(t, rs);
+            rc = P::add(rc, P::add(P::sub(rs, P::sub(t, z)), P::sub(x, z)));
+            rs = t;
+        };
+        reg s0 = P::zero(), c0 = P::zero(), s1 = P::zero(), c1 = P::zero();
+        for (; i + 2 * W <= n; i += 2 * W) {
+            add(s0, c0, value(i));
+            add(s1, c1, value(i + W));
+        }
+        for (; i + W <= n; i += W)
+            add(s0, c0, value(i));
+        add(s0, c0, s1);
+        c0 = P::add(c0, c1);
+
+        T lanes_s[W], lanes_c[W];
+        P::store(lanes_s, s0);
+        P::store(lanes_c, c0);
+        for (unsigned l = 0; l < W; ++l) {
+            twoSum(s, c, lanes_s[l]);
+            c += lanes_c[l];
+        }
+    }
+    for (; i < n; ++i) {
+        if constexpr (Products)
+            twoSum(s, c, T(a[i] * b[i]));
+        else
+            twoSum(s, c, a[i]);
+    }
+    return s + c;
+}
+
+/**
+ * @brief Compute the sum of n values with compensated (Kahan-Babuska / Neumaier) summation.
+ *
+ * The result is as accurate as if it was summed in twice the precision and then rounded. Costs about five times
+ * as much as sum(), but is still faster than a serial loop.
+ * @tparam T The underlying data type.
+ * @param a The values.
+ * @param n The number of values.
+ * @return The sum of a[i].
+ */
+template <typename T>
+T compensatedSum(const T *a, std::size_t n) {
+    return compensated<false>(a, a, n);
+}
+
+/**
+ * @brief Compute the dot-product of n values with compensated summation of the products.
+ *
+ * The products are rounded once each, their sum is compensated like in compensatedSum().
+ * @tparam T The underlying data type.
+ * @param a The first operand.
+ * @param b The second operand.
+ * @param n The number of values.
+ * @return The sum of a[i] * b[i].
+ */
+template <typename T>
+T compensatedDot(const T *a, const T *b, std::size_t n) {
+    return compensated<true>(a, b, n);
+}
+
+/**
+ * @brief Compute the dot-product of N values.
+ *
+ * Four independent accumulators are used for large N to hide the latency of the additions,
+ * the horizontal reduction is done once at the end. Above pairwise_block values, pairwiseDot() is used.
+ * @tparam N The number of values.
+ * @tparam T The underlying data type.
+ * @param a The first operand.
+ * @param b The second operand.
+ * @return The sum of a[i] * b[i].
+ */
+template <unsigned N, typename T>
+MATHLIB_ALWAYS_INLINE T dot(const T *a, const T *b) {
+    constexpr unsigned W = widest<T>(N);
+    if constexpr (N > pairwise_block) {
+        return pairwiseDot(a, b, N);
+    } else if constexpr (W == 1) {
+        T ret(0.);
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { ret += a[i] * b[i]; });
+        return ret;
+    } else {
+        using P = Pack<T, W>;
+        constexpr unsigned M4 = N / (4 * W) * (4 * W);
+        constexpr unsigned M = N / W * W;
+        typename P::reg acc0 = P::zero();
+        if constexpr (M4 > 0) {
+            typename P::reg acc1 = P::zero(), acc2 = P::zero(), acc3 = P::zero();
+            mathlib::detail::unrollStep<M4, 4 * W>([&](unsigned i) MATHLIB_INLINE_LAMBDA {
+                acc0 = P::add(acc0, P::mul(P::load(a + i), P::load(b + i)));
+                acc1 = P::add(acc1, P::mul(P::load(a + i + W), P::load(b + i + W)));
+                acc2 = P::add(acc2, P::mul(P::load(a + i + 2 * W), P::load(b + i + 2 * W)));
+                acc3 = P::add(acc3, P::mul(P::load(a + i + 3 * W), P::load(b + i + 3 * W)));
+            });
+            acc0 = P::add(P::add(acc0, acc1), P::add(acc2, acc3));
+        }
+        mathlib::detail::unrollStep<M - M4, W>([&](unsigned i) MATHLIB_INLINE_LAMBDA { acc0 = P::add(acc0, P::mul(P::load(a + M4 + i), P::load(b + M4 + i))); });
+        return P::hsum(acc0) + dot<N - M>(a + M, b + M);
+    }
+}
+
+/**
+ * @brief Compute the sum of N values.
+ *
+ * Four independent accumulators are used for large N to hide the latency of the additions,
+ * the horizontal reduction is done once at the end. Above pairwise_block values, pairwiseSum() is used.
+ * @tparam N The number of values.
+ * @tparam T The underlying data type.
+ * @param a The values.
+ * @return The sum of a[i].
+ */
+template <unsigned N, typename T>
+MATHLIB_ALWAYS_INLINE T sum(const T *a) {
+    constexpr unsigned W = widest<T>(N);
+    if constexpr (N > pairwise_block) {
+        return pairwiseSum(a, N);
+    } else if constexpr (W == 1) {
+        T ret(0.);
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { ret += a[i]; });
+        return ret;
+    } else {
+        using P = Pack<T, W>;
+        constexpr unsigned M4 = N / (4 * W) * (4 * W);
+        constexpr unsigned M = N / W * W;
+        typename P::reg acc0 = P::zero();
+        if constexpr (M4 > 0) {
+            typename P::reg acc1 = P::zero(), acc2 = P::zero(), acc3 = P::zero();
+            mathlib::detail::unrollStep<M4, 4 * W>([&](unsigned i) MATHLIB_INLINE_LAMBDA {
+                acc0 = P::add(acc0, P::load(a + i));
+                acc1 = P::add(acc1, P::load(a + i + W));
+                acc2 = P::add(acc2, P::load(a + i + 2 * W));
+                acc3 = P::add(acc3, P::load(a + i + 3 * W));
+            });
+            acc0 = P::add(P::add(acc0, acc1), P::add(acc2, acc3));
+        }
+        mathlib::detail::unrollStep<M - M4, W>([&](unsigned i) MATHLIB_INLINE_LAMBDA { acc0 = P::add(acc0, P::load(a + M4 + i)); });
+        return P::hsum(acc0) + sum<N - M>(a + M);
+    }
+}
+
+/**
+ * @brief Approximate reciprocal square root.
+ *
+ * Uses the hardware estimate, refined with one Newton step (relative error below 5e-7).
+ * @param x The value, positive and finite.
+ * @return About 1 / sqrt(x).
+ */
+inline float rsqrt(float x) {
+#if defined(MATHLIB_SIMD_SSE2)
+    const float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+    return y * (1.5f - 0.5f * x * y * y);
+#else
+    return 1.f / std::sqrt(x);
+#endif
+}
+
+/**
+ * @brief Approximate reciprocal square root.
+ *
+ * Uses the single precision hardware estimate, refined with two Newton steps (relative error below 1e-13).
+ * Values outside the single precision range are computed exactly.
+ * @param x The value, positive and finite.
+ * @return About 1 / sqrt(x).
+ */
+inline double rsqrt(double x) {
+#if defined(MATHLIB_SIMD_SSE2)
+    if (x >= double(std::numeric_limits<float>::min()) && x <= double(std::numeric_limits<float>::max())) {
+        double y = double(_mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(float(x)))));
+        y = y * (1.5 - 0.5 * x * y * y);
+        return y * (1.5 - 0.5 * x * y * y);
+    }
+#endif
+    return 1. / std::sqrt(x);
+}
+
+/**
+ * @brief Approximate reciprocal.
+ *
+ * Uses the hardware estimate, refined with one Newton step (relative error below 5e-7).
+ * @param x The value, non-zero and finite.
+ * @return About 1 / x.
+ */
+inline float rcp(float x) {
+#if defined(MATHLIB_SIMD_SSE2)
+    const float y = _mm_cvtss_f32(_mm_rcp_ss(_mm_set_ss(x)));
+    return y * (2.f - x * y);
+#else
+    return 1.f / x;
+#endif
+}
+
+/**
+ * @brief Approximate reciprocal.
+ *
+ * Uses the single precision hardware estimate, refined with two Newton steps (relative error below 1e-13).
+ * Values outside the single precision range are computed exactly.
+ * @param x The value, non-zero and finite.
+ * @return About 1 / x.
+ */
+inline double rcp(double x) {
+#if defined(MATHLIB_SIMD_SSE2)
+    const double a = std::fabs(x);
+    if (a >= double(std::numeric_limits<float>::min()) && a <= double(std::numeric_limits<float>::max())) {
+        double y = double(_mm_cvtss_f32(_mm_rcp_ss(_mm_set_ss(float(x)))));
+        y = y * (2. - x * y);
+        return y * (2. - x * y);
+    }
+#endif
+    return 1. / x;
+}
+
+}  // namespace mathlib::simd
+
+#endif /* __MATHLIB_SIMD_H__ */
@@ -0,0 +1,435 @@
+#ifndef __MATHLIB_SPARSE_VECTOR_H__
+#define __MATHLIB_SPARSE_VECTOR_H__
+
+#include <mathlib/vector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Sparse %Vector class, storing only the non-zero values.
+ *
+ * The non-zeros are kept as index/value pairs sorted by index, in two separate arrays. All operations skip the
+ * zeros, so their cost scales with the number of non-zeros instead of N. Explicit zeros are never stored.
+ * @tparam N The size of the vectors.
+ * @tparam T The underlying data type of the vectors.
+ */
+template <unsigned N, typename T>
+class SparseVector {
+public:
+    using type = T;  ///< The underlying data type.
+
+    /**
+     * @brief The underlying size of the vector.
+     * @return The size.
+     */
+    constexpr static unsigned size() {
+        return N;
+    }
+
+    /**
+     * @brief Construct a zero vector.
+     */
+    SparseVector() = default;
+
+    /**
+     * @brief Construct a vector from index/value pairs.
+     *
+     * The pairs may be in any order, values of repeated indices are summed up.
+     * @param values The index/value pairs.
+     * @throws std::runtime_error If an index is out of bounds.
+     */
+    SparseVector(std::initializer_list<std::pair<unsigned, T>> values) {
+        std::vector<std::pair<unsigned, T>> sorted(values);
+        std::stable_sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+        m_indices.reserve(sorted.size());
+        m_values.reserve(sorted.size());
+        for (const auto &[idx, value] : sorted) {
+            assert_idx(idx);
+            if (!m_indices.empty() && m_indices.back() == idx)
+                m_values.back() += value;
+            else {
+                m_indices.push_back(idx);
+                m_values.push_back(value);
+            }
+        }
+        prune();
+    }
+
+    /**
+     * @brief Construct a sparse vector from the non-zeros of a dense vector.
+     * @param v The dense vector.
+     */
+    explicit SparseVector(const Vector<N, T> &v) {
+        for (unsigned i = 0; i < N; ++i) {
+            if (v[i] != T(0.)) {
+                m_indices.push_back(i);
+                m_values.push_back(v[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Convert this to a dense vector.
+     * @return The dense vector.
+     */
+    Vector<N, T> toVector() const {
+        Vector<N, T> ret;
+        for (std::size_t k = 0; k < m_indices.size(); ++k)
+            ret[m_indices[k]] = m_values[k];
+        return ret;
+    }
+
+    /**
+     * @brief The number of stored non-zeros.
+     * @return The number of non-zeros.
+     */
+    std::size_t nonZeros() const {
+        return m_indices.size();
+    }
+
+    /**
+     * @brief The indices of the non-zeros, sorted ascending.
+     * @return The indices.
+     */
+    const std::vector<unsigned> &indices() const {
+        return m_indices;
+    }
+
+    /**
+     * @brief The non-zero values, in the order of indices().
+     * @return The values.
+     */
+    const std::vector<T> &values() const {
+        return m_values;
+    }
+
+    /**
+     * @brief Read access to idx.
+     *
+     * Costs a binary search over the non-zeros.
+     * @param idx The index to read (0-indexed).
+     * @return The value at idx, zero if it is not stored.
+     * @attention Does not perform index boundary checks.
+     */
+    T operator[](unsigned idx) const {
+        const auto it = std::lower_bound(m_indices.begin(), m_indices.end(), idx);
+        if (it == m_indices.end() || *it != idx)
+            return T(0.);
+        return m_values[std::size_t(it - m_indices.begin())];
+    }
+
+    /**
+     * @brief Write a value at idx.
+     *
+     * Inserting or removing a non-zero shifts the following non-zeros.
+     * @param idx The index to write (0-indexed).
+     * @param value The new value, a zero removes the non-zero at idx.
+     * @throws std::runtime_error If idx is out of bounds.
+     */
+    void set(unsigned idx, T value) {
+        assert_idx(idx);
+        const auto it = std::lower_bound(m_indices.begin(), m_indices.end(), idx);
+        const std::size_t k = std::size_t(it - m_indices.begin());
+        if (it != m_indices.end() && *it == idx) {
+            if (value != T(0.))
+                m_values[k] = value;
+            else {
+                m_indices.erase(it);
+                m_values.erase(m_values.begin() + std::ptrdiff_t(k));
+            }
+        } else if (value != T(0.)) {
+            m_indices.insert(it, idx);
+            m_values.insert(m_values.begin() + std::ptrdiff_t(k), value);
+        }
+    }
+
+    /**
+     * @brief Get the sum of this.
+     * @return The sum of all values.
+     */
+    T sum() const {
+        T ret(0.);
+        for (const T &value : m_values)
+            ret += value;
+        return ret;
+    }
+
+    /**
+     * @brief The squared euclidian norm.
+     * @return The norm \f$ || v ||_2^2 \f$
+     */
+    T squaredNorm() const {
+        T ret(0.);
+        for (const T &value : m_values)
+            ret += value * value;
+        return ret;
+    }
+
+    /**
+     * @brief The euclidian norm.
+     * @return The norm \f$ || v ||_2 \f$
+     * @attention Only for floating point types.
+     */
+    T norm() const {
+        static_assert(std::is_floating_point<T>::value, "base type is not floating point.");
+        return std::sqrt(squaredNorm());
+    }
+
+    /**
+     * @brief Compute the dot-product with a dense vector.
+     *
+     * Gathers the values of other at the non-zeros of this.
+     * @param other The dense vector.
+     * @return The dot-product with other.
+     */
+    T dot(const Vector<N, T> &other) const {
+        T ret(0.);
+        for (std::size_t k = 0; k < m_indices.size(); ++k)
+            ret += m_values[k] * other[m_indices[k]];
+        return ret;
+    }
+
+    /**
+     * @brief Compute the dot-product with another sparse vector.
+     *
+     * Merges the two sorted index lists, the cost is linear in the non-zeros of both.
+     * @param other The other sparse vector.
+     * @return The dot-product with other.
+     */
+    T dot(const SparseVector &other) const {
+        T ret(0.);
+        std::size_t i = 0, j = 0;
+        while (i < m_indices.size() && j < other.m_indices.size()) {
+            const unsigned a = m_indices[i], b = other.m_indices[j];
+            if (a == b)
+                ret += m_values[i] * other.m_values[j];
+            i += a <= b;
+            j += b <= a;
+        }
+        return ret;
+    }
+
+    /**
+     * @brief Add a multiple of this to a dense vector (axpy).
+     * @param alpha The factor.
+     * @param y The dense vector, y += alpha * this.
+     */
+    void axpy(T alpha, Vector<N, T> &y) const {
+        for (std::size_t k = 0; k < m_indices.size(); ++k)
+            y[m_indices[k]] += alpha * m_values[k];
+    }
+
+    /**
+     * @brief Multiply this by a scalar.
+     * @param value The scalar.
+     * @return A reference to this vector, with this * value.
+     */
+    SparseVector &operator*=(const T &value) {
+        for (T &v : m_values)
+            v *= value;
+        prune();
+        return *this;
+    }
+
+    /**
+     * @brief Divide this by a scalar.
+     * @param value The scalar.
+     * @return A reference to this vector, with this / value.
+     * @attention Only for floating point types.
+     */
+    SparseVector &operator/=(const T &value) {
+        static_assert(std::is_floating_point<T>::value, "base type is not floating point.");
+        for (T &v : m_values)
+            v /= value;
+        prune();
+        return *this;
+    }
+
+    /**
+     * @brief Add another sparse vector to this.
+     * @param other The other sparse vector.
+     * @return A reference to this vector, with this + other.
+     */
+    SparseVector &operator+=(const SparseVector &other) {
+        *this = merge(*this, other, T(1.));
+        return *this;
+    }
+
+    /**
+     * @brief Subtract another sparse vector from this.
+     * @param other The other sparse vector.
+     * @return A reference to this vector, with this - other.
+     */
+    SparseVector &operator-=(const SparseVector &other) {
+        *this = merge(*this, other, T(-1.));
+        return *this;
+    }
+
+    /**
+     * @brief Add two sparse vectors.
+     * @param lhs The first sparse vector.
+     * @param rhs The second sparse vector.
+     * @return The sparse vector lhs + rhs.
+     */
+    friend SparseVector operator+(const SparseVector &lhs, const SparseVector &rhs) {
+        return merge(lhs, rhs, T(1.));
+    }
+
+    /**
+     * @brief Subtract two sparse vectors.
+     * @param lhs The first sparse vector.
+     * @param rhs The second sparse vector.
+     * @return The sparse vector lhs - rhs.
+     */
+    friend SparseVector operator-(const SparseVector &lhs, const SparseVector &rhs) {
+        return merge(lhs, rhs, T(-1.));
+    }
+
+    /**
+     * @brief Check for equality.
+     * @param lhs The first sparse vector.
+     * @param rhs The second sparse vector.
+     * @return True if both store the same non-zeros (exact comparison).
+     */
+    friend bool operator==(const SparseVector &lhs, const SparseVector &rhs) {
+        return lhs.m_indices == rhs.m_indices && lhs.m_values == rhs.m_values;
+    }
+
+    /**
+     * @brief Check for inequality.
+     * @param lhs The first sparse vector.
+     * @param rhs The second sparse vector.
+     * @return True if the non-zeros differ (exact comparison).
+     */
+    friend bool operator!=(const SparseVector &lhs, const SparseVector &rhs) {
+        return !(lhs == rhs);
+    }
+
+    /**
+     * @brief Write the non-zeros of a sparse vector to a stream, as index:value pairs.
+     * @param os The stream.
+     * @param v The sparse vector.
+     * @return The stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const SparseVector &v) {
+        for (std::size_t k = 0; k < v.m_indices.size(); ++k) {
+            os << v.m_indices[k] << ":" << v.m_values[k];
+            if (k + 1 < v.m_indices.size())
+                os << " ";
+        }
+        return os;
+    }
+
+private:
+    /**
+     * @brief Merge two sparse vectors into a + sign * b.
+     * @param a The first sparse vector.
+     * @param b The second sparse vector.
+     * @param sign The factor of b, 1 or -1.
+     * @return The merged sparse vector, without zeros.
+     */
+    static SparseVector merge(const SparseVector &a, const SparseVector &b, T sign) {
+        SparseVector ret;
+        ret.m_indices.reserve(a.nonZeros() + b.nonZeros());
+        ret.m_values.reserve(a.nonZeros() + b.nonZeros());
+        std::size_t i = 0, j = 0;
+        while (i < a.m_indices.size() || j < b.m_indices.size()) {
+            const unsigned ia = i < a.m_indices.size() ? a.m_indices[i] : N;
+            const unsigned ib = j < b.m_indices.size() ? b.m_indices[j] : N;
+            T value(0.);
+            if (ia <= ib)
+                value += a.m_values[i++];
+            if (ib <= ia)
+                value += sign * b.m_values[j++];
+            if (value != T(0.)) {
+                ret.m_indices.push_back(std::min(ia, ib));
+                ret.m_values.push_back(value);
+            }
+        }
+        return ret;
+    }
+
+    /**
+     * @brief Remove the stored zeros, e.g. after cancellation or underflow.
+     */
+    void prune() {
+        std::size_t n = 0;
+        for (std::size_t k = 0; k < m_indices.size(); ++k) {
+            if (m_values[k] != T(0.)) {
+                m_indices[n] = m_indices[k];
+                m_values[n] = m_values[k];
+                ++n;
+            }
+        }
+        m_indices.resize(n);
+        m_values.resize(n);
+    }
+
+    /**
+     * @brief Check if the index is in bounds.
+     * @param idx The index to check.
+     * @throws std::runtime_error If the index is out of bounds.
+     */
+    void assert_idx(unsigned idx) const {
+        if (idx >= N)
+            throw std::runtime_error("idx >= N");
+    }
+
+    std::vector<unsigned> m_indices;  ///< The indices of the non-zeros, sorted ascending.
+    std::vector<T> m_values;          ///< The non-zero values.
+};
+
+namespace mathlib {
+
+/**
+ * @brief Compute the dot-product of a dense and a sparse vector.
+ * @tparam N The size of the vectors.
+ * @tparam T The underlying data type.
+ * @param a The dense vector.
+ * @param b The sparse vector.
+ * @return The dot-product, costs one multiplication per non-zero of b.
+ */
+template <unsigned N, typename T>
+T dot(const Vector<N, T> &a, const SparseVector<N, T> &b) {
+    return b.dot(a);
+}
+
+}  // namespace mathlib
+
+/**
+ * @brief Add a sparse vector to a dense vector.
+ * @tparam N The size of the vectors.
+ * @tparam T The underlying data type.
+ * @param a The dense vector.
+ * @param b The sparse vector.
+ * @return A reference to a, with a + b.
+ */
+template <unsigned N, typename T>
+Vector<N, T> &operator+=(Vector<N, T> &a, const SparseVector<N, T> &b) {
+    b.axpy(T(1.), a);
+    return a;
+}
+
+/**
+ * @brief Subtract a sparse vector from a dense vector.
+ * @tparam N The size of the vectors.
+ * @tparam T The underlying data type.
+ * @param a The dense vector.
+ * @param b The sparse vector.
+ * @return A reference to a, with a - b.
+ */
+template <unsigned N, typename T>
+Vector<N, T> &operator-=(Vector<N, T> &a, const SparseVector<N, T> &b) {
+    b.axpy(T(-1.), a);
+    return a;
+}
+
+#endif /* __MATHLIB_SPARSE_VECTOR_H__ */
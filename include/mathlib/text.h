@@ -0,0 +1,421 @@
+#ifndef __MATHLIB_TEXT_H__
+#define __MATHLIB_TEXT_H__
+
+#include <mathlib/vector.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <clocale>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+#if defined(__APPLE__)
+#include <xlocale.h>
+#endif
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+
+/**
+ * @def MATHLIB_FLOAT_CHARCONV
+ * @brief Defined if std::to_chars and std::from_chars support floating point values.
+ *
+ * libc++ parses floating point values only since LLVM 20. Without the support, or if MATHLIB_NO_FLOAT_CHARCONV is
+ * defined, they are formatted and parsed by the C library in the "C" locale instead.
+ */
+#if defined(__cpp_lib_to_chars) && !defined(MATHLIB_NO_FLOAT_CHARCONV)
+#define MATHLIB_FLOAT_CHARCONV
+#endif
+
+namespace mathlib {
+
+namespace detail {
+
+/**
+ * @brief Upper bound for the number of characters of one formatted scalar.
+ */
+constexpr std::size_t max_scalar_chars = 32;
+
+/**
+ * @brief Check if a character separates values in a text file.
+ * @param c The character.
+ * @return True for whitespace, ',' and ';'.
+ */
+constexpr bool isSeparator(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == ',' || c == ';';
+}
+
+/**
+ * @brief Skip separators.
+ * @param first The start of the text.
+ * @param last The end of the text.
+ * @return The first character which is not a separator, or last.
+ */
+inline const char *skipSeparators(const char *first, const char *last) {
+    while (first != last && isSeparator(*first))
+        ++first;
+    return first;
+}
+
+#if defined(_WIN32)
+using CLocale = _locale_t;  ///< Handle of a C library locale.
+
+/**
+ * @brief The "C" locale, created on first use.
+ * @return The locale.
+ */
+inline CLocale cLocale() {
+    static const CLocale locale = _create_locale(LC_ALL, "C");
+    return locale;
+}
+
+/** @cond */
+inline void strtoC(const char *text, char **end, float &v) {
+    v = _strtof_l(text, end, cLocale());
+}
+inline void strtoC(const char *text, char **end, double &v) {
+    v = _strtod_l(text, end, cLocale());
+}
+inline void strtoC(const char *text, char **end, long double &v) {
+    v = _strtold_l(text, end, cLocale());
+}
+inline int snprintfC(char *buffer, std::size_t size, int precision, long double v) {
+    return _snprintf_l(buffer, size, "%.*Lg", cLocale(), precision, v);
+}
+/** @endcond */
+#else
+using CLocale = locale_t;  ///< Handle of a C library locale.
+
+/**
+ * @brief The "C" locale, created on first use.
+ * @return The locale.
+ */
+inline CLocale cLocale() {
+    static const CLocale locale = newlocale(LC_ALL_MASK, "C", CLocale(0));
+    return locale;
+}
+
+/** @cond */
+inline void strtoC(const char *text, char **end, float &v) {
+    v = strtof_l(text, end, cLocale());
+}
+inline void strtoC(const char *text, char **end, double &v) {
+    v = strtod_l(text, end, cLocale());
+}
+inline void strtoC(const char *text, char **end, long double &v) {
+    v = strtold_l(text, end, cLocale());
+}
+inline int snprintfC(char *buffer, std::size_t size, int precision, long double v) {
+    // glibc has no snprintf_l, the "C" locale is set for this thread only.
+    const CLocale previous = uselocale(cLocale());
+    const int ret = std::snprintf(buffer, size, "%.*Lg", precision, v);
+    uselocale(previous);
+    return ret;
+}
+/** @endcond */
+#endif
+
+/**
+ * @brief Format a floating point value with the C library, in the "C" locale.
+ *
+ * Fallback of std::to_chars. Writes the fewest significant digits which parse back to the same value, which is
+ * not always the shortest representation std::to_chars finds.
+ * @tparam T The floating point type.
+ * @param first The start of the buffer.
+ * @param last The end of the buffer.
+ * @param value The value.
+ * @return As std::to_chars.
+ */
+template <typename T>
+std::to_chars_result toCharsC(char *first, char *last, T value) {
+    char buffer[max_scalar_chars + 16];
+    int n = 0;
+    for (int precision = std::numeric_limits<T>::digits10; precision <= std::numeric_limits<T>::max_digits10; ++precision) {
+        n = snprintfC(buffer, sizeof(buffer), precision, value);
+        T parsed;
+        strtoC(buffer, nullptr, parsed);
+        if (parsed == value || value != value)
+            break;
+    }
+    if (n < 0 || n > last - first)
+        return {last, std::errc::value_too_large};
+    std::memcpy(first, buffer, std::size_t(n));
+    return {first + n, std::errc()};
+}
+
+/**
+ * @brief Parse a floating point value with the C library, in the "C" locale.
+ *
+ * Fallback of std::from_chars. Like it, rejects leading whitespace and '+' and leaves value unchanged on errors.
+ * @tparam T The floating point type.
+ * @param first The start of the text.
+ * @param last The end of the text.
+ * @param value The value to write to.
+ * @return As std::from_chars.
+ */
+template <typename T>
+std::from_chars_result fromCharsC(const char *first, const char *last, T &value) {
+    // The C library needs a terminated copy of the value.
+    const char *end = first;
+    while (end != last && !isSeparator(*end))
+        ++end;
+    if (end == first || *first == '+')
+        return {first, std::errc::invalid_argument};
+    char buffer[2 * max_scalar_chars];
+    std::string long_text;
+    const char *text = buffer;
+    if (std::size_t(end - first) < sizeof(buffer)) {
+        std::memcpy(buffer, first, std::size_t(end - first));
+        buffer[end - first] = '\0';
+    } else {
+        long_text.assign(first, end);
+        text = long_text.c_str();
+    }
+
+    char *parsed_end = nullptr;
+    T parsed;
+    errno = 0;
+    strtoC(text, &parsed_end, parsed);
+    if (parsed_end == text)
+        return {first, std::errc::invalid_argument};
+    const char *ptr = first + (parsed_end - text);
+    if (errno == ERANGE)
+        return {ptr, std::errc::result_out_of_range};
+    value = parsed;
+    return {ptr, std::errc()};
+}
+
+/**
+ * @brief Format a scalar, with std::to_chars where it supports the type.
+ * @tparam T The underlying data type.
+ * @param first The start of the buffer.
+ * @param last The end of the buffer.
+ * @param value The value.
+ * @return As std::to_chars.
+ */
+template <typename T>
+std::to_chars_result toChars(char *first, char *last, T value) {
+#if !defined(MATHLIB_FLOAT_CHARCONV)
+    if constexpr (std::is_floating_point<T>::value)
+        return toCharsC(first, last, value);
+    else
+#endif
+        return std::to_chars(first, last, value);
+}
+
+/**
+ * @brief Parse a scalar, with std::from_chars where it supports the type.
+ * @tparam T The underlying data type.
+ * @param first The start of the text.
+ * @param last The end of the text.
+ * @param value The value to write to.
+ * @return As std::from_chars.
+ */
+template <typename T>
+std::from_chars_result fromChars(const char *first, const char *last, T &value) {
+#if !defined(MATHLIB_FLOAT_CHARCONV)
+    if constexpr (std::is_floating_point<T>::value)
+        return fromCharsC(first, last, value);
+    else
+#endif
+        return std::from_chars(first, last, value);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Format a vector into a buffer, locale-independent.
+ *
+ * Floating point values are written in the shortest form which parses back to the same value, or with the fewest
+ * significant digits which do without MATHLIB_FLOAT_CHARCONV.
+ * @tparam N The size of the vector.
+ * @tparam T The underlying data type.
+ * @param first The start of the buffer.
+ * @param last The end of the buffer.
+ * @param v The vector.
+ * @param separator The character between two values.
+ * @return As std::to_chars, ptr is behind the last written character.
+ */
+template <unsigned N, typename T>
+std::to_chars_result format(char *first, char *last, const Vector<N, T> &v, char separator = ' ') {
+    for (unsigned i = 0; i < N; ++i) {
+        if (i > 0) {
+            if (first == last)
+                return {last, std::errc::value_too_large};
+            *first++ = separator;
+        }
+        std::to_chars_result ret = detail::toChars(first, last, v[i]);
+        if (ret.ec != std::errc())
+            return ret;
+        first = ret.ptr;
+    }
+    return {first, std::errc()};
+}
+
+/**
+ * @brief Format a vector, locale-independent.
+ * @tparam N The size of the vector.
+ * @tparam T The underlying data type.
+ * @param v The vector.
+ * @param separator The character between two values.
+ * @return The values, separated by separator.
+ */
+template <unsigned N, typename T>
+std::string format(const Vector<N, T> &v, char separator = ' ') {
+    char buffer[N * (detail::max_scalar_chars + 1)];
+    std::to_chars_result ret = format(buffer, buffer + sizeof(buffer), v, separator);
+    return std::string(buffer, ret.ptr);
+}
+
+/**
+ * @brief Parse a vector, locale-independent.
+ *
+ * Values may be separated by whitespace, ',' or ';'. Leading separators are skipped.
+ * @tparam N The size of the vector.
+ * @tparam T The underlying data type.
+ * @param first The start of the text.
+ * @param last The end of the text.
+ * @param v The vector to write to.
+ * @return As std::from_chars, ptr is behind the last parsed value.
+ */
+template <unsigned N, typename T>
+std::from_chars_result parse(const char *first, const char *last, Vector<N, T> &v) {
+    for (unsigned i = 0; i < N; ++i) {
+        first = detail::skipSeparators(first, last);
+        std::from_chars_result ret = detail::fromChars(first, last, v[i]);
+        if (ret.ec != std::errc())
+            return ret;
+        first = ret.ptr;
+    }
+    return {first, std::errc()};
+}
+
+/**
+ * @brief Parse a vector, locale-independent.
+ * @tparam N The size of the vector.
+ * @tparam T The underlying data type.
+ * @param text The text, containing exactly N values.
+ * @param v The vector to write to.
+ * @return True if the text was parsed completely.
+ */
+template <unsigned N, typename T>
+bool parse(std::string_view text, Vector<N, T> &v) {
+    const char *last = text.data() + text.size();
+    std::from_chars_result ret = parse(text.data(), last, v);
+    return ret.ec == std::errc() && detail::skipSeparators(ret.ptr, last) == last;
+}
+
+/**
+ * @brief Parse all vectors of a text.
+ *
+ * The text is a sequence of values separated by whitespace, ',' or ';', every N values form one vector.
+ * @tparam N The size of the vectors.
+ * @tparam T The underlying data type.
+ * @param text The text.
+ * @return The vectors.
+ * @throws std::runtime_error If the text contains something else or the number of values is not a multiple of N.
+ */
+template <unsigned N, typename T>
+std::vector<Vector<N, T>> parseVectors(std::string_view text) {
+    const char *first = text.data();
+    const char *last = first + text.size();
+    std::vector<Vector<N, T>> ret;
+    ret.reserve(std::size_t(std::count(first, last, '\n')) + 1);
+
+    first = detail::skipSeparators(first, last);
+    while (first != last) {
+        Vector<N, T> v;
+        std::from_chars_result r = parse(first, last, v);
+        if (r.ec != std::errc())
+            throw std::runtime_error("cannot parse vector at offset " + std::to_string(r.ptr - text.data()));
+        ret.push_back(v);
+        first = detail::skipSeparators(r.ptr, last);
+    }
+    return ret;
+}
+
+/**
+ * @brief Read all vectors of a text file, e.g. one vector per line in whitespace or CSV format.
+ * @tparam N The size of the vectors.
+ * @tparam T The underlying data type.
+ * @param path The path of the file.
+ * @return The vectors.
+ * @throws std::runtime_error If the file can not be read or parsed.
+ */
+template <unsigned N, typename T>
+std::vector<Vector<N, T>> readVectors(const std::string &path) {
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    if (!stream)
+        throw std::runtime_error("cannot open " + path);
+    std::string text(std::size_t(stream.tellg()), '\0');
+    stream.seekg(0);
+    if (!stream.read(&text[0], std::streamsize(text.size())))
+        throw std::runtime_error("cannot read " + path);
+    return parseVectors<N, T>(text);
+}
+
+/**
+ * @brief Write vectors to a text file, one vector per line.
+ *
+ * The output is produced in blocks, the file is readable by readVectors().
+ * @tparam N The size of the vectors.
+ * @tparam T The underlying data type.
+ * @param path The path of the file.
+ * @param data The vectors.
+ * @param count The number of vectors.
+ * @param separator The character between two values of a vector, e.g. ',' for CSV.
+ * @throws std::runtime_error If writing failed.
+ */
+template <unsigned N, typename T>
+void writeVectors(const std::string &path, const Vector<N, T> *data, std::size_t count, char separator = ' ') {
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    if (!stream)
+        throw std::runtime_error("cannot open " + path);
+
+    constexpr std::size_t line_chars = N * (detail::max_scalar_chars + 1) + 1;
+    std::vector<char> buffer(std::max<std::size_t>(1 << 16, line_chars));
+    char *p = buffer.data();
+    char *const last = buffer.data() + buffer.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        if (std::size_t(last - p) < line_chars) {
+            stream.write(buffer.data(), p - buffer.data());
+            p = buffer.data();
+        }
+        p = format(p, last, data[i], separator).ptr;
+        *p++ = '\n';
+    }
+    stream.write(buffer.data(), p - buffer.data());
+    stream.close();
+    if (stream.fail())
+        throw std::runtime_error("cannot write " + path);
+}
+
+/**
+ * @brief Write vectors to a text file, one vector per line.
+ * @tparam N The size of the vectors.
+ * @tparam T The underlying data type.
+ * @param path The path of the file.
+ * @param data The vectors.
+ * @param separator The character between two values of a vector, e.g. ',' for CSV.
+ * @throws std::runtime_error If writing failed.
+ */
+template <unsigned N, typename T>
+void writeVectors(const std::string &path, const std::vector<Vector<N, T>> &data, char separator = ' ') {
+    writeVectors(path, data.data(), data.size(), separator);
+}
+
+}  // namespace mathlib
+
+#endif /* __MATHLIB_TEXT_H__ */
@@ -0,0 +1,103 @@
+#ifndef __MATHLIB_UNROLL_H__
+#define __MATHLIB_UNROLL_H__
+
+/**
+ * @file unroll.h
+ * @brief Compile-time loop unrolling for the fixed-size loops of the vector types.
+ *
+ * Loops over at most MATHLIB_MAX_UNROLL indices are expanded with a fold expression, so they are straight-line
+ * code at every optimization level above -O0 (including -Og), without relying on the inlining and unrolling
+ * heuristics of the optimizer. The bodies are lambdas marked with MATHLIB_INLINE_LAMBDA.
+ */
+
+#include <utility>
+
+/**
+ * @def MATHLIB_ALWAYS_INLINE
+ * @brief Force inlining of a function, also in debug-optimized (-Og, -O1) builds.
+ */
+#if defined(_MSC_VER)
+#define MATHLIB_ALWAYS_INLINE __forceinline
+#elif defined(__GNUC__) || defined(__clang__)
+#define MATHLIB_ALWAYS_INLINE __attribute__((always_inline)) inline
+#else
+#define MATHLIB_ALWAYS_INLINE inline
+#endif
+
+/**
+ * @def MATHLIB_INLINE_LAMBDA
+ * @brief Force inlining of a lambda, placed between its parameter list and its body.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define MATHLIB_INLINE_LAMBDA __attribute__((always_inline))
+#else
+#define MATHLIB_INLINE_LAMBDA
+#endif
+
+/**
+ * @def MATHLIB_NO_UNROLL
+ * @brief Keep the following loop rolled, placed before a loop statement.
+ *
+ * For short lane loops which should be vectorized as a loop. GCC otherwise unrolls them completely before the
+ * loop vectorizer runs, leaving them to the less reliable straight-line vectorizer.
+ */
+#if defined(__GNUC__) && !defined(__clang__)
+#define MATHLIB_NO_UNROLL _Pragma("GCC unroll 1")
+#else
+#define MATHLIB_NO_UNROLL
+#endif
+
+/**
+ * @def MATHLIB_MAX_UNROLL
+ * @brief Loops with up to this many iterations are unrolled completely.
+ */
+#if !defined(MATHLIB_MAX_UNROLL)
+#define MATHLIB_MAX_UNROLL 16
+#endif
+
+namespace mathlib::detail {
+
+/**
+ * @brief Call f(I) for every index of the sequence, in order.
+ * @tparam F The function type.
+ * @tparam I The indices.
+ * @param f The function.
+ */
+template <typename F, unsigned... I>
+MATHLIB_ALWAYS_INLINE constexpr void unrollSequence(F &f, std::integer_sequence<unsigned, I...>) {
+    (f(I), ...);
+}
+
+/**
+ * @brief Call f(i) for i in [0, N), in order.
+ *
+ * Expanded into N calls for N <= MATHLIB_MAX_UNROLL, a plain loop otherwise.
+ * @tparam N The number of iterations.
+ * @tparam F The function type.
+ * @param f The function, called with an unsigned index.
+ */
+template <unsigned N, typename F>
+MATHLIB_ALWAYS_INLINE constexpr void unroll(F &&f) {
+    if constexpr (N <= MATHLIB_MAX_UNROLL) {
+        unrollSequence(f, std::make_integer_sequence<unsigned, N>());
+    } else {
+        for (unsigned i = 0; i < N; ++i)
+            f(i);
+    }
+}
+
+/**
+ * @brief Call f(i) for i = 0, Step, 2 * Step, ... below N, in order.
+ * @tparam N The end of the range.
+ * @tparam Step The stride.
+ * @tparam F The function type.
+ * @param f The function, called with an unsigned index.
+ */
+template <unsigned N, unsigned Step, typename F>
+MATHLIB_ALWAYS_INLINE constexpr void unrollStep(F &&f) {
+    unroll<(N + Step - 1) / Step>([&f](unsigned i) MATHLIB_INLINE_LAMBDA { f(i * Step); });
+}
+
+}  // namespace mathlib::detail
+
+#endif /* __MATHLIB_UNROLL_H__ */
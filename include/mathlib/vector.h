@@ -1,9 +1,20 @@
 #ifndef __MATHLIB_VECTOR_H__
 #define __MATHLIB_VECTOR_H__
 
+#include <mathlib/expression.h>
+#include <mathlib/precision.h>
+#include <mathlib/simd.h>
+#include <mathlib/unroll.h>
+#include <mathlib/vector_view.h>
+
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
 #include <limits>
 #include <numeric>
 #include <ostream>
@@ -17,7 +28,7 @@
  * @tparam T The underlying data type of the vectors.
  */
 template <unsigned N, typename T>
-class Vector {
+class Vector : public VectorExpression<Vector<N, T>, N, T> {
 public:
     using type = T;  ///< The underlying data type.
 
@@ -32,67 +43,86 @@ public:
     /**
      * @brief Construct a zero vector.
      */
-    Vector() {
-        std::fill(m_data, m_data + N, T(0.));
-    }
+    constexpr Vector() : m_data{} {}
 
     /**
      * @brief Construct a vector from a single value.
      * @param t The single value
      */
-    Vector(T t) {
-        std::fill(m_data, m_data + N, t);
+    constexpr Vector(T t) : m_data{} {
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] = t; });
     }
 
     /**
      * @brief Construct a vector from given data.
      * @param data The data to use.
+     * @attention Prefer the std::array or std::initializer_list constructors, which do not need a heap allocation.
      */
-    Vector(std::vector<T> data) {
+    Vector(const std::vector<T> &data) : m_data{} {
         assert(data.size() == N);
         std::copy(data.begin(), data.end(), m_data);
     }
 
+    /**
+     * @brief Construct a vector from given values.
+     * @param values The N values.
+     */
+    constexpr Vector(const std::array<T, N> &values) : m_data{} {
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] = values[i]; });
+    }
+
+    /**
+     * @brief Construct a vector from a list of values.
+     *
+     * A single value is assigned to all elements, like Vector(T), so Vector{t} keeps its meaning.
+     * @param values N values, or a single value.
+     * @throws std::invalid_argument If the list has neither N values nor a single one. In a constant
+     * expression this is a compile error.
+     */
+    constexpr Vector(std::initializer_list<T> values) : m_data{} {
+        if (values.size() != N && values.size() != 1)
+            throw std::invalid_argument("initializer list size does not match N");
+        const T *v = values.begin();
+        const unsigned step = values.size() == 1 ? 0 : 1;
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] = v[i * step]; });
+    }
+
     /**
      * @brief Construct a vector from another vector.
      * @param other The other vector.
      */
-    Vector(const Vector &other) {
-        std::copy(other.m_data, other.m_data + N, m_data);
-    }
+    constexpr Vector(const Vector &other) = default;
 
     /**
-     * @brief Construct a vector from given data.
-     * @param data The data to use.
+     * @brief Construct a vector by evaluating an expression.
+     * @tparam E The expression type.
+     * @param expression The expression to evaluate.
      */
-    Vector(T data[N]) {
-        std::copy(data, data + N, m_data);
+    template <typename E>
+    constexpr Vector(const VectorExpression<E, N, T> &expression) : m_data{} {
+        const E &e = expression.derived();
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] = e[i]; });
     }
 
     /**
-     * @brief Construct a vector from given x and y values.
-     * @param x The x value
-     * @param y The y value
-     * @attention Only for size 2 vectors.
+     * @brief Construct a vector from given data.
+     * @param data The data to use.
      */
-    Vector(const T &x, const T &y) {
-        static_assert(N == 2 && "only for vectors with size 2");
-        m_data[0] = x;
-        m_data[1] = y;
+    constexpr Vector(T data[N]) : m_data{} {
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] = data[i]; });
     }
 
     /**
-     * @brief Construct a vector from given x, y and z values.
-     * @param x The x value
-     * @param y The y value
-     * @param z The z value
-     * @attention Only for size 3 vectors.
+     * @brief Construct a vector from given values, e.g. x, y, z and w.
+     *
+     * The number of values is checked at compile time.
+     * @tparam Args The types of the values, convertible to T.
+     * @param values The N values.
+     * @attention Only for size 2 vectors and up, use Vector(T) for a single value.
      */
-    Vector(const T &x, const T &y, const T &z) {
-        static_assert(N == 3 && "only for vectors with size 3");
-        m_data[0] = x;
-        m_data[1] = y;
-        m_data[2] = z;
+    template <typename... Args, typename std::enable_if<(sizeof...(Args) >= 2) && (std::is_convertible<Args, T>::value && ...)>::type * = nullptr>
+    constexpr Vector(const Args &...values) : m_data{static_cast<T>(values)...} {
+        static_assert(sizeof...(Args) == N && "the number of values does not match the size of the vector");
     }
 
     /**
@@ -100,6 +130,28 @@ public:
      */
     ~Vector() = default;
 
+    /**
+     * @brief Assign another vector to this.
+     * @param other The other vector.
+     * @return A reference to this vector.
+     */
+    constexpr Vector &operator=(const Vector &other) = default;
+
+    /**
+     * @brief Evaluate an expression into this.
+     *
+     * All operations of the expression are performed in a single loop, without temporaries.
+     * @tparam E The expression type.
+     * @param expression The expression to evaluate.
+     * @return A reference to this vector.
+     */
+    template <typename E>
+    constexpr Vector &operator=(const VectorExpression<E, N, T> &expression) {
+        const E &e = expression.derived();
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] = e[i]; });
+        return *this;
+    }
+
     /**
      * @brief The euclidian norm.
      * @return The norm \f$ || v ||_2 \f$
@@ -107,23 +159,31 @@ public:
      */
     T norm() const {
         static_assert(std::is_floating_point<T>::value, "base type is not floating point.");
-        T sum(0.0);
-        for (unsigned i = 0; i < N; ++i)
-            sum += m_data[i] * m_data[i];
-        return std::sqrt(sum);
+        return std::sqrt(squaredNorm());
     }
 
     /**
      * @brief The squared euclidian norm.
      * @return The norm \f$ || v ||_2^2 \f$
      */
-    T squaredNorm() const {
+    constexpr T squaredNorm() const {
+        if constexpr (mathlib::simd::supported<T> || N > mathlib::simd::pairwise_block) {
+            if (!MATHLIB_IS_CONSTANT_EVALUATED())
+                return mathlib::simd::dot<N>(m_data, m_data);
+        }
         T sum(0.0);
-        for (unsigned i = 0; i < N; ++i)
-            sum += m_data[i] * m_data[i];
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { sum += m_data[i] * m_data[i]; });
         return sum;
     }
 
+    /**
+     * @brief The squared euclidian norm, with compensated summation.
+     * @return The norm \f$ || v ||_2^2 \f$
+     */
+    T squaredNorm(mathlib::Compensated) const {
+        return mathlib::simd::compensatedDot(m_data, m_data, N);
+    }
+
     /**
      * @brief Normalize this.
      * @attention Only for floating point types.
@@ -132,8 +192,11 @@ public:
         static_assert(std::is_floating_point<T>::value, "base type is not floating point.");
         T sqN = squaredNorm();
         T inv_norm = T(1.0) / std::sqrt(sqN + std::numeric_limits<T>::epsilon());
-        for (unsigned i = 0; i < N; ++i)
-            m_data[i] = inv_norm * m_data[i];
+        if constexpr (mathlib::simd::supported<T>) {
+            mathlib::simd::scale<N>(m_data, inv_norm);
+            return;
+        }
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] = inv_norm * m_data[i]; });
     }
 
     /**
@@ -148,8 +211,59 @@ public:
 
         // This is actually a safe norm, because we add a small term.
         T inv_norm = T(1.0) / std::sqrt(sqN + std::numeric_limits<T>::epsilon());
-        for (unsigned i = 0; i < N; ++i)
-            ret[i] = m_data[i] * inv_norm;
+        if constexpr (mathlib::simd::supported<T>) {
+            ret = *this;
+            mathlib::simd::scale<N>(ret.m_data, inv_norm);
+            return ret;
+        }
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { ret[i] = m_data[i] * inv_norm; });
+        return ret;
+    }
+
+    /**
+     * @brief The euclidian norm, computed with a precision policy.
+     * @tparam Policy mathlib::ExactMath or mathlib::FastMath.
+     * @return The norm \f$ || v ||_2 \f$
+     * @attention Only for floating point types.
+     */
+    template <typename Policy, typename std::enable_if<mathlib::is_precision_policy<Policy>>::type * = nullptr>
+    T norm(Policy) const {
+        static_assert(std::is_floating_point<T>::value, "base type is not floating point.");
+        if constexpr (std::is_same<Policy, mathlib::ExactMath>::value)
+            return norm();
+        const T sqN = squaredNorm();
+        // The estimate does not handle zero and subnormal values.
+        if (sqN < std::numeric_limits<T>::min())
+            return std::sqrt(sqN);
+        return sqN * mathlib::rsqrt(sqN, Policy());
+    }
+
+    /**
+     * @brief Normalize this, computed with a precision policy.
+     * @tparam Policy mathlib::ExactMath or mathlib::FastMath.
+     * @attention Only for floating point types.
+     */
+    template <typename Policy, typename std::enable_if<mathlib::is_precision_policy<Policy>>::type * = nullptr>
+    void normalize(Policy) {
+        static_assert(std::is_floating_point<T>::value, "base type is not floating point.");
+        const T inv_norm = mathlib::rsqrt(squaredNorm() + std::numeric_limits<T>::epsilon(), Policy());
+        if constexpr (mathlib::simd::supported<T>) {
+            mathlib::simd::scale<N>(m_data, inv_norm);
+            return;
+        }
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] = inv_norm * m_data[i]; });
+    }
+
+    /**
+     * @brief Return a normalized copy of this, computed with a precision policy.
+     * @tparam Policy mathlib::ExactMath or mathlib::FastMath.
+     * @return The normalized copy.
+     * @attention Only for floating point types.
+     */
+    template <typename Policy, typename std::enable_if<mathlib::is_precision_policy<Policy>>::type * = nullptr>
+    Vector normalized(Policy policy) const {
+        Vector ret(*this);
+        ret.normalize(policy);
         return ret;
     }
 
@@ -159,7 +273,7 @@ public:
      * @return The value at idx.
      * @attention Does not perform index boundary checks. Use Vector::at instead.
      */
-    T operator[](unsigned idx) const {
+    constexpr T operator[](unsigned idx) const {
         return m_data[idx];
     }
 
@@ -169,7 +283,7 @@ public:
      * @return The value at idx.
      * @attention Does not perform index boundary checks. Use Vector::at instead.
      */
-    T &operator[](unsigned idx) {
+    constexpr T &operator[](unsigned idx) {
         return m_data[idx];
     }
 
@@ -179,7 +293,7 @@ public:
      * @return The value at idx.
      * @attention Does not perform index boundary checks. Use Vector::at instead.
      */
-    T operator()(unsigned idx) const {
+    constexpr T operator()(unsigned idx) const {
         return m_data[idx];
     }
 
@@ -189,7 +303,7 @@ public:
      * @return The value at idx.
      * @attention Does not perform index boundary checks. Use Vector::at instead.
      */
-    T &operator()(unsigned idx) {
+    constexpr T &operator()(unsigned idx) {
         return m_data[idx];
     }
 
@@ -199,7 +313,7 @@ public:
      * @return The value at idx.
      * @attention Does perform index boundary checks.
      */
-    T at(unsigned idx) const {
+    constexpr T at(unsigned idx) const {
         assert_idx(idx);
         return m_data[idx];
     }
@@ -210,7 +324,7 @@ public:
      * @return The value at idx.
      * @attention Does perform index boundary checks.
      */
-    T &at(unsigned idx) {
+    constexpr T &at(unsigned idx) {
         assert_idx(idx);
         return m_data[idx];
     }
@@ -220,7 +334,7 @@ public:
      * @return The first element.
      * @attention Only for size >= 1.
      */
-    T x() const {
+    constexpr T x() const {
         static_assert(N >= 1 && "x() not supported for vectors with size 0");
         return m_data[0];
     }
@@ -230,7 +344,7 @@ public:
      * @return The first element.
      * @attention Only for size >= 1.
      */
-    T &x() {
+    constexpr T &x() {
         static_assert(N >= 1 && "x() not supported for vectors with size 0");
         return m_data[0];
     }
@@ -240,7 +354,7 @@ public:
      * @return The second element.
      * @attention Only for size >= 2.
      */
-    T y() const {
+    constexpr T y() const {
         static_assert(N >= 2 && "y() not supported for vectors with size 1 or less");
         return m_data[1];
     }
@@ -250,7 +364,7 @@ public:
      * @return The second element.
      * @attention Only for size >= 2.
      */
-    T &y() {
+    constexpr T &y() {
         static_assert(N >= 2 && "y() not supported for vectors with size 1 or less");
         return m_data[1];
     }
@@ -260,7 +374,7 @@ public:
      * @return The third element.
      * @attention Only for size >= 3.
      */
-    T z() const {
+    constexpr T z() const {
         static_assert(N >= 3 && "z() not supported for vectors with size 2 or less");
         return m_data[2];
     }
@@ -270,17 +384,34 @@ public:
      * @return The third element.
      * @attention Only for size >= 3.
      */
-    T &z() {
+    constexpr T &z() {
         static_assert(N >= 3 && "z() not supported for vectors with size 2 or less");
         return m_data[2];
     }
 
     /**
      * @brief Get the sum of this.
+     *
+     * Like dot() and squaredNorm(), float and double vectors are summed with several accumulators, and pairwise
+     * above mathlib::simd::pairwise_block values.
      * @return The sum of all values.
      */
-    T sum() const {
-        return std::accumulate(m_data, m_data + N, T(0.));
+    constexpr T sum() const {
+        if constexpr (mathlib::simd::supported<T> || N > mathlib::simd::pairwise_block) {
+            if (!MATHLIB_IS_CONSTANT_EVALUATED())
+                return mathlib::simd::sum<N>(m_data);
+        }
+        T ret(0.);
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { ret += m_data[i]; });
+        return ret;
+    }
+
+    /**
+     * @brief Get the sum of this with compensated summation.
+     * @return The sum of all values, about as accurate as a single rounding.
+     */
+    T sum(mathlib::Compensated) const {
+        return mathlib::simd::compensatedSum(m_data, N);
     }
 
     /**
@@ -288,10 +419,36 @@ public:
      * @param other The other vector.
      * @return The dot-product with other.
      */
-    T dot(const Vector &other) const {
+    constexpr T dot(const Vector &other) const {
+        if constexpr (mathlib::simd::supported<T> || N > mathlib::simd::pairwise_block) {
+            if (!MATHLIB_IS_CONSTANT_EVALUATED())
+                return mathlib::simd::dot<N>(m_data, other.m_data);
+        }
         T ret(0.);
-        for (unsigned i = 0; i < N; ++i)
-            ret += m_data[i] * other.m_data[i];
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { ret += m_data[i] * other.m_data[i]; });
+        return ret;
+    }
+
+    /**
+     * @brief Compute the dot-product with other, with compensated summation of the products.
+     * @param other The other vector.
+     * @return The dot-product with other.
+     */
+    T dot(const Vector &other, mathlib::Compensated) const {
+        return mathlib::simd::compensatedDot(m_data, other.m_data, N);
+    }
+
+    /**
+     * @brief Compute the dot-product with an expression, e.g. a view.
+     * @tparam E The expression type.
+     * @param expression The expression.
+     * @return The dot-product with expression.
+     */
+    template <typename E>
+    constexpr T dot(const VectorExpression<E, N, T> &expression) const {
+        const E &e = expression.derived();
+        T ret(0.);
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { ret += m_data[i] * e[i]; });
         return ret;
     }
 
@@ -301,7 +458,7 @@ public:
      * @return The cross product of this and other.
      * @attention Only for size 3!
      */
-    Vector cross(const Vector &other) const {
+    constexpr Vector cross(const Vector &other) const {
         static_assert(N == 3 && "cross is only defined for Vectors with size 3.");
         Vector ret;
         ret.x() = m_data[1] * other.z() - m_data[2] * other.y();
@@ -310,36 +467,51 @@ public:
         return ret;
     }
 
+    /**
+     * @brief Compute the cross product with an expression, e.g. a view.
+     * @tparam E The expression type.
+     * @param expression The expression.
+     * @return The cross product of this and expression.
+     * @attention Only for size 3!
+     */
+    template <typename E>
+    constexpr Vector cross(const VectorExpression<E, N, T> &expression) const {
+        static_assert(N == 3 && "cross is only defined for Vectors with size 3.");
+        const E &e = expression.derived();
+        const T ex = e[0], ey = e[1], ez = e[2];
+        return Vector(m_data[1] * ez - m_data[2] * ey, m_data[2] * ex - m_data[0] * ez, m_data[0] * ey - m_data[1] * ex);
+    }
+
     /**
      * @brief Compute the minimum value of this.
      * @return The minimum value of this.
      */
-    T min() const {
-        return *std::min_element(m_data, m_data + N);
+    constexpr T min() const {
+        return m_data[minIndex()];
     }
 
     /**
      * @brief Compute the maximum value of this.
      * @return The maximum value of this.
      */
-    T max() const {
-        return *std::max_element(m_data, m_data + N);
+    constexpr T max() const {
+        return m_data[maxIndex()];
     }
 
     /**
      * @brief Get a reference to the minimum value of this.
      * @return The reference to the minimum value of this.
      */
-    T &minCoeff() {
-        return *std::min_element(m_data, m_data + N);
+    constexpr T &minCoeff() {
+        return m_data[minIndex()];
     }
 
     /**
      * @brief Get a reference to the maximum value of this.
      * @return The reference to the maximum value of this.
      */
-    T &maxCoeff() {
-        return *std::max_element(m_data, m_data + N);
+    constexpr T &maxCoeff() {
+        return m_data[maxIndex()];
     }
 
     /**
@@ -347,9 +519,14 @@ public:
      * @param other The other vector.
      * @return A reference to this vector, with this + other.
      */
-    Vector &operator+=(const Vector &other) {
-        for (unsigned i = 0; i < N; ++i)
-            m_data[i] += other.m_data[i];
+    constexpr Vector &operator+=(const Vector &other) {
+        if constexpr (mathlib::simd::supported<T>) {
+            if (!MATHLIB_IS_CONSTANT_EVALUATED()) {
+                mathlib::simd::apply<N, mathlib::simd::AddOp>(m_data, other.m_data);
+                return *this;
+            }
+        }
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] += other.m_data[i]; });
         return *this;
     }
 
@@ -358,9 +535,14 @@ public:
      * @param other The other vector.
      * @return A reference to this vector, with this - other.
      */
-    Vector &operator-=(const Vector &other) {
-        for (unsigned i = 0; i < N; ++i)
-            m_data[i] -= other.m_data[i];
+    constexpr Vector &operator-=(const Vector &other) {
+        if constexpr (mathlib::simd::supported<T>) {
+            if (!MATHLIB_IS_CONSTANT_EVALUATED()) {
+                mathlib::simd::apply<N, mathlib::simd::SubOp>(m_data, other.m_data);
+                return *this;
+            }
+        }
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] -= other.m_data[i]; });
         return *this;
     }
 
@@ -369,9 +551,14 @@ public:
      * @param other The other vector.
      * @return A reference to this vector, with this * other.
      */
-    Vector &operator*=(const Vector &other) {
-        for (unsigned i = 0; i < N; ++i)
-            m_data[i] *= other.m_data[i];
+    constexpr Vector &operator*=(const Vector &other) {
+        if constexpr (mathlib::simd::supported<T>) {
+            if (!MATHLIB_IS_CONSTANT_EVALUATED()) {
+                mathlib::simd::apply<N, mathlib::simd::MulOp>(m_data, other.m_data);
+                return *this;
+            }
+        }
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] *= other.m_data[i]; });
         return *this;
     }
 
@@ -381,107 +568,166 @@ public:
      * @return A reference to this vector, with this / other.
      * @attention Only for floating point types.
      */
-    Vector &operator/=(const Vector &other) {
+    constexpr Vector &operator/=(const Vector &other) {
         static_assert(std::is_floating_point<T>::value, "base type is not floating point.");
-        for (unsigned i = 0; i < N; ++i)
-            m_data[i] /= other.m_data[i];
+        if constexpr (mathlib::simd::supported<T>) {
+            if (!MATHLIB_IS_CONSTANT_EVALUATED()) {
+                mathlib::simd::apply<N, mathlib::simd::DivOp>(m_data, other.m_data);
+                return *this;
+            }
+        }
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] /= other.m_data[i]; });
         return *this;
     }
 
     /**
-     * @brief Multiply this vector by a scalar
-     * @param value The scalar
-     * @return A new vector with this * value.
+     * @brief Add an expression to this.
+     * @tparam E The expression type.
+     * @param expression The expression.
+     * @return A reference to this vector, with this + expression.
      */
-    Vector operator*(const T &value) const {
-        Vector ret;
-        for (unsigned i = 0; i < N; ++i)
-            ret.m_data[i] = m_data[i] * value;
-        return ret;
+    template <typename E>
+    constexpr Vector &operator+=(const VectorExpression<E, N, T> &expression) {
+        const E &e = expression.derived();
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] += e[i]; });
+        return *this;
     }
 
     /**
-     * @brief Add a scalar to this vector
-     * @param value The scalar
-     * @return A new vector with this + value.
+     * @brief Subtract an expression from this.
+     * @tparam E The expression type.
+     * @param expression The expression.
+     * @return A reference to this vector, with this - expression.
      */
-    Vector operator+(const T &value) const {
-        Vector ret;
-        for (unsigned i = 0; i < N; ++i)
-            ret.m_data[i] = m_data[i] + value;
-        return ret;
+    template <typename E>
+    constexpr Vector &operator-=(const VectorExpression<E, N, T> &expression) {
+        const E &e = expression.derived();
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] -= e[i]; });
+        return *this;
     }
 
     /**
-     * @brief Subtract a scalar from this vector
-     * @param value The scalar
-     * @return A new vector with this - value.
+     * @brief Multiply an expression to this (element-wise).
+     * @tparam E The expression type.
+     * @param expression The expression.
+     * @return A reference to this vector, with this * expression.
      */
-    Vector operator-(const T &value) const {
-        Vector ret;
-        for (unsigned i = 0; i < N; ++i)
-            ret.m_data[i] = m_data[i] - value;
-        return ret;
+    template <typename E>
+    constexpr Vector &operator*=(const VectorExpression<E, N, T> &expression) {
+        const E &e = expression.derived();
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] *= e[i]; });
+        return *this;
     }
 
     /**
-     * @brief Divide this vector by a scalar
-     * @param value The scalar
-     * @return A new vector with this / value.
+     * @brief Divide this by an expression (element-wise).
+     * @tparam E The expression type.
+     * @param expression The expression.
+     * @return A reference to this vector, with this / expression.
      * @attention Only for floating point types.
      */
-    Vector operator/(const T &value) const {
+    template <typename E>
+    constexpr Vector &operator/=(const VectorExpression<E, N, T> &expression) {
         static_assert(std::is_floating_point<T>::value, "base type is not floating point.");
-        Vector ret;
-        for (unsigned i = 0; i < N; ++i)
-            ret.m_data[i] = m_data[i] / value;
-        return ret;
+        const E &e = expression.derived();
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] /= e[i]; });
+        return *this;
     }
 
     /**
      * @brief Get a variable length head.
      * @tparam n The number of elements.
-     * @return A copy of this with given length, taken from the head.
+     * @return A writable view of the first n elements of this.
      */
     template <unsigned n>
-    Vector<n, T> head() const {
-        static_assert(n <= N && "n > N");
-        Vector<n, T> ret;
-        for (unsigned i = 0; i < n; ++i) {
-            ret[i] = m_data[i];
-        }
-        return ret;
+    constexpr VectorView<n, T> head() & {
+        return segment<0, n>();
+    }
+
+    /**
+     * @brief Get a variable length head.
+     * @tparam n The number of elements.
+     * @return A read-only view of the first n elements of this.
+     */
+    template <unsigned n>
+    constexpr VectorView<n, const T> head() const & {
+        return segment<0, n>();
+    }
+
+    /**
+     * @brief Get a variable length head of a temporary.
+     * @tparam n The number of elements.
+     * @return A copy of the first n elements of this.
+     */
+    template <unsigned n>
+    constexpr Vector<n, T> head() && {
+        return segment<0, n>();
     }
 
     /**
      * @brief Get a variable length tail.
      * @tparam n The number of elements.
-     * @return A copy of this with given length, taken from the end.
+     * @return A writable view of the last n elements of this.
      */
     template <unsigned n>
-    Vector<n, T> tail() const {
-        static_assert(n <= N && "n > N");
-        Vector<n, T> ret;
-        for (unsigned i = 0; i < n; ++i) {
-            ret[i] = m_data[i + N - n];
-        }
-        return ret;
+    constexpr VectorView<n, T> tail() & {
+        return segment<N - n, n>();
+    }
+
+    /**
+     * @brief Get a variable length tail.
+     * @tparam n The number of elements.
+     * @return A read-only view of the last n elements of this.
+     */
+    template <unsigned n>
+    constexpr VectorView<n, const T> tail() const & {
+        return segment<N - n, n>();
+    }
+
+    /**
+     * @brief Get a variable length tail of a temporary.
+     * @tparam n The number of elements.
+     * @return A copy of the last n elements of this.
+     */
+    template <unsigned n>
+    constexpr Vector<n, T> tail() && {
+        return segment<N - n, n>();
     }
 
     /**
      * @brief Get a variable length segment.
      * @tparam s The start element idx.
      * @tparam n The number of elements.
-     * @return A copy of this with given length, starting at s.
+     * @return A writable view of n elements of this, starting at s.
      */
     template <unsigned s, unsigned n>
-    Vector<n, T> segment() const {
+    constexpr VectorView<n, T> segment() & {
         static_assert(n <= N && n + s <= N && "n > N or + s > N");
-        Vector<n, T> ret;
-        for (unsigned i = 0; i < n; ++i) {
-            ret[i] = m_data[i + s];
-        }
-        return ret;
+        return VectorView<n, T>(m_data + s);
+    }
+
+    /**
+     * @brief Get a variable length segment.
+     * @tparam s The start element idx.
+     * @tparam n The number of elements.
+     * @return A read-only view of n elements of this, starting at s.
+     */
+    template <unsigned s, unsigned n>
+    constexpr VectorView<n, const T> segment() const & {
+        static_assert(n <= N && n + s <= N && "n > N or + s > N");
+        return VectorView<n, const T>(m_data + s);
+    }
+
+    /**
+     * @brief Get a variable length segment of a temporary.
+     * @tparam s The start element idx.
+     * @tparam n The number of elements.
+     * @return A copy of n elements of this, starting at s.
+     */
+    template <unsigned s, unsigned n>
+    constexpr Vector<n, T> segment() && {
+        static_assert(n <= N && n + s <= N && "n > N or + s > N");
+        return Vector<n, T>(VectorView<n, const T>(m_data + s));
     }
 
     /**
@@ -509,7 +755,7 @@ public:
          */
         CommaLoader operator,(T value) {
             m_v.assert_idx(m_i);
-            m_v.at(m_i) = value;
+            m_v[m_i] = value;
             return CommaLoader(m_v, m_i + 1);
         }
     };
@@ -531,10 +777,9 @@ public:
      * @return A casted version of this to type S.
      */
     template <typename S>
-    Vector<N, S> cast() const {
+    constexpr Vector<N, S> cast() const {
         Vector<N, S> ret;
-        for (unsigned i = 0; i < N; ++i)
-            ret[i] = static_cast<S>(m_data[i]);
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { ret[i] = static_cast<S>(m_data[i]); });
         return ret;
     }
 
@@ -545,10 +790,9 @@ public:
      * @return True if the vectors are equal (floating-point comparison).
      */
     friend bool operator==(const Vector<N, T> &lhs, const Vector<N, T> &rhs) {
-        for (unsigned i = 0; i < N; ++i)
-            if (fabs(lhs[i] - rhs[i]) > std::numeric_limits<double>::epsilon())
-                return false;
-        return true;
+        bool ret = true;
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { ret &= !(fabs(lhs[i] - rhs[i]) > std::numeric_limits<double>::epsilon()); });
+        return ret;
     }
 
     /**
@@ -608,13 +852,120 @@ private:
      * @param idx The index.
      * @throws std::runtime_error If index is out of range.
      */
-    void assert_idx(unsigned idx) const {
+    constexpr void assert_idx(unsigned idx) const {
         if (idx >= N)
             throw std::runtime_error("idx >= N");
     }
 
+    /**
+     * @brief Find the first minimum value.
+     * @return The index of the minimum value.
+     */
+    constexpr unsigned minIndex() const {
+        unsigned ret = 0;
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA {
+            if (m_data[i] < m_data[ret])
+                ret = i;
+        });
+        return ret;
+    }
+
+    /**
+     * @brief Find the first maximum value.
+     * @return The index of the maximum value.
+     */
+    constexpr unsigned maxIndex() const {
+        unsigned ret = 0;
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA {
+            if (m_data[ret] < m_data[i])
+                ret = i;
+        });
+        return ret;
+    }
+
 private:
     T m_data[N];  ///< The underlying data.
 };
 
+namespace mathlib {
+
+/**
+ * @brief Mix the bits of a 64 bit value (finalizer of splitmix64).
+ * @param x The value.
+ * @return The mixed value, every input bit affects every output bit.
+ */
+constexpr std::uint64_t hashMix(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+/**
+ * @brief Hash a vector of integers.
+ * @tparam N The size of the vector.
+ * @tparam T The underlying data type, integral.
+ * @param v The vector.
+ * @return The hash value.
+ */
+template <unsigned N, typename T>
+constexpr std::uint64_t hashValue(const Vector<N, T> &v) {
+    static_assert(std::is_integral<T>::value, "only vectors of integral types can be hashed.");
+    std::uint64_t ret = N;
+    mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { ret = hashMix(ret + 0x9e3779b97f4a7c15ull + std::uint64_t(v[i])); });
+    return ret;
+}
+
+namespace detail {
+
+/**
+ * @brief Base of std::hash for vectors of integral types.
+ * @tparam N The size of the vector.
+ * @tparam T The underlying data type.
+ * @tparam Enabled Whether T is integral.
+ */
+template <unsigned N, typename T, bool Enabled = std::is_integral<T>::value>
+struct VectorHash {
+    /**
+     * @brief Hash a vector.
+     * @param v The vector.
+     * @return The hash value.
+     */
+    std::size_t operator()(const Vector<N, T> &v) const noexcept {
+        return std::size_t(mathlib::hashValue(v));
+    }
+};
+
+/**
+ * @brief Disabled hash of vectors of non-integral types, as std::hash of an unsupported type.
+ * @tparam N The size of the vector.
+ * @tparam T The underlying data type.
+ */
+template <unsigned N, typename T>
+struct VectorHash<N, T, false> {
+    VectorHash() = delete;
+    VectorHash(const VectorHash &) = delete;
+    VectorHash &operator=(const VectorHash &) = delete;
+};
+
+}  // namespace detail
+
+}  // namespace mathlib
+
+namespace std {
+
+/**
+ * @brief Hash for vectors of integral types, e.g. voxel coordinates as keys of std::unordered_map.
+ *
+ * Disabled for other types: std::hash<Vector3d> is neither constructible nor callable.
+ * @tparam N The size of the vector.
+ * @tparam T The underlying data type.
+ */
+template <unsigned N, typename T>
+struct hash<Vector<N, T>> : mathlib::detail::VectorHash<N, T> {};
+
+}  // namespace std
+
 #endif /* __MATHLIB_VECTOR_H__ */
\ No newline at end of file
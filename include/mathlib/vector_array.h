@@ -0,0 +1,584 @@
+#ifndef __MATHLIB_VECTOR_ARRAY_H__
+#define __MATHLIB_VECTOR_ARRAY_H__
+
+#include <mathlib/memory.h>
+#include <mathlib/vector.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief Array of vectors in a structure-of-arrays layout.
+ *
+ * Each component is stored in its own contiguous, cache line aligned array.
+ * The bulk operations mirror the members of Vector, but run over all elements at once,
+ * which lets the compiler vectorize across elements.
+ * @tparam N The size of the vectors.
+ * @tparam T The underlying data type of the vectors.
+ */
+template <unsigned N, typename T>
+class VectorArray {
+public:
+    using type = T;                                         ///< The underlying data type.
+    using Vector_t = Vector<N, T>;                          ///< The element type.
+    using Storage_t = std::vector<T, AlignedAllocator<T>>;  ///< The storage of a single component.
+
+    /**
+     * @brief Proxy for write access to a single element.
+     */
+    class Reference {
+    public:
+        /**
+         * @brief Create a proxy for an element.
+         * @param array The array.
+         * @param idx The index of the element.
+         */
+        Reference(VectorArray &array, std::size_t idx) : m_array(array), m_idx(idx) {}
+
+        /**
+         * @brief Gather the element into a vector.
+         * @return The element.
+         */
+        operator Vector_t() const {
+            return m_array.get(m_idx);
+        }
+
+        /**
+         * @brief Scatter a vector into the element.
+         * @param v The new value.
+         * @return A reference to this proxy.
+         */
+        Reference &operator=(const Vector_t &v) {
+            m_array.set(m_idx, v);
+            return *this;
+        }
+
+        /**
+         * @brief Write access to a single component of the element.
+         * @param c The component (0-indexed).
+         * @return The component.
+         */
+        T &operator[](unsigned c) {
+            return m_array.m_data[c][m_idx];
+        }
+
+    private:
+        VectorArray &m_array;  ///< The array.
+        std::size_t m_idx;     ///< The index of the element.
+    };
+
+    /**
+     * @brief The size of the stored vectors.
+     * @return The size.
+     */
+    constexpr static unsigned dimension() {
+        return N;
+    }
+
+    /**
+     * @brief Create an empty array.
+     */
+    VectorArray() = default;
+
+    /**
+     * @brief Create an array of count copies of value.
+     * @param count The number of elements.
+     * @param value The value of all elements.
+     */
+    explicit VectorArray(std::size_t count, const Vector_t &value = Vector_t()) {
+        for (unsigned c = 0; c < N; ++c)
+            m_data[c].assign(count, value[c]);
+    }
+
+    /**
+     * @brief Create an array from contiguous vectors.
+     * @param data The vectors.
+     * @param count The number of vectors.
+     */
+    VectorArray(const Vector_t *data, std::size_t count) {
+        resize(count);
+        for (std::size_t i = 0; i < count; ++i)
+            set(i, data[i]);
+    }
+
+    /**
+     * @brief Create an array from given vectors.
+     * @param data The vectors.
+     */
+    VectorArray(const std::vector<Vector_t> &data) : VectorArray(data.data(), data.size()) {}
+
+    /**
+     * @brief The number of stored vectors.
+     * @return The number of vectors.
+     */
+    std::size_t size() const {
+        return m_data[0].size();
+    }
+
+    /**
+     * @brief Check if the array is empty.
+     * @return True if there are no elements.
+     */
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /**
+     * @brief Change the number of stored vectors.
+     * @param count The new number of vectors, new vectors are zero.
+     */
+    void resize(std::size_t count) {
+        for (unsigned c = 0; c < N; ++c)
+            m_data[c].resize(count, T(0.));
+    }
+
+    /**
+     * @brief Reserve memory for a number of vectors.
+     * @param count The number of vectors.
+     */
+    void reserve(std::size_t count) {
+        for (unsigned c = 0; c < N; ++c)
+            m_data[c].reserve(count);
+    }
+
+    /**
+     * @brief Remove all vectors.
+     */
+    void clear() {
+        for (unsigned c = 0; c < N; ++c)
+            m_data[c].clear();
+    }
+
+    /**
+     * @brief Append a vector.
+     * @param v The vector.
+     */
+    void push_back(const Vector_t &v) {
+        for (unsigned c = 0; c < N; ++c)
+            m_data[c].push_back(v[c]);
+    }
+
+    /**
+     * @brief Read access to a single element.
+     * @param idx The index of the element.
+     * @return A copy of the element.
+     */
+    Vector_t get(std::size_t idx) const {
+        Vector_t ret;
+        for (unsigned c = 0; c < N; ++c)
+            ret[c] = m_data[c][idx];
+        return ret;
+    }
+
+    /**
+     * @brief Write access to a single element.
+     * @param idx The index of the element.
+     * @param v The new value.
+     */
+    void set(std::size_t idx, const Vector_t &v) {
+        for (unsigned c = 0; c < N; ++c)
+            m_data[c][idx] = v[c];
+    }
+
+    /**
+     * @brief Read access to a single element.
+     * @param idx The index of the element.
+     * @return A copy of the element.
+     * @attention Does not perform index boundary checks.
+     */
+    Vector_t operator[](std::size_t idx) const {
+        return get(idx);
+    }
+
+    /**
+     * @brief Write access to a single element.
+     * @param idx The index of the element.
+     * @return A proxy for the element.
+     * @attention Does not perform index boundary checks.
+     */
+    Reference operator[](std::size_t idx) {
+        return Reference(*this, idx);
+    }
+
+    /**
+     * @brief Read access to the array of a single component.
+     * @param c The component (0-indexed).
+     * @return A pointer to size() values, aligned to a cache line.
+     */
+    const T *data(unsigned c) const {
+        return m_data[c].data();
+    }
+
+    /**
+     * @brief Write access to the array of a single component.
+     * @param c The component (0-indexed).
+     * @return A pointer to size() values, aligned to a cache line.
+     */
+    T *data(unsigned c) {
+        return m_data[c].data();
+    }
+
+    /**
+     * @brief Copy all elements to contiguous vectors.
+     * @param out The output, must hold size() vectors.
+     */
+    void toVectors(Vector_t *out) const {
+        for (std::size_t i = 0; i < size(); ++i)
+            out[i] = get(i);
+    }
+
+    /**
+     * @brief Copy all elements to contiguous vectors.
+     * @return The vectors.
+     */
+    std::vector<Vector_t> toVectors() const {
+        std::vector<Vector_t> ret(size());
+        toVectors(ret.data());
+        return ret;
+    }
+
+    /**
+     * @brief Compute the dot-products with other, element by element.
+     * @param other The other array, same size as this.
+     * @param result The output, must hold size() values.
+     */
+    void dot(const VectorArray &other, T *result) const {
+        assert(other.size() == size());
+        const std::size_t n = size();
+        const T *a = m_data[0].data();
+        const T *b = other.m_data[0].data();
+        for (std::size_t i = 0; i < n; ++i)
+            result[i] = a[i] * b[i];
+        for (unsigned c = 1; c < N; ++c) {
+            a = m_data[c].data();
+            b = other.m_data[c].data();
+            for (std::size_t i = 0; i < n; ++i)
+                result[i] += a[i] * b[i];
+        }
+    }
+
+    /**
+     * @brief Compute the dot-products with other, element by element.
+     * @param other The other array, same size as this.
+     * @return The dot-products.
+     */
+    std::vector<T> dot(const VectorArray &other) const {
+        std::vector<T> ret(size());
+        dot(other, ret.data());
+        return ret;
+    }
+
+    /**
+     * @brief Compute the squared euclidian norm of all elements.
+     * @param result The output, must hold size() values.
+     */
+    void squaredNorm(T *result) const {
+        dot(*this, result);
+    }
+
+    /**
+     * @brief Compute the squared euclidian norm of all elements.
+     * @return The squared norms.
+     */
+    std::vector<T> squaredNorm() const {
+        return dot(*this);
+    }
+
+    /**
+     * @brief Compute the euclidian norm of all elements.
+     * @param result The output, must hold size() values.
+     * @attention Only for floating point types.
+     */
+    void norm(T *result) const {
+        static_assert(std::is_floating_point<T>::value, "base type is not floating point.");
+        squaredNorm(result);
+        const std::size_t n = size();
+        for (std::size_t i = 0; i < n; ++i)
+            result[i] = std::sqrt(result[i]);
+    }
+
+    /**
+     * @brief Compute the euclidian norm of all elements.
+     * @return The norms.
+     * @attention Only for floating point types.
+     */
+    std::vector<T> norm() const {
+        std::vector<T> ret(size());
+        norm(ret.data());
+        return ret;
+    }
+
+    /**
+     * @brief Compute the cross products with other, element by element.
+     * @param other The other array, same size as this.
+     * @return The cross products.
+     * @attention Only for size 3!
+     */
+    VectorArray cross(const VectorArray &other) const {
+        static_assert(N == 3 && "cross is only defined for Vectors with size 3.");
+        assert(other.size() == size());
+        const std::size_t n = size();
+        VectorArray ret(n);
+        const T *ax = data(0), *ay = data(1), *az = data(2);
+        const T *bx = other.data(0), *by = other.data(1), *bz = other.data(2);
+        T *rx = ret.data(0), *ry = ret.data(1), *rz = ret.data(2);
+        for (std::size_t i = 0; i < n; ++i) {
+            rx[i] = ay[i] * bz[i] - az[i] * by[i];
+            ry[i] = az[i] * bx[i] - ax[i] * bz[i];
+            rz[i] = ax[i] * by[i] - ay[i] * bx[i];
+        }
+        return ret;
+    }
+
+    /**
+     * @brief Normalize all elements.
+     *
+     * Uses the same safe norm as Vector::normalize.
+     * @attention Only for floating point types.
+     */
+    void normalize() {
+        static_assert(std::is_floating_point<T>::value, "base type is not floating point.");
+        const std::size_t n = size();
+        std::vector<T> inv_norm(n);
+        squaredNorm(inv_norm.data());
+        for (std::size_t i = 0; i < n; ++i)
+            inv_norm[i] = T(1.0) / std::sqrt(inv_norm[i] + std::numeric_limits<T>::epsilon());
+        for (unsigned c = 0; c < N; ++c) {
+            T *a = m_data[c].data();
+            for (std::size_t i = 0; i < n; ++i)
+                a[i] *= inv_norm[i];
+        }
+    }
+
+    /**
+     * @brief Return a normalized copy of this.
+     * @return The normalized copy.
+     * @attention Only for floating point types.
+     */
+    VectorArray normalized() const {
+        VectorArray ret(*this);
+        ret.normalize();
+        return ret;
+    }
+
+    /**
+     * @brief Compute the minimum value of all elements.
+     * @param result The output, must hold size() values.
+     */
+    void min(T *result) const {
+        const std::size_t n = size();
+        std::copy(m_data[0].begin(), m_data[0].end(), result);
+        for (unsigned c = 1; c < N; ++c) {
+            const T *a = m_data[c].data();
+            for (std::size_t i = 0; i < n; ++i)
+                result[i] = a[i] < result[i] ? a[i] : result[i];
+        }
+    }
+
+    /**
+     * @brief Compute the minimum value of all elements.
+     * @return The minimum values.
+     */
+    std::vector<T> min() const {
+        std::vector<T> ret(size());
+        min(ret.data());
+        return ret;
+    }
+
+    /**
+     * @brief Compute the maximum value of all elements.
+     * @param result The output, must hold size() values.
+     */
+    void max(T *result) const {
+        const std::size_t n = size();
+        std::copy(m_data[0].begin(), m_data[0].end(), result);
+        for (unsigned c = 1; c < N; ++c) {
+            const T *a = m_data[c].data();
+            for (std::size_t i = 0; i < n; ++i)
+                result[i] = a[i] > result[i] ? a[i] : result[i];
+        }
+    }
+
+    /**
+     * @brief Compute the maximum value of all elements.
+     * @return The maximum values.
+     */
+    std::vector<T> max() const {
+        std::vector<T> ret(size());
+        max(ret.data());
+        return ret;
+    }
+
+    /**
+     * @brief Add another array to this, element by element.
+     * @param other The other array, same size as this.
+     * @return A reference to this.
+     */
+    VectorArray &operator+=(const VectorArray &other) {
+        return apply(other, [](T &a, const T &b) { a += b; });
+    }
+
+    /**
+     * @brief Subtract another array from this, element by element.
+     * @param other The other array, same size as this.
+     * @return A reference to this.
+     */
+    VectorArray &operator-=(const VectorArray &other) {
+        return apply(other, [](T &a, const T &b) { a -= b; });
+    }
+
+    /**
+     * @brief Multiply another array to this, element by element (and element-wise).
+     * @param other The other array, same size as this.
+     * @return A reference to this.
+     */
+    VectorArray &operator*=(const VectorArray &other) {
+        return apply(other, [](T &a, const T &b) { a *= b; });
+    }
+
+    /**
+     * @brief Divide this by another array, element by element (and element-wise).
+     * @param other The other array, same size as this.
+     * @return A reference to this.
+     * @attention Only for floating point types.
+     */
+    VectorArray &operator/=(const VectorArray &other) {
+        static_assert(std::is_floating_point<T>::value, "base type is not floating point.");
+        return apply(other, [](T &a, const T &b) { a /= b; });
+    }
+
+    /**
+     * @brief Add a vector to all elements.
+     * @param v The vector.
+     * @return A reference to this.
+     */
+    VectorArray &operator+=(const Vector_t &v) {
+        return apply(v, [](T &a, const T &b) { a += b; });
+    }
+
+    /**
+     * @brief Subtract a vector from all elements.
+     * @param v The vector.
+     * @return A reference to this.
+     */
+    VectorArray &operator-=(const Vector_t &v) {
+        return apply(v, [](T &a, const T &b) { a -= b; });
+    }
+
+    /**
+     * @brief Multiply all elements with a vector (element-wise).
+     * @param v The vector.
+     * @return A reference to this.
+     */
+    VectorArray &operator*=(const Vector_t &v) {
+        return apply(v, [](T &a, const T &b) { a *= b; });
+    }
+
+    /**
+     * @brief Divide all elements by a vector (element-wise).
+     * @param v The vector.
+     * @return A reference to this.
+     * @attention Only for floating point types.
+     */
+    VectorArray &operator/=(const Vector_t &v) {
+        static_assert(std::is_floating_point<T>::value, "base type is not floating point.");
+        return apply(v, [](T &a, const T &b) { a /= b; });
+    }
+
+    /**
+     * @brief Add a scalar to all elements.
+     * @param value The scalar.
+     * @return A reference to this.
+     */
+    VectorArray &operator+=(const T &value) {
+        return apply(Vector_t(value), [](T &a, const T &b) { a += b; });
+    }
+
+    /**
+     * @brief Subtract a scalar from all elements.
+     * @param value The scalar.
+     * @return A reference to this.
+     */
+    VectorArray &operator-=(const T &value) {
+        return apply(Vector_t(value), [](T &a, const T &b) { a -= b; });
+    }
+
+    /**
+     * @brief Multiply all elements by a scalar.
+     * @param value The scalar.
+     * @return A reference to this.
+     */
+    VectorArray &operator*=(const T &value) {
+        return apply(Vector_t(value), [](T &a, const T &b) { a *= b; });
+    }
+
+    /**
+     * @brief Divide all elements by a scalar.
+     * @param value The scalar.
+     * @return A reference to this.
+     * @attention Only for floating point types.
+     */
+    VectorArray &operator/=(const T &value) {
+        static_assert(std::is_floating_point<T>::value, "base type is not floating point.");
+        return apply(Vector_t(value), [](T &a, const T &b) { a /= b; });
+    }
+
+private:
+    /**
+     * @brief Apply an operation component by component with another array.
+     * @param other The other array, same size as this.
+     * @param op The operation, called as op(this[i][c], other[i][c]).
+     * @return A reference to this.
+     */
+    template <typename Op>
+    VectorArray &apply(const VectorArray &other, Op op) {
+        assert(other.size() == size());
+        const std::size_t n = size();
+        for (unsigned c = 0; c < N; ++c) {
+            T *a = m_data[c].data();
+            const T *b = other.m_data[c].data();
+            for (std::size_t i = 0; i < n; ++i)
+                op(a[i], b[i]);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Apply an operation component by component with a single vector.
+     * @param v The vector.
+     * @param op The operation, called as op(this[i][c], v[c]).
+     * @return A reference to this.
+     */
+    template <typename Op>
+    VectorArray &apply(const Vector_t &v, Op op) {
+        const std::size_t n = size();
+        for (unsigned c = 0; c < N; ++c) {
+            T *a = m_data[c].data();
+            const T b = v[c];
+            for (std::size_t i = 0; i < n; ++i)
+                op(a[i], b);
+        }
+        return *this;
+    }
+
+private:
+    std::array<Storage_t, N> m_data;  ///< One array per component.
+};
+
+/**
+ * @name Defines
+ * @brief Underlying data type definitions.
+ */
+/** @{ */
+using VectorArray2f = VectorArray<2, float>;
+using VectorArray3f = VectorArray<3, float>;
+using VectorArray2d = VectorArray<2, double>;
+using VectorArray3d = VectorArray<3, double>;
+/** @} */
+
+#endif /* __MATHLIB_VECTOR_ARRAY_H__ */
@@ -0,0 +1,284 @@
+#ifndef __MATHLIB_VECTOR_VIEW_H__
+#define __MATHLIB_VECTOR_VIEW_H__
+
+#include <mathlib/expression.h>
+#include <mathlib/unroll.h>
+
+#include <cmath>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+
+/**
+ * @brief A fixed-size view into the storage of another vector.
+ *
+ * Returned by Vector::head(), Vector::tail(), Vector::segment() and Quaternion::vec(). Reads and writes go
+ * directly to the referenced values, and the view takes part in expressions like a Vector, so no copy is made.
+ * @tparam N The size of the view.
+ * @tparam T The underlying data type, const qualified for read-only views.
+ * @attention A view references the vector it was taken from. Do not use it beyond the lifetime of that vector,
+ * use eval() to get a copy instead.
+ */
+template <unsigned N, typename T>
+class VectorView : public VectorExpression<VectorView<N, T>, N, typename std::remove_const<T>::type> {
+public:
+    using type = typename std::remove_const<T>::type;  ///< The underlying data type.
+
+    /**
+     * @brief Create a view of N values.
+     * @param data The first value.
+     */
+    constexpr explicit VectorView(T *data) : m_data(data) {}
+
+    /**
+     * @brief Create a view referencing the same values as other.
+     * @param other The other view.
+     */
+    constexpr VectorView(const VectorView &other) = default;
+
+    /**
+     * @brief Create a read-only view from a writable one.
+     * @tparam S The type of the other view.
+     * @param other The other view.
+     */
+    template <typename S, typename std::enable_if<std::is_same<const S, T>::value && !std::is_same<S, T>::value>::type * = nullptr>
+    constexpr VectorView(const VectorView<N, S> &other) : m_data(other.data()) {}
+
+    /**
+     * @brief Copy the values of another view into the referenced values.
+     * @param other The other view.
+     * @return A reference to this view.
+     */
+    constexpr VectorView &operator=(const VectorView &other) {
+        return assign(other);
+    }
+
+    /**
+     * @brief Evaluate an expression into the referenced values.
+     * @tparam E The expression type.
+     * @param expression The expression to evaluate.
+     * @return A reference to this view.
+     * @attention The expression is evaluated element by element, so it must not read values of the
+     * referenced vector that precede the ones it writes.
+     */
+    template <typename E>
+    constexpr VectorView &operator=(const VectorExpression<E, N, type> &expression) {
+        return assign(expression.derived());
+    }
+
+    /**
+     * @brief Access to idx.
+     * @param idx The index to access (0-indexed).
+     * @return The value at idx.
+     * @attention Does not perform index boundary checks.
+     */
+    MATHLIB_ALWAYS_INLINE constexpr T &operator[](unsigned idx) const {
+        return m_data[idx];
+    }
+
+    /**
+     * @brief Access to idx.
+     * @param idx The index to access (0-indexed).
+     * @return The value at idx.
+     * @attention Does not perform index boundary checks.
+     */
+    constexpr T &operator()(unsigned idx) const {
+        return m_data[idx];
+    }
+
+    /**
+     * @brief Helper to access the first element.
+     * @return The first element.
+     * @attention Only for size >= 1.
+     */
+    constexpr T &x() const {
+        static_assert(N >= 1 && "x() not supported for views with size 0");
+        return m_data[0];
+    }
+
+    /**
+     * @brief Helper to access the second element.
+     * @return The second element.
+     * @attention Only for size >= 2.
+     */
+    constexpr T &y() const {
+        static_assert(N >= 2 && "y() not supported for views with size 1 or less");
+        return m_data[1];
+    }
+
+    /**
+     * @brief Helper to access the third element.
+     * @return The third element.
+     * @attention Only for size >= 3.
+     */
+    constexpr T &z() const {
+        static_assert(N >= 3 && "z() not supported for views with size 2 or less");
+        return m_data[2];
+    }
+
+    /**
+     * @brief Access the referenced values.
+     * @return A pointer to the first value.
+     */
+    constexpr T *data() const {
+        return m_data;
+    }
+
+    /**
+     * @brief Compute the dot-product with an expression.
+     * @tparam E The expression type.
+     * @param expression The expression.
+     * @return The dot-product with expression.
+     */
+    template <typename E>
+    constexpr type dot(const VectorExpression<E, N, type> &expression) const {
+        const E &e = expression.derived();
+        type ret(0.);
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { ret += m_data[i] * e[i]; });
+        return ret;
+    }
+
+    /**
+     * @brief Compute the cross product with an expression.
+     * @tparam E The expression type.
+     * @param expression The expression.
+     * @return The cross product of this and expression.
+     * @attention Only for size 3!
+     */
+    template <typename E>
+    constexpr Vector<3, type> cross(const VectorExpression<E, N, type> &expression) const {
+        static_assert(N == 3 && "cross is only defined for views with size 3.");
+        const E &e = expression.derived();
+        const type ex = e[0], ey = e[1], ez = e[2];
+        return Vector<3, type>(m_data[1] * ez - m_data[2] * ey, m_data[2] * ex - m_data[0] * ez, m_data[0] * ey - m_data[1] * ex);
+    }
+
+    /**
+     * @brief The squared euclidian norm.
+     * @return The norm \f$ || v ||_2^2 \f$
+     */
+    constexpr type squaredNorm() const {
+        return dot(*this);
+    }
+
+    /**
+     * @brief The euclidian norm.
+     * @return The norm \f$ || v ||_2 \f$
+     * @attention Only for floating point types.
+     */
+    type norm() const {
+        static_assert(std::is_floating_point<type>::value, "base type is not floating point.");
+        return std::sqrt(squaredNorm());
+    }
+
+    /**
+     * @brief Return a normalized copy of the referenced values.
+     * @return The normalized copy.
+     * @attention Only for floating point types.
+     */
+    Vector<N, type> normalized() const {
+        static_assert(std::is_floating_point<type>::value, "base type is not floating point.");
+        return *this * (type(1.0) / std::sqrt(squaredNorm() + std::numeric_limits<type>::epsilon()));
+    }
+
+    /**
+     * @brief Normalize the referenced values.
+     * @attention Only for floating point types.
+     */
+    void normalize() const {
+        static_assert(std::is_floating_point<type>::value, "base type is not floating point.");
+        *this *= type(1.0) / std::sqrt(squaredNorm() + std::numeric_limits<type>::epsilon());
+    }
+
+    /**
+     * @brief Add an expression to the referenced values.
+     * @tparam E The expression type.
+     * @param expression The expression.
+     * @return A reference to this view.
+     */
+    template <typename E>
+    constexpr const VectorView &operator+=(const VectorExpression<E, N, type> &expression) const {
+        const E &e = expression.derived();
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] += e[i]; });
+        return *this;
+    }
+
+    /**
+     * @brief Subtract an expression from the referenced values.
+     * @tparam E The expression type.
+     * @param expression The expression.
+     * @return A reference to this view.
+     */
+    template <typename E>
+    constexpr const VectorView &operator-=(const VectorExpression<E, N, type> &expression) const {
+        const E &e = expression.derived();
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] -= e[i]; });
+        return *this;
+    }
+
+    /**
+     * @brief Multiply the referenced values with a scalar.
+     * @param value The scalar.
+     * @return A reference to this view.
+     */
+    constexpr const VectorView &operator*=(const type &value) const {
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] *= value; });
+        return *this;
+    }
+
+    /**
+     * @brief Divide the referenced values by a scalar.
+     * @param value The scalar.
+     * @return A reference to this view.
+     * @attention Only for floating point types.
+     */
+    constexpr const VectorView &operator/=(const type &value) const {
+        static_assert(std::is_floating_point<type>::value, "base type is not floating point.");
+        return *this *= type(1.0) / value;
+    }
+
+    /**
+     * @brief Write the referenced values to a stream.
+     * @param os The stream.
+     * @param v The view.
+     * @return The stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const VectorView &v) {
+        for (unsigned i = 0; i < N; ++i) {
+            os << v[i];
+            if (i < N - 1)
+                os << " ";
+        }
+        return os;
+    }
+
+private:
+    /**
+     * @brief Evaluate an expression into the referenced values.
+     * @tparam E The expression type.
+     * @param e The expression.
+     * @return A reference to this view.
+     */
+    template <typename E>
+    constexpr VectorView &assign(const E &e) {
+        static_assert(!std::is_const<T>::value && "cannot assign to a read-only view.");
+        mathlib::detail::unroll<N>([&](unsigned i) MATHLIB_INLINE_LAMBDA { m_data[i] = e[i]; });
+        return *this;
+    }
+
+    T *m_data;  ///< The first referenced value.
+};
+
+namespace mathlib::detail {
+
+/**
+ * @brief Views are a single pointer and stored by value.
+ */
+template <unsigned N, typename T>
+struct ExpressionOperand<VectorView<N, T>> {
+    using type = const VectorView<N, T>;  ///< Views are stored by value.
+};
+
+}  // namespace mathlib::detail
+
+#endif /* __MATHLIB_VECTOR_VIEW_H__ */
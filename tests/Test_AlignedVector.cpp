@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <mathlib/aligned_vector.h>
+#include <mathlib/defines.h>
+#include <mathlib/operators.h>
+#include <mathlib/quaternion.h>
+
+#include <cstdint>
+#include <vector>
+
+TEST(AlignedVector, Layout) {
+    EXPECT_EQ(sizeof(AlignedVector3f), 16u);
+    EXPECT_EQ(alignof(AlignedVector3f), 16u);
+    EXPECT_EQ(sizeof(AlignedVector3d), 32u);
+    EXPECT_EQ(alignof(AlignedVector3d), 32u);
+    EXPECT_EQ(sizeof(AlignedVector4f), 16u);
+    EXPECT_EQ((sizeof(AlignedVector<5, float>)), 32u);
+    EXPECT_EQ((alignof(AlignedVector<16, double>)), 64u);
+
+    std::vector<AlignedVector3f> v(7, AlignedVector3f(1.f, 2.f, 3.f));
+    for (const AlignedVector3f &e : v) {
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&e) % 16, 0u);
+        EXPECT_EQ(e.data()[3], 0.f);
+    }
+}
+
+TEST(AlignedVector, Interop) {
+    const Vector3f a(1.f, -2.f, 3.f);
+    const AlignedVector3f b = a;
+    EXPECT_EQ(b.x(), 1.f);
+    EXPECT_EQ(b.y(), -2.f);
+    EXPECT_EQ(b.z(), 3.f);
+    EXPECT_EQ(b.vector(), a);
+
+    // Mixed expressions evaluate into either type.
+    const Vector3f c = a + b * 2.f;
+    const AlignedVector3f d = -b + a;
+    EXPECT_EQ(c, Vector3f(3.f, -6.f, 9.f));
+    EXPECT_EQ(d, AlignedVector3f(0.f));
+    EXPECT_EQ(d.data()[3], 0.f);
+
+    // Functions taking a Vector accept an AlignedVector.
+    const Quaternionf q(Vector3f(0.f, 0.f, 1.f), 1.5707963f);
+    const Vector3f r = q * Vector3f(b);
+    EXPECT_NEAR(r.x(), 2.f, 1e-6f);
+    EXPECT_NEAR(r.y(), 1.f, 1e-6f);
+    EXPECT_EQ(Vector3f(b).dot(a), a.dot(a));
+}
+
+TEST(AlignedVector, Arithmetic) {
+    AlignedVector3d a(1., 2., 3.), b(4., 5., 6.);
+    EXPECT_DOUBLE_EQ(a.dot(b), 32.);
+    EXPECT_DOUBLE_EQ(a.squaredNorm(), 14.);
+    EXPECT_DOUBLE_EQ(a.norm(), std::sqrt(14.));
+    EXPECT_EQ(a.cross(b), AlignedVector3d(-3., 6., -3.));
+
+    a += b;
+    EXPECT_EQ(a, AlignedVector3d(5., 7., 9.));
+    a -= b;
+    EXPECT_EQ(a, AlignedVector3d(1., 2., 3.));
+    a *= b;
+    EXPECT_EQ(a, AlignedVector3d(4., 10., 18.));
+    a /= b;
+    EXPECT_EQ(a, AlignedVector3d(1., 2., 3.));
+    a *= 2.;
+    EXPECT_EQ(a, AlignedVector3d(2., 4., 6.));
+    a /= 2.;
+    EXPECT_EQ(a, AlignedVector3d(1., 2., 3.));
+    for (unsigned i = 3; i < AlignedVector3d::padded; ++i)
+        EXPECT_EQ(a.data()[i], 0.);
+
+    EXPECT_NEAR(a.normalized().norm(), 1., 1e-12);
+    EXPECT_EQ(a.normalized().vector(), Vector3d(1., 2., 3.).normalized());
+
+    constexpr AlignedVector3f c(1.f, 2.f, 3.f);
+    static_assert(c.dot(c) == 14.f);
+}
+
+TEST(AlignedVector, Transform) {
+    const Matrix<3, 3, float> m = Quaternionf(Vector3f(1.f, 2.f, 3.f), 0.5f).toRotationMatrix();
+    std::vector<AlignedVector3f> in;
+    std::vector<Vector3f> expected;
+    for (int i = 0; i < 1000; ++i) {
+        const Vector3f v(float(i), float(i % 7) - 3.f, 0.5f * float(i % 11));
+        in.push_back(v);
+        expected.push_back(m * v);
+    }
+
+    std::vector<AlignedVector3f> out(in.size());
+    mathlib::transform(m, in.data(), out.data(), in.size());
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        for (unsigned c = 0; c < 3; ++c)
+            EXPECT_NEAR(out[i][c], expected[i][c], 1e-6f * (1.f + float(i)));
+        EXPECT_EQ(out[i].data()[3], 0.f);
+    }
+
+    mathlib::transform(m, in, 0);
+    for (std::size_t i = 0; i < in.size(); ++i)
+        EXPECT_EQ(in[i].vector(), out[i].vector());
+
+    const AlignedVector3f r = m * AlignedVector3f(1.f, 0.f, 0.f);
+    EXPECT_NEAR(r.x(), m(0, 0), 1e-7f);
+    EXPECT_NEAR(r.y(), m(1, 0), 1e-7f);
+    EXPECT_NEAR(r.z(), m(2, 0), 1e-7f);
+
+    const Matrix<4, 4, double> a = Matrix<4, 4, double>::Identity() * 2.;
+    const AlignedVector4d p = a * AlignedVector4d(1., 2., 3., 1.);
+    EXPECT_EQ(p, AlignedVector4d(2., 4., 6., 2.));
+}
@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include <mathlib/defines.h>
+#include <mathlib/operators.h>
+#include <mathlib/quaternion.h>
+#include <mathlib/vector.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace {
+
+std::atomic<bool> counting{false};
+std::atomic<std::size_t> allocations{0};
+
+/**
+ * @brief Count the heap allocations made while in scope.
+ */
+class AllocationCounter {
+public:
+    AllocationCounter() {
+        allocations = 0;
+        counting = true;
+    }
+
+    ~AllocationCounter() {
+        counting = false;
+    }
+
+    std::size_t count() const {
+        return allocations;
+    }
+};
+
+}  // namespace
+
+#if defined(_MSC_VER)
+#define TEST_NOINLINE __declspec(noinline)
+#else
+#define TEST_NOINLINE __attribute__((noinline))
+#endif
+
+namespace {
+
+/**
+ * @brief Allocate and count memory for all forms of operator new.
+ *
+ * Not inlined, so that the compiler does not pair the std::malloc with a replaced operator new and warn about
+ * mismatched allocation functions.
+ * @param size The size in bytes.
+ * @param alignment The alignment, at most the one of std::malloc for unaligned forms.
+ * @return The memory, or nullptr if out of memory.
+ */
+TEST_NOINLINE void *allocate(std::size_t size, std::size_t alignment) {
+    if (counting)
+        ++allocations;
+    if (alignment <= alignof(std::max_align_t))
+        return std::malloc(size ? size : 1);
+    // Over-aligned, the pointer returned by std::malloc is stored just before the memory.
+    void *raw = std::malloc(size + alignment + sizeof(void *));
+    if (!raw)
+        return nullptr;
+    const std::uintptr_t address = (reinterpret_cast<std::uintptr_t>(raw) + sizeof(void *) + alignment - 1) & ~std::uintptr_t(alignment - 1);
+    void *p = reinterpret_cast<void *>(address);
+    static_cast<void **>(p)[-1] = raw;
+    return p;
+}
+
+/**
+ * @brief Free memory for all forms of operator delete.
+ * @param p The memory from allocate().
+ * @param alignment The alignment it was allocated with.
+ */
+TEST_NOINLINE void deallocate(void *p, std::size_t alignment) noexcept {
+    if (p && alignment > alignof(std::max_align_t))
+        p = static_cast<void **>(p)[-1];
+    std::free(p);
+}
+
+void *allocateOrThrow(std::size_t size, std::size_t alignment) {
+    if (void *p = allocate(size, alignment))
+        return p;
+    throw std::bad_alloc();
+}
+
+}  // namespace
+
+void *operator new(std::size_t size) {
+    return allocateOrThrow(size, 0);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    return allocate(size, 0);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    return allocateOrThrow(size, std::size_t(alignment));
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return allocate(size, std::size_t(alignment));
+}
+
+void operator delete(void *p) noexcept {
+    deallocate(p, 0);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    deallocate(p, 0);
+}
+
+void operator delete(void *p, const std::nothrow_t &) noexcept {
+    deallocate(p, 0);
+}
+
+void operator delete(void *p, std::align_val_t alignment) noexcept {
+    deallocate(p, std::size_t(alignment));
+}
+
+void operator delete(void *p, std::size_t, std::align_val_t alignment) noexcept {
+    deallocate(p, std::size_t(alignment));
+}
+
+void operator delete(void *p, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    deallocate(p, std::size_t(alignment));
+}
+
+TEST(Allocation, Counter) {
+    struct alignas(64) CacheLine {
+        double values[8];
+    };
+
+    AllocationCounter counter;
+    std::vector<double> v(3);
+    EXPECT_EQ(counter.count(), 1u);
+    std::unique_ptr<CacheLine> line(new CacheLine());
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(line.get()) % 64, 0u);
+    std::unique_ptr<int> i(new (std::nothrow) int(1));
+    EXPECT_EQ(counter.count(), 3u);
+}
+
+TEST(Allocation, Vector) {
+    AllocationCounter counter;
+
+    Vector<6, double> a{1., 2., 3., 4., 5., 6.};
+    Vector<6, double> b(std::array<double, 6>{6., 5., 4., 3., 2., 1.});
+    Vector<6, double> c(1., 2., 3., 4., 5., 6.);
+    Vector3d d;
+    d << 1., 2., 3.;
+    Vector<6, double> e = a + b * 2. - c;
+    e.head<3>() += d;
+
+    EXPECT_EQ(counter.count(), 0u);
+    EXPECT_DOUBLE_EQ(e[0], 13.);
+}
+
+TEST(Allocation, Quaternion) {
+    AllocationCounter counter;
+
+    Quaterniond q1(0., 0., 1., 0.);
+    Quaterniond q2(Vector3d(1., 0., 0.), 0.5);
+    Quaterniond q3(std::array<double, 4>{0., 1., 0., 1.});
+    Quaterniond q4(Vector3d(1., 0., 0.), Vector3d(0., 1., 0.));
+    Quaterniond q5(q4.toRotationMatrix());
+    Quaterniond q6 = q1 * q2 * q3.inverse() * q5;
+    Vector3d r = q6 * Vector3d(1., 2., 3.);
+    r = q6.rotate(r, mathlib::fast);
+    Quaterniond q7 = q6.slerp(q2, 0.3);
+    const double angle = q7.angle() + q7.axis().x();
+
+    EXPECT_EQ(counter.count(), 0u);
+    EXPECT_TRUE(std::isfinite(angle + r.sum()));
+}
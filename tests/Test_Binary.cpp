@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <mathlib/binary.h>
+#include <mathlib/defines.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static std::string tempPath(const std::string &name) {
+    return ::testing::TempDir() + "mathlib_" + name;
+}
+
+TEST(Binary, RoundTrip) {
+    std::vector<Vector3f> v;
+    for (unsigned i = 0; i < 1000; ++i)
+        v.push_back(Vector3f(float(i), float(i) * 0.5f, -float(i)));
+    const std::string path = tempPath("vectors.bin");
+    mathlib::writeBinary(path, v);
+
+    std::vector<Vector3f> read = mathlib::readBinary<Vector3f>(path);
+    ASSERT_EQ(read.size(), v.size());
+    for (std::size_t i = 0; i < v.size(); ++i)
+        EXPECT_EQ(read[i], v[i]);
+
+    mathlib::MappedArray<Vector3f> mapped(path);
+    ASSERT_EQ(mapped.size(), v.size());
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(mapped.data()) % 64, 0u);
+    for (std::size_t i = 0; i < v.size(); ++i)
+        EXPECT_EQ(mapped[i], v[i]);
+
+    EXPECT_THROW(mathlib::readBinary<Vector3d>(path), std::runtime_error);
+    EXPECT_THROW(mathlib::MappedArray<Vector2f>{path}, std::runtime_error);
+    EXPECT_THROW(mathlib::MappedArray<Quaternion<float>>{path}, std::runtime_error);
+    EXPECT_THROW(mathlib::MappedArray<Vector3f>{tempPath("missing.bin")}, std::runtime_error);
+}
+
+TEST(Binary, Truncated) {
+    // A corrupt count larger than the file is reported, not allocated.
+    mathlib::BinaryHeader header = mathlib::detail::binaryHeader<Vector3f>(std::uint64_t(1) << 60);
+    const std::string path = tempPath("truncated.bin");
+    {
+        std::ofstream stream(path, std::ios::binary);
+        stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        const Vector3f v(1.f, 2.f, 3.f);
+        stream.write(reinterpret_cast<const char *>(&v), sizeof(v));
+    }
+    EXPECT_THROW(mathlib::readBinary<Vector3f>(path), std::runtime_error);
+    EXPECT_THROW(mathlib::MappedArray<Vector3f>{path}, std::runtime_error);
+
+    header.count = 1;
+    {
+        std::fstream stream(path, std::ios::binary | std::ios::in | std::ios::out);
+        stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    }
+    EXPECT_EQ(mathlib::readBinary<Vector3f>(path).size(), 1u);
+}
+
+TEST(Binary, Writer) {
+    const std::string path = tempPath("quaternions.bin");
+    {
+        mathlib::BinaryWriter<Quaternion<double>> writer(path);
+        for (unsigned i = 0; i < 10; ++i)
+            writer.write(Quaternion<double>(Vector3d(1., 2., 3.), 0.1 * i));
+        EXPECT_EQ(writer.count(), 10u);
+    }
+
+    mathlib::MappedArray<Quaternion<double>> mapped(path);
+    ASSERT_EQ(mapped.size(), 10u);
+    unsigned i = 0;
+    for (const Quaternion<double> &q : mapped)
+        EXPECT_EQ(q, Quaternion<double>(Vector3d(1., 2., 3.), 0.1 * i++));
+
+    mathlib::MappedArray<Quaternion<double>> moved(std::move(mapped));
+    EXPECT_EQ(moved.size(), 10u);
+    EXPECT_TRUE(mapped.empty());
+}
+
+TEST(Binary, ByteOrder) {
+    // Write a file in the opposite byte order by hand.
+    mathlib::BinaryHeader header{};
+    std::memcpy(header.magic, "MLBA", 4);
+    header.byte_order = 0x04030201;
+    header.dimension = 0x02000000;
+    header.version = 0x0100;
+    header.kind = 0;
+    header.scalar_kind = 'i';
+    header.count = std::uint64_t(3) << 56;
+    header.scalar_size = 4;
+    const std::int32_t values[6] = {0x01000000, 0x02000000, 0x03000000, 0x04000000, 0x05000000, 0x06000000};
+
+    const std::string path = tempPath("swapped.bin");
+    {
+        std::ofstream stream(path, std::ios::binary);
+        stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        stream.write(reinterpret_cast<const char *>(values), sizeof(values));
+    }
+
+    std::vector<Vector2i> read = mathlib::readBinary<Vector2i>(path);
+    ASSERT_EQ(read.size(), 3u);
+    EXPECT_EQ(read[2], Vector2i(5, 6));
+    EXPECT_THROW(mathlib::MappedArray<Vector2i>{path}, std::runtime_error);
+}
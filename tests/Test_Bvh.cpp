@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <mathlib/bvh.h>
+#include <mathlib/defines.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+template <typename T>
+static T noise(std::size_t i) {
+    return T(std::fmod(std::abs(std::sin(double(i)) * 43758.5453), 1.));
+}
+
+template <typename T>
+static std::vector<Triangle<T>> soup(std::size_t count, unsigned seed) {
+    std::vector<Triangle<T>> ret(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t k = (i + seed) * 11;
+        const Vector<3, T> center(noise<T>(k) * 10, noise<T>(k + 1) * 10, noise<T>(k + 2) * 10);
+        ret[i].v0 = center;
+        ret[i].v1 = center + Vector<3, T>(noise<T>(k + 3), noise<T>(k + 4), noise<T>(k + 5)) - T(.5);
+        ret[i].v2 = center + Vector<3, T>(noise<T>(k + 6), noise<T>(k + 7), noise<T>(k + 8)) - T(.5);
+    }
+    return ret;
+}
+
+template <typename T>
+static std::vector<Ray<T>> rays(std::size_t count, unsigned seed) {
+    std::vector<Ray<T>> ret;
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t k = (i + seed) * 5;
+        const Vector<3, T> origin(noise<T>(k) * 12 - 1, noise<T>(k + 1) * 12 - 1, T(-2));
+        const Vector<3, T> target(noise<T>(k + 2) * 10, noise<T>(k + 3) * 10, T(12));
+        ret.emplace_back(origin, target - origin);
+    }
+    return ret;
+}
+
+template <typename T>
+static RayHit<T> bruteForce(const std::vector<Triangle<T>> &triangles, Ray<T> ray) {
+    RayHit<T> ret;
+    for (std::size_t i = 0; i < triangles.size(); ++i) {
+        if (mathlib::intersect(ray, triangles[i], ret)) {
+            ret.index = std::uint32_t(i);
+            ray.t_max = ret.t;
+        }
+    }
+    return ret;
+}
+
+/**
+ * @brief Tolerance of hit parameters computed by different kernels or in different inlining contexts.
+ *
+ * FMA contraction differs between them. The error of t, u and v is a few ulps of the coordinates, which are bounded
+ * by the ray, amplified by the ratio of the coordinates to the triangle edges of about 0.5.
+ */
+template <typename T>
+static T tolerance(const Ray<T> &ray) {
+    return 32 * std::numeric_limits<T>::epsilon() * (ray.origin.norm() + ray.direction.norm());
+}
+
+TEST(Bvh, Empty) {
+    const Bvhf bvh;
+    EXPECT_TRUE(bvh.empty());
+    EXPECT_TRUE(bvh.bounds().empty());
+    EXPECT_FALSE(bvh.intersect(Rayf()).valid());
+    EXPECT_FALSE(bvh.occluded(Rayf()));
+
+    RayPacket4f packet;
+    HitPacket4f hits;
+    bvh.intersect(packet, hits);
+    EXPECT_EQ(hits.index[0], Bvhf::npos);
+}
+
+TEST(Bvh, Single) {
+    const std::vector<Triangled> triangles = soup<double>(3000, 1);
+    const Bvhd bvh(triangles);
+    EXPECT_EQ(bvh.size(), triangles.size());
+
+    unsigned found = 0;
+    for (const Rayd &ray : rays<double>(500, 3)) {
+        const RayHit<double> expected = bruteForce(triangles, ray);
+        const RayHit<double> hit = bvh.intersect(ray);
+        EXPECT_EQ(hit.index, expected.index);
+        EXPECT_NEAR(hit.t, expected.t, tolerance(ray));
+        EXPECT_NEAR(hit.u, expected.u, tolerance(ray));
+        EXPECT_NEAR(hit.v, expected.v, tolerance(ray));
+        EXPECT_EQ(bvh.occluded(ray), expected.valid());
+        found += expected.valid();
+    }
+    // The test must exercise hits and misses.
+    EXPECT_GT(found, 50u);
+    EXPECT_LT(found, 450u);
+}
+
+template <unsigned W>
+static void batched(const Bvhf &bvh, const std::vector<Trianglef> &triangles, const std::vector<Rayf> &r) {
+    std::vector<RayHit<float>> hits(r.size());
+    bvh.intersect<W>(r.data(), r.size(), hits.data(), 4);
+    for (std::size_t q = 0; q < r.size(); ++q) {
+        const RayHit<float> expected = bruteForce(triangles, r[q]);
+        EXPECT_EQ(hits[q].index, expected.index);
+        EXPECT_NEAR(hits[q].t, expected.t, tolerance(r[q]));
+        EXPECT_NEAR(hits[q].u, expected.u, tolerance(r[q]));
+        EXPECT_NEAR(hits[q].v, expected.v, tolerance(r[q]));
+    }
+}
+
+TEST(Bvh, Batched) {
+    const std::vector<Trianglef> triangles = soup<float>(5000, 2);
+    const std::vector<Rayf> r = rays<float>(1001, 4);
+    for (unsigned leaf_size : {1u, 4u, 16u}) {
+        const Bvhf bvh(triangles, 4, leaf_size);
+        batched<1>(bvh, triangles, r);
+        batched<4>(bvh, triangles, r);
+        batched<8>(bvh, triangles, r);
+        batched<16>(bvh, triangles, r);
+    }
+}
+
+TEST(Bvh, Parallel) {
+    // Large enough for parallel binning and subtree tasks.
+    const std::vector<Trianglef> triangles = soup<float>(40000, 5);
+    const Bvhf serial(triangles, 1);
+    const Bvhf parallel(triangles, 4);
+    for (unsigned c = 0; c < 3; ++c) {
+        EXPECT_FLOAT_EQ(serial.bounds().lo[c], parallel.bounds().lo[c]);
+        EXPECT_FLOAT_EQ(serial.bounds().hi[c], parallel.bounds().hi[c]);
+    }
+
+    const std::vector<Rayf> r = rays<float>(300, 6);
+    std::vector<RayHit<float>> hits(r.size());
+    parallel.intersect(r.data(), r.size(), hits.data(), 0);
+    for (std::size_t q = 0; q < r.size(); ++q) {
+        const RayHit<float> expected = serial.intersect(r[q]);
+        EXPECT_EQ(hits[q].index, expected.index);
+        EXPECT_NEAR(hits[q].t, expected.t, tolerance(r[q]));
+        EXPECT_EQ(expected.index, bruteForce(triangles, r[q]).index);
+    }
+}
+
+TEST(Bvh, Degenerate) {
+    // Identical triangles have coincident centers and are split at the median.
+    const std::vector<Trianglef> triangles(100, Trianglef{Vector3f(0.f), Vector3f(1.f, 0.f, 0.f), Vector3f(0.f, 1.f, 0.f)});
+    const Bvhf bvh(triangles, 1, 2);
+    const RayHit<float> hit = bvh.intersect(Rayf(Vector3f(.25f, .25f, -1.f), Vector3f(0.f, 0.f, 1.f)));
+    EXPECT_TRUE(hit.valid());
+    EXPECT_FLOAT_EQ(hit.t, 1.f);
+    EXPECT_FALSE(bvh.intersect(Rayf(Vector3f(.75f, .75f, -1.f), Vector3f(0.f, 0.f, 1.f))).valid());
+}
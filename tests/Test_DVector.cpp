@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <mathlib/defines.h>
+#include <mathlib/dvector.h>
+
+#include <stdexcept>
+#include <utility>
+
+TEST(DVector, Constructor) {
+    DVectord a;
+    EXPECT_EQ(a.size(), 0);
+    EXPECT_TRUE(a.empty());
+
+    DVectord b(5);
+    EXPECT_EQ(b.size(), 5);
+    EXPECT_DOUBLE_EQ(b.sum(), 0.);
+
+    DVectord c(3, 2.);
+    EXPECT_EQ(c, DVectord({2., 2., 2.}));
+
+    DVectord d(Vector3d(1., 2., 3.));
+    EXPECT_EQ(d.size(), 3);
+    EXPECT_EQ(d.toVector<3>(), Vector3d(1., 2., 3.));
+    EXPECT_THROW(d.at(3), std::runtime_error);
+}
+
+TEST(DVector, Storage) {
+    DVectorf small(16, 1.f);
+    EXPECT_TRUE(small.isInline());
+    DVectorf large(17, 1.f);
+    EXPECT_FALSE(large.isInline());
+
+    DVectorf moved(std::move(large));
+    EXPECT_FALSE(moved.isInline());
+    EXPECT_EQ(moved.size(), 17);
+    EXPECT_EQ(large.size(), 0);
+
+    DVectorf copy(moved);
+    EXPECT_EQ(copy, moved);
+    copy.resize(4);
+    EXPECT_TRUE(copy.isInline());
+    EXPECT_EQ(copy, DVectorf(4, 1.f));
+    copy.resize(20);
+    EXPECT_FLOAT_EQ(copy.sum(), 4.f);
+}
+
+TEST(DVector, Arena) {
+    MonotonicArena arena;
+    ArenaAllocator<double> alloc(arena);
+    double total = 0.;
+    for (unsigned i = 0; i < 100; ++i) {
+        ArenaDVector<double> a(64, 1., alloc);
+        ArenaDVector<double> b(64, double(i), alloc);
+        total += (a + b).sum();
+    }
+    EXPECT_DOUBLE_EQ(total, 64. * (100. + 4950.));
+    EXPECT_GE(arena.blocks(), 1);
+    EXPECT_LE(arena.blocks(), 4);
+}
+
+TEST(DVector, Arithmetic) {
+    const unsigned n = 37;
+    DVectord a(n), b(n);
+    for (unsigned i = 0; i < n; ++i) {
+        a[i] = double(i);
+        b[i] = 1. + double(i % 3);
+    }
+
+    DVectord sum = a + b, diff = a - b, prod = a * b, quot = a / b;
+    double dot = 0.;
+    for (unsigned i = 0; i < n; ++i) {
+        EXPECT_DOUBLE_EQ(sum[i], a[i] + b[i]);
+        EXPECT_DOUBLE_EQ(diff[i], a[i] - b[i]);
+        EXPECT_DOUBLE_EQ(prod[i], a[i] * b[i]);
+        EXPECT_DOUBLE_EQ(quot[i], a[i] / b[i]);
+        dot += a[i] * b[i];
+    }
+    EXPECT_DOUBLE_EQ(a.dot(b), dot);
+    EXPECT_DOUBLE_EQ((2. * a)[5], 10.);
+    EXPECT_DOUBLE_EQ((a * 2.)[5], 10.);
+    EXPECT_DOUBLE_EQ((1. + a)[5], 6.);
+    EXPECT_DOUBLE_EQ((-a)[5], -5.);
+    EXPECT_DOUBLE_EQ(a.min(), 0.);
+    EXPECT_DOUBLE_EQ(a.max(), double(n - 1));
+    EXPECT_NEAR(a.normalized().norm(), 1., 1e-12);
+}
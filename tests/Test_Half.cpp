@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <mathlib/defines.h>
+#include <mathlib/half.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using mathlib::bfloat16;
+using mathlib::half;
+
+TEST(Half, Conversion) {
+    EXPECT_EQ(half(0.f).bits(), 0x0000);
+    EXPECT_EQ(half(-0.f).bits(), 0x8000);
+    EXPECT_EQ(half(1.f).bits(), 0x3c00);
+    EXPECT_EQ(half(-2.f).bits(), 0xc000);
+    EXPECT_EQ(half(65504.f).bits(), 0x7bff);
+    EXPECT_EQ(half(65520.f).bits(), 0x7c00);  // rounds to infinity
+    EXPECT_EQ(half(std::numeric_limits<float>::infinity()).bits(), 0x7c00);
+    EXPECT_TRUE(std::isnan(float(half(std::numeric_limits<float>::quiet_NaN()))));
+    EXPECT_EQ(half(std::ldexp(1.f, -24)).bits(), 0x0001);  // smallest subnormal
+    EXPECT_EQ(half(std::ldexp(1.f, -26)).bits(), 0x0000);
+    EXPECT_EQ(float(half::fromBits(0x0001)), std::ldexp(1.f, -24));
+    EXPECT_EQ(float(half::fromBits(0x3555)), 0.333251953125f);
+
+    // Ties round to even: 1 + 2^-11 is halfway between 1 and 1 + 2^-10.
+    EXPECT_EQ(half(1.f + std::ldexp(1.f, -11)).bits(), 0x3c00);
+    EXPECT_EQ(half(1.f + 3.f * std::ldexp(1.f, -11)).bits(), 0x3c02);
+
+    // All finite halves survive a round trip through float.
+    for (unsigned b = 0; b < 0x10000; ++b) {
+        const half h = half::fromBits(std::uint16_t(b));
+        if ((b & 0x7c00) != 0x7c00) {
+            EXPECT_EQ(half(float(h)).bits(), b);
+        }
+    }
+}
+
+TEST(Half, Bfloat16) {
+    EXPECT_EQ(bfloat16(1.f).bits(), 0x3f80);
+    EXPECT_EQ(float(bfloat16(3.f)), 3.f);
+    EXPECT_EQ(bfloat16(1.f + std::ldexp(1.f, -8)).bits(), 0x3f80);  // tie to even
+    EXPECT_EQ(bfloat16(1.f + 3.f * std::ldexp(1.f, -8)).bits(), 0x3f82);
+    EXPECT_EQ(float(bfloat16(1e30f)), float(bfloat16::fromBits(bfloat16(1e30f).bits())));
+    EXPECT_NEAR(float(bfloat16(1e30f)), 1e30f, 1e30f / 128.f);
+    EXPECT_TRUE(std::isnan(float(bfloat16(std::numeric_limits<float>::quiet_NaN()))));
+}
+
+TEST(Half, Vector) {
+    EXPECT_EQ(sizeof(Vector3h), 6u);
+    EXPECT_EQ(sizeof(Vector4bf), 8u);
+
+    Vector3h v(1.f, -0.5f, 2.f);
+    const Vector3f f = v.cast<float>();
+    EXPECT_EQ(f, Vector3f(1.f, -0.5f, 2.f));
+    EXPECT_FLOAT_EQ(f.norm(), std::sqrt(5.25f));
+
+    v += Vector3h(1.f, 1.f, 1.f);
+    EXPECT_EQ(v.cast<float>(), Vector3f(2.f, 0.5f, 3.f));
+    EXPECT_EQ(Vector3f(0.1f, 0.2f, 0.3f).cast<half>().cast<float>()[0], float(half(0.1f)));
+}
+
+TEST(Half, BulkConversion) {
+    std::vector<Vector3f> normals;
+    for (int i = 0; i < 1001; ++i)
+        normals.push_back(Vector3f(std::sin(0.01f * i), std::cos(0.01f * i), 0.001f * i - 0.5f));
+
+    const std::vector<Vector3h> h = mathlib::convert<half>(normals);
+    const std::vector<Vector3f> back = mathlib::convert<float>(h);
+    ASSERT_EQ(back.size(), normals.size());
+    for (std::size_t i = 0; i < normals.size(); ++i) {
+        for (unsigned c = 0; c < 3; ++c) {
+            // The bulk kernels match the scalar conversion, and the error is below half an ulp, of the smallest
+            // subnormal in the underflow range.
+            EXPECT_EQ(h[i][c].bits(), half(normals[i][c]).bits());
+            EXPECT_LE(std::fabs(back[i][c] - normals[i][c]), std::max(std::ldexp(std::fabs(normals[i][c]), -11), std::ldexp(1.f, -25)));
+        }
+    }
+
+    const std::vector<Vector3bf> b = mathlib::convert<bfloat16>(normals);
+    const std::vector<Vector3f> back_b = mathlib::convert<float>(b);
+    for (std::size_t i = 0; i < normals.size(); ++i)
+        for (unsigned c = 0; c < 3; ++c)
+            EXPECT_LE(std::fabs(back_b[i][c] - normals[i][c]), std::ldexp(std::fabs(normals[i][c]), -8));
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <mathlib/defines.h>
+#include <mathlib/hash_grid.h>
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+TEST(HashGrid, Hash) {
+    std::unordered_map<Vector3i, int> map;
+    map[Vector3i(1, 2, 3)] = 1;
+    map[Vector3i(3, 2, 1)] = 2;
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_EQ(map[Vector3i(1, 2, 3)], 1);
+
+    // Neighboring voxels differ in many bits, even in the low ones used by power of two tables.
+    std::unordered_set<std::size_t> low_bits;
+    for (int x = 0; x < 16; ++x)
+        for (int y = 0; y < 16; ++y)
+            for (int z = 0; z < 16; ++z)
+                low_bits.insert(std::hash<Vector3i>()(Vector3i(x, y, z)) & 0xffff);
+    EXPECT_GT(low_bits.size(), 3850u);
+    EXPECT_NE(std::hash<Vector2u>()(Vector2u(1u, 2u)), std::hash<Vector2u>()(Vector2u(2u, 1u)));
+
+    // Vectors of floating point types are not hashable, which traits can detect.
+    EXPECT_TRUE(std::is_default_constructible<std::hash<Vector3i>>::value);
+    EXPECT_FALSE(std::is_default_constructible<std::hash<Vector3d>>::value);
+    EXPECT_FALSE(std::is_copy_constructible<std::hash<Vector3f>>::value);
+}
+
+TEST(HashGrid, Cells) {
+    SpatialHashGrid3f grid(0.5f);
+    EXPECT_EQ(grid.cell(Vector3f(0.25f, -0.25f, 1.f)), Vector3i(0, -1, 2));
+
+    std::vector<Vector3f> points = {Vector3f(0.1f), Vector3f(0.2f), Vector3f(-0.1f), Vector3f(0.3f)};
+    grid.build(points);
+    EXPECT_EQ(grid.size(), 4u);
+    EXPECT_EQ(grid.cells(), 2u);
+
+    auto range = grid.points(Vector3i(0, 0, 0));
+    ASSERT_EQ(range.second - range.first, 3);
+    EXPECT_EQ(range.first[0], 0u);
+    EXPECT_EQ(range.first[2], 3u);
+    range = grid.points(Vector3i(5, 5, 5));
+    EXPECT_EQ(range.first, range.second);
+}
+
+TEST(HashGrid, Neighbors) {
+    std::vector<Vector3d> points(20000);
+    for (std::size_t i = 0; i < points.size(); ++i)
+        for (unsigned c = 0; c < 3; ++c)
+            points[i][c] = std::fmod(std::sin(double(i * (c + 3))) * 43758.5453, 5.);
+
+    const double r = 0.3;
+    SpatialHashGrid3d grid(r, points);
+    for (std::size_t q = 0; q < points.size(); q += 397) {
+        std::vector<std::size_t> found;
+        grid.forEachNeighbor(points[q], [&](std::size_t i) {
+            Vector3d d(points[i]);
+            d -= points[q];
+            if (d.squaredNorm() <= r * r)
+                found.push_back(i);
+        });
+        std::sort(found.begin(), found.end());
+
+        std::vector<std::size_t> expected;
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            Vector3d d(points[i]);
+            d -= points[q];
+            if (d.squaredNorm() <= r * r)
+                expected.push_back(i);
+        }
+        EXPECT_EQ(found, expected);
+    }
+
+    // Rebuilding replaces the points.
+    grid.build(points.data(), 10);
+    EXPECT_EQ(grid.size(), 10u);
+}
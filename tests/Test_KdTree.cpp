@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <mathlib/defines.h>
+#include <mathlib/kdtree.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+template <unsigned N, typename T>
+static std::vector<Vector<N, T>> cloud(std::size_t count, unsigned seed) {
+    std::vector<Vector<N, T>> ret(count);
+    for (std::size_t i = 0; i < count; ++i)
+        for (unsigned c = 0; c < N; ++c)
+            ret[i][c] = T(std::fmod(std::sin(double(i * (c + 3) + seed)) * 43758.5453, 10.));
+    return ret;
+}
+
+template <unsigned N, typename T>
+static std::vector<typename KdTree<N, T>::Neighbor> bruteForce(const std::vector<Vector<N, T>> &points, const Vector<N, T> &q) {
+    std::vector<typename KdTree<N, T>::Neighbor> ret;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        Vector<N, T> d(points[i]);
+        d -= q;
+        ret.push_back({i, d.squaredNorm()});
+    }
+    std::sort(ret.begin(), ret.end(), [](const auto &a, const auto &b) {
+        return a.squared_distance < b.squared_distance || (a.squared_distance == b.squared_distance && a.index < b.index);
+    });
+    return ret;
+}
+
+TEST(KdTree, Empty) {
+    KdTree3d tree;
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(tree.nearest(Vector3d()).index, KdTree3d::npos);
+    EXPECT_TRUE(tree.knn(Vector3d(), 3).empty());
+    EXPECT_TRUE(tree.radius(Vector3d(), 1.).empty());
+}
+
+TEST(KdTree, Knn) {
+    const std::vector<Vector3d> points = cloud<3, double>(2000, 1);
+    const KdTree3d tree(points);
+    EXPECT_EQ(tree.size(), points.size());
+
+    for (const Vector3d &q : cloud<3, double>(50, 7)) {
+        const auto expected = bruteForce(points, q);
+        const auto found = tree.knn(q, 10);
+        ASSERT_EQ(found.size(), 10u);
+        for (unsigned j = 0; j < 10; ++j) {
+            EXPECT_EQ(found[j].index, expected[j].index);
+            EXPECT_DOUBLE_EQ(found[j].squared_distance, expected[j].squared_distance);
+        }
+        EXPECT_EQ(tree.nearest(q).index, expected[0].index);
+    }
+
+    // Less points than requested.
+    const KdTree2f small(cloud<2, float>(3, 2));
+    EXPECT_EQ(small.knn(Vector2f(), 5).size(), 3u);
+}
+
+TEST(KdTree, Radius) {
+    const std::vector<Vector2f> points = cloud<2, float>(3000, 3);
+    const KdTree2f tree(points, 4);
+    for (const Vector2f &q : cloud<2, float>(50, 11)) {
+        const auto expected = bruteForce(points, q);
+        const auto found = tree.radius(q, 1.5f);
+        std::size_t count = 0;
+        while (count < expected.size() && expected[count].squared_distance <= 1.5f * 1.5f)
+            ++count;
+        ASSERT_EQ(found.size(), count);
+        for (std::size_t j = 0; j < count; ++j)
+            EXPECT_EQ(found[j].index, expected[j].index);
+    }
+}
+
+TEST(KdTree, Duplicates) {
+    std::vector<Vector<4, double>> points(100, Vector<4, double>(1.));
+    points.push_back(Vector<4, double>(2.));
+    const KdTree<4, double> tree(points, 2);
+    const auto found = tree.knn(Vector<4, double>(1.), 3);
+    ASSERT_EQ(found.size(), 3u);
+    EXPECT_EQ(found[0].index, 0u);
+    EXPECT_EQ(found[2].index, 2u);
+    EXPECT_EQ(tree.nearest(Vector<4, double>(3.)).index, 100u);
+    EXPECT_EQ(tree.radius(Vector<4, double>(1.), 0.).size(), 100u);
+}
+
+TEST(KdTree, Batched) {
+    const std::vector<Vector3f> points = cloud<3, float>(5000, 5);
+    const std::vector<Vector3f> queries = cloud<3, float>(1000, 9);
+    const KdTree3f tree(points);
+
+    std::vector<std::size_t> indices(queries.size() * 4);
+    std::vector<float> distances(queries.size() * 4);
+    tree.knn(queries.data(), queries.size(), 4, indices.data(), distances.data(), 4);
+    const auto within = tree.radius(queries.data(), queries.size(), 0.5f, 3);
+    for (std::size_t q = 0; q < queries.size(); ++q) {
+        const auto single = tree.knn(queries[q], 4);
+        for (unsigned j = 0; j < 4; ++j) {
+            EXPECT_EQ(indices[q * 4 + j], single[j].index);
+            EXPECT_EQ(distances[q * 4 + j], single[j].squared_distance);
+        }
+        EXPECT_EQ(within[q].size(), tree.radius(queries[q], 0.5f).size());
+    }
+}
@@ -0,0 +1,17 @@
+#include <gtest/gtest.h>
+#include <mathlib/mathlib.h>
+
+#include <cmath>
+
+// The umbrella header compiles as a whole, also on Windows where binary.h includes <windows.h> before the others.
+
+TEST(Mathlib, Umbrella) {
+    const Rayf ray(Vector3f(0.f), Vector3f(0.f, 0.f, 1.f), 1.f, 2.f);
+    EXPECT_FLOAT_EQ(ray.t_min, 1.f);
+    EXPECT_FLOAT_EQ(ray.t_max, 2.f);
+
+    // Subnormal in half precision.
+    EXPECT_NEAR(float(mathlib::half(1e-6f)), 1e-6f, std::ldexp(1.f, -25));
+    EXPECT_EQ(mathlib::format(Vector3i(1, 2, 3)), "1 2 3");
+    EXPECT_DOUBLE_EQ(Quaterniond::exp(Vector3d(0.)).w(), 1.);
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <mathlib/defines.h>
+#include <mathlib/matrix.h>
+
+#include <sstream>
+
+TEST(Matrix, Size) {
+    EXPECT_EQ(Matrix3d::rows(), 3);
+    EXPECT_EQ(Matrix3d::cols(), 3);
+    EXPECT_EQ((Matrix<2, 5, float>::rows()), 2);
+    EXPECT_EQ((Matrix<2, 5, float>::cols()), 5);
+    EXPECT_EQ(typeid(Matrix4f::type), typeid(float));
+}
+
+TEST(Matrix, Constructor) {
+    Matrix3d zero;
+    Matrix3d m(1., 2., 3., 4., 5., 6., 7., 8., 9.);
+    for (unsigned r = 0; r < 3; ++r)
+        for (unsigned c = 0; c < 3; ++c) {
+            EXPECT_DOUBLE_EQ(zero(r, c), 0.);
+            EXPECT_DOUBLE_EQ(m(r, c), double(3 * r + c + 1));
+            EXPECT_DOUBLE_EQ(Matrix3d::Identity()(r, c), r == c ? 1. : 0.);
+        }
+    EXPECT_EQ(m.row(1), Vector3d(4., 5., 6.));
+    EXPECT_EQ(m.col(1), Vector3d(2., 5., 8.));
+
+    m.setRow(0, Vector3d(0.));
+    m.setCol(2, Vector3d(1.));
+    EXPECT_EQ(m, Matrix3d(0., 0., 1., 4., 5., 1., 7., 8., 1.));
+}
+
+TEST(Matrix, Constexpr) {
+    static_assert(std::is_trivially_copyable<Matrix4f>::value);
+    constexpr Matrix2d m(1., 2., 3., 4.);
+    static_assert(m.determinant() == -2.);
+    static_assert(m.transpose()(0, 1) == 3.);
+    static_assert((m * m)(1, 1) == 22.);
+    static_assert((m * Vector2d(1., 1.))[1] == 7.);
+}
+
+TEST(Matrix, Transpose) {
+    Matrix<2, 3, double> m(1., 2., 3., 4., 5., 6.);
+    Matrix<3, 2, double> t = m.transpose();
+    EXPECT_EQ(t, (Matrix<3, 2, double>(1., 4., 2., 5., 3., 6.)));
+}
+
+TEST(Matrix, MatrixVector) {
+    Matrix3d m(1., 2., 3., 4., 5., 6., 7., 8., 9.);
+    EXPECT_EQ(m * Vector3d(1., 0., -1.), Vector3d(-2., -2., -2.));
+
+    Matrix4f m4(1.f, 0.f, 0.f, 1.f, 0.f, 2.f, 0.f, 2.f, 0.f, 0.f, 3.f, 3.f, 0.f, 0.f, 0.f, 1.f);
+    Vector<4, float> r = m4 * Vector<4, float>(1.f, 1.f, 1.f, 1.f);
+    EXPECT_FLOAT_EQ(r[0], 2.f);
+    EXPECT_FLOAT_EQ(r[1], 4.f);
+    EXPECT_FLOAT_EQ(r[2], 6.f);
+    EXPECT_FLOAT_EQ(r[3], 1.f);
+
+    Matrix<2, 3, double> m23(1., 2., 3., 4., 5., 6.);
+    EXPECT_EQ(m23 * Vector3d(1., 1., 1.), Vector2d(6., 15.));
+}
+
+template <typename T>
+void checkMatrixProduct() {
+    Matrix<4, 4, T> a, b;
+    for (unsigned r = 0; r < 4; ++r)
+        for (unsigned c = 0; c < 4; ++c) {
+            a(r, c) = T(r + 2 * c) - T(3);
+            b(r, c) = T(r * c % 5) + T(0.5);
+        }
+    Matrix<4, 4, T> p = a * b;
+    for (unsigned r = 0; r < 4; ++r)
+        for (unsigned k = 0; k < 4; ++k) {
+            T expected(0.);
+            for (unsigned c = 0; c < 4; ++c)
+                expected += a(r, c) * b(c, k);
+            EXPECT_EQ(p(r, k), expected);
+        }
+}
+
+TEST(Matrix, MatrixMatrix) {
+    checkMatrixProduct<float>();
+    checkMatrixProduct<double>();
+
+    Matrix<2, 3, double> a(1., 2., 3., 4., 5., 6.);
+    Matrix<3, 2, double> b(1., 0., 0., 1., 1., 1.);
+    EXPECT_EQ(a * b, Matrix2d(4., 5., 10., 11.));
+
+    EXPECT_EQ(a + a, a * 2.);
+    EXPECT_EQ(2. * a - a, a);
+}
+
+TEST(Matrix, Inverse) {
+    Matrix2d m2(4., 7., 2., 6.);
+    EXPECT_DOUBLE_EQ(m2.determinant(), 10.);
+    EXPECT_EQ(m2 * m2.inverse(), Matrix2d::Identity());
+
+    Matrix3d m3(2., -1., 0., -1., 2., -1., 0., -1., 2.);
+    EXPECT_DOUBLE_EQ(m3.determinant(), 4.);
+    EXPECT_EQ(m3 * m3.inverse(), Matrix3d::Identity());
+    EXPECT_EQ(m3.inverse() * m3, Matrix3d::Identity());
+
+    Matrix4d m4(4., 0., 0., 1., 1., 3., 0., 0., 0., 1., 2., 0., 0., 0., 1., 5.);
+    EXPECT_DOUBLE_EQ(m4.determinant(), 119.);
+    Matrix4d i4 = m4 * m4.inverse();
+    for (unsigned r = 0; r < 4; ++r)
+        for (unsigned c = 0; c < 4; ++c)
+            EXPECT_NEAR(i4(r, c), r == c ? 1. : 0., 1e-14);
+
+    EXPECT_THROW(Matrix2d(1., 2., 2., 4.).inverse(), std::runtime_error);
+}
+
+TEST(Matrix, Stream) {
+    std::stringstream ss;
+    ss << Matrix2d(1., 2., 3., 4.);
+    EXPECT_EQ(ss.str(), std::string("1 2\n3 4"));
+}
@@ -60,4 +60,41 @@ TEST(Operators, Order) {
 TEST(Operators, Negation) {
     Vector3d v1(1., 2., 3.);
     EXPECT_EQ(Vector3d(-1., -2., -3.), -v1);
-}
\ No newline at end of file
+}
+
+TEST(Operators, Expression) {
+    Vector3d a(1., 2., 3.);
+    Vector3d b(4., 5., 6.);
+    Vector3d c(7., 8., 9.);
+    Vector3d d(0.5, 1., 1.5);
+
+    auto expr = a + b * c - d * 2.;
+    EXPECT_FALSE((std::is_same<decltype(expr), Vector3d>::value));
+
+    Vector3d r = expr;
+    EXPECT_DOUBLE_EQ(r[0], 28.);
+    EXPECT_DOUBLE_EQ(r[1], 40.);
+    EXPECT_DOUBLE_EQ(r[2], 54.);
+
+    EXPECT_EQ((-(a + b) / 2. + 1.).eval(), Vector3d(-1.5, -2.5, -3.5));
+}
+
+TEST(Operators, ExpressionAssignment) {
+    Vector3d a(1., 2., 3.);
+    Vector3d b(4., 5., 6.);
+
+    a = b - a * 2.;
+    EXPECT_EQ(a, Vector3d(2., 1., 0.));
+
+    a += a + b;
+    EXPECT_EQ(a, Vector3d(8., 7., 6.));
+
+    a -= 2. * b;
+    EXPECT_EQ(a, Vector3d(0., -3., -6.));
+
+    a *= b + 1.;
+    EXPECT_EQ(a, Vector3d(0., -18., -42.));
+
+    a /= b * 0.5;
+    EXPECT_EQ(a, Vector3d(0., -7.2, -14.));
+}
@@ -0,0 +1,28 @@
+#include <gtest/gtest.h>
+#include <mathlib/parallel.h>
+
+#include <atomic>
+#include <vector>
+
+TEST(Parallel, ThreadCount) {
+    EXPECT_EQ(mathlib::threadCount(3), 3u);
+    EXPECT_GE(mathlib::threadCount(0), 1u);
+}
+
+TEST(Parallel, Chunks) {
+    std::vector<int> visited(1000, 0);
+    std::atomic<std::size_t> total(0);
+    std::size_t chunks = mathlib::parallelChunks(visited.size(), 4, 100, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+            ++visited[i];
+        total += end - begin;
+    });
+    EXPECT_EQ(chunks, 4u);
+    EXPECT_EQ(total, visited.size());
+    for (int v : visited)
+        EXPECT_EQ(v, 1);
+
+    // Small inputs stay on the calling thread.
+    EXPECT_EQ(mathlib::parallelChunks(150, 4, 100, [](std::size_t, std::size_t, std::size_t) {}), 1u);
+    EXPECT_EQ(mathlib::parallelChunks(0, 4, 100, [](std::size_t, std::size_t, std::size_t) {}), 1u);
+}
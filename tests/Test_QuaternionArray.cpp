@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <mathlib/defines.h>
+#include <mathlib/quaternion_array.h>
+
+#include <cmath>
+#include <vector>
+
+static std::vector<Quaterniond> quaternions(std::size_t count, double offset) {
+    std::vector<Quaterniond> ret;
+    for (std::size_t i = 0; i < count; ++i)
+        ret.push_back(Quaterniond(Vector3d(std::sin(i + offset), 1., std::cos(i * offset)), 0.1 * i - offset));
+    return ret;
+}
+
+static void expectNear(const Quaterniond &a, const Quaterniond &b) {
+    for (unsigned c = 0; c < 4; ++c)
+        EXPECT_NEAR(a[c], b[c], 1e-12);
+}
+
+TEST(QuaternionArray, Constructor) {
+    QuaternionArrayf a(3);
+    EXPECT_EQ(a.size(), 3u);
+    EXPECT_EQ(a.quaternion(2), Quaternionf::Identity());
+
+    std::vector<Quaterniond> q = quaternions(5, 0.3);
+    QuaternionArrayd b(q);
+    EXPECT_EQ(b.quaternion(4), q[4]);
+    EXPECT_EQ(b.toQuaternions()[1], q[1]);
+}
+
+TEST(QuaternionArray, Compose) {
+    std::vector<Quaterniond> qa = quaternions(100, 0.3), qb = quaternions(100, 1.7);
+    QuaternionArrayd a(qa), b(qb);
+    QuaternionArrayd c = a * b;
+    for (std::size_t i = 0; i < qa.size(); ++i)
+        expectNear(c.quaternion(i), qa[i] * qb[i]);
+
+    // Composition with the identity is not a special case.
+    QuaternionArrayd identity(100);
+    QuaternionArrayd d = identity * a;
+    for (std::size_t i = 0; i < qa.size(); ++i)
+        expectNear(d.quaternion(i), qa[i]);
+
+    a *= a;
+    for (std::size_t i = 0; i < qa.size(); ++i)
+        expectNear(a.quaternion(i), qa[i] * qa[i]);
+}
+
+TEST(QuaternionArray, Inverse) {
+    std::vector<Quaterniond> q = quaternions(50, 0.7);
+    QuaternionArrayd a(q);
+    a *= 2.;
+
+    QuaternionArrayd inv = a.inverse();
+    QuaternionArrayd conj = a.conjugated();
+    QuaternionArrayd unit = a.normalized();
+    for (std::size_t i = 0; i < q.size(); ++i) {
+        expectNear(inv.quaternion(i), a.quaternion(i).inverse());
+        expectNear(conj.quaternion(i), Quaterniond(-2. * q[i].x(), -2. * q[i].y(), -2. * q[i].z(), 2. * q[i].w()));
+        expectNear(unit.quaternion(i), q[i]);
+        expectNear((a * inv).quaternion(i), Quaterniond::Identity());
+    }
+}
+
+TEST(QuaternionArray, Rotate) {
+    std::vector<Quaterniond> q = quaternions(1000, 0.2);
+    QuaternionArrayd a(q);
+    VectorArray3d points(q.size());
+    for (std::size_t i = 0; i < q.size(); ++i)
+        points[i] = Vector3d(double(i), 1., -2.);
+
+    VectorArray3d rotated;
+    a.rotate(points, rotated);
+    a.rotate(points, 4);
+    for (std::size_t i = 0; i < q.size(); ++i) {
+        const Vector3d expected = q[i] * Vector3d(double(i), 1., -2.);
+        for (unsigned c = 0; c < 3; ++c) {
+            EXPECT_NEAR(rotated[i][c], expected[c], 1e-9);
+            EXPECT_NEAR(points[i][c], expected[c], 1e-9);
+        }
+    }
+}
+
+TEST(QuaternionArray, Integrate) {
+    std::vector<Quaterniond> q = quaternions(1000, 0.4);
+    VectorArray3d omega(q.size());
+    for (std::size_t i = 0; i < q.size(); ++i)
+        omega[i] = i % 9 == 0 ? Vector3d(0.) : Vector3d(std::sin(i * 0.3) * 30., 1e-6 * i, -2.);
+
+    QuaternionArrayd a(q);
+    a.integrate(omega, 0.01, 4);
+    for (std::size_t i = 0; i < q.size(); ++i) {
+        expectNear(a.quaternion(i), q[i].integrated(omega[i], 0.01));
+        EXPECT_NEAR(a.quaternion(i).norm(), 1., 1e-15);
+    }
+}
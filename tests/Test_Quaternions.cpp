@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
+#include <mathlib/defines.h>
 #include <mathlib/quaternion.h>
 
+#include <cmath>
+#include <limits>
+
 TEST(Quaternion, Type) {
     EXPECT_EQ(typeid(Quaterniond::type), typeid(double));
     EXPECT_EQ(typeid(Quaternionf::type), typeid(float));
@@ -107,4 +111,278 @@ TEST(Quaternion, Access) {
 
     EXPECT_DOUBLE_EQ(q2.angle(), 4.);
     EXPECT_EQ(q2.axis(), (Vector<3, double>(1., 0., 0.)));
-}
\ No newline at end of file
+}
+
+TEST(Quaternion, Constexpr) {
+    static_assert(std::is_trivially_copyable<Quaterniond>::value);
+    static_assert(std::is_trivially_copyable<Quaternionf>::value);
+
+    constexpr Quaterniond q1(0., 0., 1., 0.);
+    constexpr Quaterniond q2 = q1 * q1;
+    static_assert(q2.x() == 0. && q2.y() == 0. && q2.z() == 0. && q2.w() == -1.);
+
+    constexpr Quaterniond inv = Quaterniond(0., 0., 0., 2.).inverse();
+    static_assert(inv.w() > 0.49 && inv.w() < 0.51);
+
+    constexpr Vector<3, double> r = q1 * Vector<3, double>(1., 0., 0.);
+    static_assert(r.x() < -0.99 && r.y() == 0. && r.z() == 0.);
+
+    constexpr Quaterniond table[] = {Quaterniond::Identity(), q1, q2};
+    static_assert(table[0].w() == 1. && table[1].vec().z() == 1.);
+}
+
+TEST(Quaternion, RotateBulk) {
+    Quaterniond q(Vector<3, double>(5., 3., 1.), 4.);
+    q.normalize();
+
+    std::vector<Vector<3, double>> points(100000);
+    for (std::size_t i = 0; i < points.size(); ++i)
+        points[i] = Vector<3, double>(double(i % 17) - 8., double(i % 5) * 0.5, 1. / double(i + 1));
+
+    std::vector<Vector<3, double>> rotated(points.size());
+    q.rotate(points.data(), rotated.data(), points.size());
+
+    VectorArray<3, double> soa(points);
+    q.rotate(soa, 4);
+
+    std::vector<Vector<3, double>> in_place = points;
+    q.rotate(in_place, 4);
+
+    for (std::size_t i = 0; i < points.size(); i += 997) {
+        Vector<3, double> expected = q * points[i];
+        for (unsigned c = 0; c < 3; ++c) {
+            EXPECT_NEAR(rotated[i][c], expected[c], 1e-12);
+            EXPECT_NEAR(soa[i][c], expected[c], 1e-12);
+            EXPECT_NEAR(in_place[i][c], expected[c], 1e-12);
+        }
+    }
+
+    // Not normalized, same scaling as a single rotation.
+    Quaternionf qf(1.f, 2.f, 3.f, 4.f);
+    Vector<3, float> v(1.f, 2.f, 3.f);
+    Vector<3, float> r;
+    qf.rotate(&v, &r, 1);
+    Vector<3, float> expected = qf * v;
+    for (unsigned c = 0; c < 3; ++c)
+        EXPECT_NEAR(r[c], expected[c], 1e-5f);
+}
+
+TEST(Quaternion, RotationMatrix) {
+    Quaterniond q(Vector<3, double>(5., 3., 1.), 4.);
+    Matrix<3, 3, double> m = q.toRotationMatrix();
+
+    Vector<3, double> v(1., 2., 3.);
+    Vector<3, double> r1 = q * v;
+    Vector<3, double> r2 = m * v;
+    for (unsigned c = 0; c < 3; ++c)
+        EXPECT_NEAR(r1[c], r2[c], 1e-12);
+
+    // Round trip through all branches of the conversion.
+    Quaterniond rotations[] = {q, Quaterniond(Vector<3, double>(1., 0., 0.), 3.), Quaterniond(Vector<3, double>(0., 1., 0.), 3.),
+                               Quaterniond(Vector<3, double>(0., 0., 1.), 3.)};
+    for (const Quaterniond& rotation : rotations) {
+        Quaterniond back(rotation.toRotationMatrix());
+        double sign = back.dot(rotation) < 0. ? -1. : 1.;
+        for (unsigned c = 0; c < 4; ++c)
+            EXPECT_NEAR(sign * back[c], rotation[c], 1e-12);
+    }
+}
+
+TEST(Quaternion, Slerp) {
+    const Vector3d axis(1., 2., 3.);
+    const Quaterniond a(axis, 0.2), b(axis, 1.4);
+    for (double t : {0., 0.25, 0.5, 1.}) {
+        const Quaterniond expected(axis, 0.2 + t * 1.2);
+        const Quaterniond s = a.slerp(b, t);
+        for (unsigned i = 0; i < 4; ++i)
+            EXPECT_NEAR(s[i], expected[i], 1e-12);
+        // The negated quaternion is the same rotation, slerp takes the shorter path.
+        const Quaterniond n = a.slerp(Quaterniond(-b.x(), -b.y(), -b.z(), -b.w()), t);
+        for (unsigned i = 0; i < 4; ++i)
+            EXPECT_NEAR(n[i], expected[i], 1e-12);
+    }
+
+    // Nearly identical quaternions do not divide by zero.
+    const Quaterniond c = a.slerp(a, 0.5);
+    for (unsigned i = 0; i < 4; ++i)
+        EXPECT_NEAR(c[i], a[i], 1e-12);
+
+    const Quaterniond m = a.nlerp(b, 0.5);
+    EXPECT_NEAR(m.norm(), 1., 1e-12);
+    EXPECT_NEAR(m.angle(), 0.8, 1e-12);
+}
+
+TEST(Quaternion, FastSlerp) {
+    double max_error = 0.;
+    for (unsigned i = 0; i < 200; ++i) {
+        const Quaterniond a(Vector3d(std::sin(i * 1.3), std::cos(i * 0.7), 0.5), 0.1 * i);
+        const Quaterniond b(Vector3d(std::cos(i * 0.3), 1., std::sin(i * 2.1)), -0.07 * i);
+        for (unsigned k = 0; k <= 20; ++k) {
+            const Quaterniond exact = a.slerp(b, k / 20.);
+            const Quaterniond fast = a.fastSlerp(b, k / 20.);
+            for (unsigned c = 0; c < 4; ++c)
+                max_error = std::max(max_error, std::fabs(exact[c] - fast[c]));
+        }
+    }
+    EXPECT_LT(max_error, 4e-5);
+}
+
+TEST(Quaternion, InterpolateBulk) {
+    const std::size_t n = 1000;
+    std::vector<Quaternionf> a, b, out(n);
+    std::vector<float> t;
+    for (std::size_t i = 0; i < n; ++i) {
+        a.push_back(Quaternionf(Vector3f(1.f, float(i % 5), 2.f), 0.01f * i));
+        b.push_back(Quaternionf(Vector3f(float(i % 3), 1.f, -1.f), -0.02f * i));
+        t.push_back(float(i % 11) / 10.f);
+    }
+
+    // The batched loops and the members contract to FMA differently, the components of these unit quaternions
+    // differ by a few float ulps.
+    const float tolerance = 4 * std::numeric_limits<float>::epsilon();
+    mathlib::slerp(a.data(), b.data(), t.data(), out.data(), n, 4);
+    for (std::size_t i = 0; i < n; ++i)
+        for (unsigned c = 0; c < 4; ++c)
+            EXPECT_NEAR(out[i][c], a[i].slerp(b[i], t[i])[c], tolerance);
+    mathlib::nlerp(a.data(), b.data(), t.data(), out.data(), n);
+    for (std::size_t i = 0; i < n; ++i)
+        for (unsigned c = 0; c < 4; ++c)
+            EXPECT_NEAR(out[i][c], a[i].nlerp(b[i], t[i])[c], tolerance);
+    mathlib::fastSlerp(a.data(), b.data(), t.data(), out.data(), n, 2);
+    for (std::size_t i = 0; i < n; ++i)
+        for (unsigned c = 0; c < 4; ++c)
+            EXPECT_NEAR(out[i][c], a[i].fastSlerp(b[i], t[i])[c], tolerance);
+
+    // Nearly parallel and opposite pairs, around the linear fallback of slerp.
+    std::vector<Quaterniond> c, d, out_d(n);
+    std::vector<double> u;
+    for (std::size_t i = 0; i < n; ++i) {
+        const Quaterniond q(Vector3d(1., double(i % 7), -2.), 0.003 * i);
+        const double angle = std::ldexp(1., -int(i % 40));
+        c.push_back(q);
+        d.push_back(i % 2 ? q * Quaterniond(Vector3d(0., 1., 1.), angle) : Quaterniond(-q[0], -q[1], -q[2], -q[3]));
+        u.push_back(double(i % 11) / 10.);
+    }
+    mathlib::slerp(c.data(), d.data(), u.data(), out_d.data(), n);
+    for (std::size_t i = 0; i < n; ++i)
+        for (unsigned k = 0; k < 4; ++k)
+            EXPECT_NEAR(out_d[i][k], c[i].slerp(d[i], u[i])[k], 4 * std::numeric_limits<double>::epsilon());
+}
+
+TEST(Quaternion, FastMath) {
+    for (int i = 0; i < 100; ++i) {
+        const Quaternionf q(Vector3f(1.f, float(i % 7), -2.f), 0.1f * i);
+        const Quaternionf scaled(2.f * q.x(), 2.f * q.y(), 2.f * q.z(), 2.f * q.w());
+        const Vector3f v(float(i), 1.f, -3.f);
+        const Vector3f exact = scaled * v;
+        const Vector3f fast = scaled.rotate(v, mathlib::fast);
+        const Vector3f same = scaled.rotate(v, mathlib::exact);
+        for (unsigned c = 0; c < 3; ++c) {
+            EXPECT_NEAR(fast[c], exact[c], 2e-6f * (1.f + std::fabs(float(i))));
+            EXPECT_NEAR(same[c], exact[c], 1e-6f * (1.f + std::fabs(float(i))));
+        }
+
+        const Quaternionf inv = scaled.inverse(), fast_inv = scaled.inverse(mathlib::fast);
+        for (unsigned c = 0; c < 4; ++c)
+            EXPECT_NEAR(fast_inv[c], inv[c], 1e-6f);
+    }
+}
+
+TEST(Quaternion, Sincos) {
+    for (int i = -2000; i <= 2000; ++i) {
+        const double x = 0.01 * i + 0.003;
+        double s, c;
+        mathlib::detail::sincos(x, s, c);
+        // A few ulps of the result.
+        const double eps = std::numeric_limits<double>::epsilon();
+        EXPECT_NEAR(s, std::sin(x), 4 * eps * std::fabs(std::sin(x)));
+        EXPECT_NEAR(c, std::cos(x), 4 * eps * std::fabs(std::cos(x)));
+        float sf, cf;
+        mathlib::detail::sincos(float(x), sf, cf);
+        EXPECT_NEAR(sf, std::sin(float(x)), 2e-7f);
+        EXPECT_NEAR(cf, std::cos(float(x)), 2e-7f);
+    }
+    EXPECT_DOUBLE_EQ(mathlib::detail::invSqrt(2.), 1. / std::sqrt(2.));
+    EXPECT_NEAR(mathlib::detail::invSqrt(3e-5f), 1.f / std::sqrt(3e-5f), 1e-4f);
+}
+
+TEST(Quaternion, Acos) {
+    for (int i = 0; i <= 4096; ++i) {
+        const double x = i / 4096.;
+        EXPECT_NEAR(mathlib::detail::acos(x), std::acos(x), 4 * std::numeric_limits<double>::epsilon() * std::acos(x));
+        EXPECT_NEAR(mathlib::detail::acos(float(x)), std::acos(float(x)), 4 * std::numeric_limits<float>::epsilon() * std::acos(float(x)));
+    }
+    EXPECT_EQ(mathlib::detail::acos(1.), 0.);
+    EXPECT_NEAR(mathlib::detail::acos(1. - 1e-15), std::acos(1. - 1e-15), 1e-15 * std::acos(1. - 1e-15));
+}
+
+TEST(Quaternion, ExpLog) {
+    EXPECT_EQ(Quaterniond::exp(Vector3d(0.)), Quaterniond::Identity());
+    EXPECT_EQ(Quaterniond::Identity().log(), Vector3d(0.));
+
+    for (double length : {1e-200, 1e-12, 1e-9, 1e-4, 0.3, 1., 3.}) {
+        const Vector3d axis(1., -2., 0.5);
+        const Vector3d v = axis.normalized() * length;
+        const Quaterniond q = Quaterniond::exp(v);
+        const Quaterniond expected(axis, 2. * length);
+        for (unsigned i = 0; i < 4; ++i)
+            EXPECT_NEAR(q[i], expected[i], 1e-15);
+        EXPECT_NEAR(q.norm(), 1., 1e-15);
+
+        const Vector3d log = q.log();
+        for (unsigned i = 0; i < 3; ++i)
+            EXPECT_NEAR(log[i], v[i], 1e-15 * (1. + length));
+    }
+
+    // Small angles need no special case, the float version is exact to rounding.
+    const Quaternionf small = Quaternionf::exp(Vector3f(1e-4f, 0.f, 0.f));
+    EXPECT_FLOAT_EQ(small.x(), 1e-4f);
+    EXPECT_FLOAT_EQ(small.w(), 1.f);
+}
+
+TEST(Quaternion, Integrate) {
+    const double dt = 0.01;
+    for (int i = 0; i < 50; ++i) {
+        const Quaterniond q(Vector3d(std::sin(i), 1., std::cos(i)), 0.2 * i);
+        const Vector3d omega(std::cos(i * 0.7) * i, 2. - 0.1 * i, std::sin(i * 1.3));
+        Quaterniond expected = Quaterniond(omega, omega.norm() * dt) * q;
+        expected.normalize();
+        const Quaterniond r = q.integrated(omega, dt);
+        for (unsigned c = 0; c < 4; ++c)
+            EXPECT_NEAR(r[c], expected[c], 1e-14);
+    }
+
+    // No angular velocity leaves the orientation unchanged, tiny ones do not divide by zero.
+    const Quaterniond q(Vector3d(1., 2., 3.), 0.7);
+    EXPECT_EQ(q.integrated(Vector3d(0.), dt), q);
+    const Quaterniond tiny = q.integrated(Vector3d(1e-9, 0., 0.), dt);
+    for (unsigned c = 0; c < 4; ++c)
+        EXPECT_NEAR(tiny[c], q[c], 1e-10);
+
+    // Many steps stay normalized.
+    Quaternionf r = Quaternionf::Identity();
+    for (int i = 0; i < 10000; ++i)
+        r = r.integrated(Vector3f(3.f, -1.f, 0.5f), 0.001f);
+    EXPECT_NEAR(r.norm(), 1.f, 1e-6f);
+    const Quaterniond expected(Vector3d(3., -1., 0.5), 10. * std::sqrt(10.25));
+    for (unsigned c = 0; c < 4; ++c)
+        EXPECT_NEAR(r[c], expected[c], 1e-4);
+}
+
+TEST(Quaternion, IntegrateBulk) {
+    const std::size_t n = 1000;
+    std::vector<Quaternionf> q;
+    std::vector<Vector3f> omega;
+    for (std::size_t i = 0; i < n; ++i) {
+        q.push_back(Quaternionf(Vector3f(1.f, float(i % 5), 2.f), 0.01f * i));
+        omega.push_back(i % 7 == 0 ? Vector3f(0.f) : Vector3f(float(i % 13) - 6.f, 1e-3f * i, 20.f * std::sin(float(i))));
+    }
+    std::vector<Quaternionf> expected(n);
+    for (std::size_t i = 0; i < n; ++i)
+        expected[i] = q[i].integrated(omega[i], 0.02f);
+
+    mathlib::integrate(q.data(), omega.data(), 0.02f, n, 4);
+    for (std::size_t i = 0; i < n; ++i)
+        for (unsigned c = 0; c < 4; ++c)
+            EXPECT_NEAR(q[i][c], expected[i][c], 1e-6f);
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <mathlib/defines.h>
+#include <mathlib/ray.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+static float noise(unsigned i) {
+    return float(std::fmod(std::abs(std::sin(double(i)) * 43758.5453), 1.));
+}
+
+static std::vector<Rayf> rays(unsigned count, unsigned seed) {
+    std::vector<Rayf> ret;
+    for (unsigned i = 0; i < count; ++i) {
+        const unsigned k = (seed + i) * 7;
+        ret.emplace_back(Vector3f(noise(k) * 4.f - 2.f, noise(k + 1) * 4.f - 2.f, -3.f),
+                         Vector3f(noise(k + 2) - .5f, noise(k + 3) - .5f, 1.f), 0.f, noise(k + 4) * 8.f);
+    }
+    return ret;
+}
+
+TEST(Ray, Aabb) {
+    Aabbf box;
+    EXPECT_TRUE(box.empty());
+    EXPECT_FLOAT_EQ(box.surfaceArea(), 0.f);
+    box.extend(Vector3f(1.f, 2.f, 3.f));
+    EXPECT_FALSE(box.empty());
+    box.extend(Aabbf(Vector3f(0.f), Vector3f(1.f)));
+    EXPECT_EQ(box.lo, Vector3f(0.f));
+    EXPECT_EQ(box.hi, Vector3f(1.f, 2.f, 3.f));
+    EXPECT_EQ(box.center(), Vector3f(.5f, 1.f, 1.5f));
+    EXPECT_FLOAT_EQ(box.surfaceArea(), 22.f);
+
+    const Trianglef triangle{Vector3f(0.f), Vector3f(1.f, 0.f, 0.f), Vector3f(0.f, 2.f, -1.f)};
+    EXPECT_EQ(triangle.bounds().lo, Vector3f(0.f, 0.f, -1.f));
+    EXPECT_EQ(triangle.bounds().hi, Vector3f(1.f, 2.f, 0.f));
+}
+
+TEST(Ray, Slab) {
+    const Aabbf box(Vector3f(-1.f), Vector3f(1.f));
+    float t = 0.f;
+
+    EXPECT_TRUE(mathlib::intersect(Rayf(Vector3f(-3.f, 0.f, 0.f), Vector3f(1.f, 0.f, 0.f)), box, t));
+    EXPECT_FLOAT_EQ(t, 2.f);
+    EXPECT_TRUE(mathlib::intersect(Rayf(Vector3f(-3.f, 0.f, 0.f), Vector3f(2.f, 0.f, 0.f)), box, t));
+    EXPECT_FLOAT_EQ(t, 1.f);
+
+    // Inside, behind and out of range.
+    EXPECT_TRUE(mathlib::intersect(Rayf(Vector3f(0.f), Vector3f(0.f, 0.f, 1.f)), box, t));
+    EXPECT_FLOAT_EQ(t, 0.f);
+    EXPECT_FALSE(mathlib::intersect(Rayf(Vector3f(-3.f, 0.f, 0.f), Vector3f(-1.f, 0.f, 0.f)), box, t));
+    EXPECT_FALSE(mathlib::intersect(Rayf(Vector3f(-3.f, 0.f, 0.f), Vector3f(1.f, 0.f, 0.f), 0.f, 1.5f), box, t));
+
+    // Axis parallel rays, the zero components divide to infinity.
+    EXPECT_TRUE(mathlib::intersect(Rayf(Vector3f(.5f, .5f, -3.f), Vector3f(0.f, 0.f, 1.f)), box, t));
+    EXPECT_FLOAT_EQ(t, 2.f);
+    EXPECT_FALSE(mathlib::intersect(Rayf(Vector3f(2.f, .5f, -3.f), Vector3f(0.f, 0.f, 1.f)), box, t));
+    EXPECT_FALSE(mathlib::intersect(Rayf(Vector3f(-2.f, .5f, -3.f), Vector3f(0.f, 0.f, -1.f)), box, t));
+}
+
+TEST(Ray, Triangle) {
+    const Trianglef triangle{Vector3f(0.f, 0.f, 1.f), Vector3f(1.f, 0.f, 1.f), Vector3f(0.f, 1.f, 1.f)};
+    RayHit<float> hit;
+
+    EXPECT_TRUE(mathlib::intersect(Rayf(Vector3f(.25f, .5f, 0.f), Vector3f(0.f, 0.f, 2.f)), triangle, hit));
+    EXPECT_FLOAT_EQ(hit.t, .5f);
+    EXPECT_FLOAT_EQ(hit.u, .25f);
+    EXPECT_FLOAT_EQ(hit.v, .5f);
+    EXPECT_FALSE(hit.valid());
+
+    // Back side.
+    EXPECT_TRUE(mathlib::intersect(Rayf(Vector3f(.25f, .25f, 2.f), Vector3f(0.f, 0.f, -1.f)), triangle, hit));
+    EXPECT_FLOAT_EQ(hit.t, 1.f);
+
+    // Outside, parallel, behind and out of range leave the hit unchanged.
+    EXPECT_FALSE(mathlib::intersect(Rayf(Vector3f(.75f, .5f, 0.f), Vector3f(0.f, 0.f, 1.f)), triangle, hit));
+    EXPECT_FALSE(mathlib::intersect(Rayf(Vector3f(.25f, .25f, 1.f), Vector3f(1.f, 0.f, 0.f)), triangle, hit));
+    EXPECT_FALSE(mathlib::intersect(Rayf(Vector3f(.25f, .25f, 2.f), Vector3f(0.f, 0.f, 1.f)), triangle, hit));
+    EXPECT_FALSE(mathlib::intersect(Rayf(Vector3f(.25f, .25f, 0.f), Vector3f(0.f, 0.f, 1.f), 0.f, .5f), triangle, hit));
+    EXPECT_FLOAT_EQ(hit.t, 1.f);
+
+    const Triangled triangled{Vector3d(0., 0., 1.), Vector3d(1., 0., 1.), Vector3d(0., 1., 1.)};
+    RayHit<double> hitd;
+    EXPECT_TRUE(mathlib::intersect(Rayd(Vector3d(.25, .5, 0.), Vector3d(0., 0., 1.)), triangled, hitd));
+    EXPECT_DOUBLE_EQ(hitd.t, 1.);
+}
+
+template <unsigned W>
+static void packetMatchesSingle() {
+    const Aabbf box(Vector3f(-1.f, -1.f, 0.f), Vector3f(1.f, 1.f, 2.f));
+    const Trianglef triangles[2] = {{Vector3f(-1.f, -1.f, 1.f), Vector3f(1.f, -1.f, 1.f), Vector3f(-1.f, 1.f, 1.f)},
+                                    {Vector3f(1.f, 1.f, .5f), Vector3f(-1.f, 1.f, .5f), Vector3f(1.f, -1.f, .5f)}};
+
+    for (unsigned seed = 0; seed < 4; ++seed) {
+        const std::vector<Rayf> r = rays(W - 1, seed * W);
+        RayPacket<W, float> packet(r.data(), W - 1);
+        EXPECT_EQ(packet.ray(0).origin, r[0].origin);
+
+        float t_entry[W];
+        const std::uint32_t box_mask = mathlib::intersect(packet, box, t_entry);
+        HitPacket<W, float> hits;
+        std::uint32_t hit_mask = 0;
+        for (std::uint32_t k = 0; k < 2; ++k)
+            hit_mask |= mathlib::intersect(packet, triangles[k], k, hits);
+
+        for (unsigned i = 0; i < W - 1; ++i) {
+            float t = 0.f;
+            const bool in_box = mathlib::intersect(r[i], box, t);
+            EXPECT_EQ(((box_mask >> i) & 1u) != 0, in_box);
+            if (in_box) {
+                EXPECT_FLOAT_EQ(t_entry[i], t);
+            }
+
+            Rayf ray(r[i]);
+            RayHit<float> expected;
+            for (std::uint32_t k = 0; k < 2; ++k) {
+                if (mathlib::intersect(ray, triangles[k], expected)) {
+                    expected.index = k;
+                    ray.t_max = expected.t;
+                }
+            }
+            EXPECT_EQ(((hit_mask >> i) & 1u) != 0, expected.valid());
+            EXPECT_EQ(hits.index[i], expected.index);
+            EXPECT_FLOAT_EQ(hits.t[i], expected.t);
+            EXPECT_FLOAT_EQ(packet.t_max[i], ray.t_max);
+        }
+
+        // The unused lane is inactive.
+        EXPECT_EQ(box_mask >> (W - 1), 0u);
+        EXPECT_EQ(hits.hit(W - 1).index, RayHit<float>::npos);
+    }
+}
+
+TEST(Ray, Packet) {
+    packetMatchesSingle<4>();
+    packetMatchesSingle<8>();
+    packetMatchesSingle<16>();
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <mathlib/defines.h>
+#include <mathlib/operators.h>
+#include <mathlib/reduce.h>
+
+#include <vector>
+
+static std::vector<Vector3d> points(std::size_t count) {
+    std::vector<Vector3d> ret(count);
+    for (std::size_t i = 0; i < count; ++i)
+        ret[i] = Vector3d(double(i % 97) * 0.1, -double(i % 13), double(i) * 1e-3);
+    return ret;
+}
+
+TEST(Reduce, Sum) {
+    std::vector<Vector3d> p = points(50000);
+    Vector3d expected;
+    for (const Vector3d &v : p)
+        expected += v;
+
+    Vector3d serial = mathlib::sum(p);
+    EXPECT_NEAR(Vector3d(serial - expected).norm(), 0., 1e-6);
+    // The result does not depend on the number of threads.
+    for (unsigned threads : {2u, 3u, 8u, 0u})
+        EXPECT_EQ(mathlib::sum(p, threads), serial);
+
+    EXPECT_EQ(mathlib::sum(std::vector<Vector3d>()), Vector3d());
+    EXPECT_EQ(mathlib::mean(std::vector<Vector3d>()), Vector3d());
+    EXPECT_EQ(mathlib::mean(p, 4), serial / 50000.);
+}
+
+TEST(Reduce, BoundingBox) {
+    std::vector<Vector3d> p = points(20000);
+    auto box = mathlib::boundingBox(p, 4);
+    EXPECT_EQ(box.first, Vector3d(0., -12., 0.));
+    EXPECT_DOUBLE_EQ(box.second[0], 9.6);
+    EXPECT_DOUBLE_EQ(box.second[1], 0.);
+    EXPECT_DOUBLE_EQ(box.second[2], 19.999);
+    EXPECT_EQ(mathlib::boundingBox(p), box);
+
+    std::vector<Vector2i> q = {Vector2i(3, -1), Vector2i(-2, 5)};
+    auto ibox = mathlib::boundingBox(q);
+    EXPECT_EQ(ibox.first, Vector2i(-2, -1));
+    EXPECT_EQ(ibox.second, Vector2i(3, 5));
+}
+
+TEST(Reduce, Dot) {
+    std::vector<Vector3d> a = points(30000), b(30000, Vector3d(1., 2., 3.));
+    double expected = 0.;
+    for (std::size_t i = 0; i < a.size(); ++i)
+        expected += a[i].dot(b[i]);
+
+    double serial = mathlib::dot(a, b);
+    EXPECT_NEAR(serial, expected, 1e-6 * std::abs(expected));
+    EXPECT_EQ(mathlib::dot(a, b, 6), serial);
+}
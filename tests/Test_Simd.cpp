@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <mathlib/operators.h>
+#include <mathlib/simd.h>
+#include <mathlib/vector.h>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace {
+
+template <unsigned N, typename T>
+void checkKernels() {
+    Vector<N, T> a, b;
+    for (unsigned i = 0; i < N; ++i) {
+        a[i] = T(0.5) + T(i % 7) - T(0.25) * T(i % 3);
+        b[i] = T(1.25) - T(i % 5) * T(0.75);
+    }
+
+    double dot = 0.;
+    double sqn = 0.;
+    double sum_a = 0.;
+    for (unsigned i = 0; i < N; ++i) {
+        dot += double(a[i]) * double(b[i]);
+        sqn += double(a[i]) * double(a[i]);
+        sum_a += double(a[i]);
+    }
+    const double tol = std::is_same<T, float>::value ? 1e-5 : 1e-12;
+    EXPECT_NEAR(a.dot(b), dot, tol * (1. + sqn)) << "N = " << N;
+    EXPECT_NEAR(a.squaredNorm(), sqn, tol * (1. + sqn)) << "N = " << N;
+    EXPECT_NEAR(a.sum(), sum_a, tol * (1. + sqn)) << "N = " << N;
+    EXPECT_NEAR(a.dot(b, mathlib::compensated), dot, tol * (1. + sqn)) << "N = " << N;
+    EXPECT_NEAR(a.squaredNorm(mathlib::compensated), sqn, tol * (1. + sqn)) << "N = " << N;
+    EXPECT_NEAR(a.sum(mathlib::compensated), sum_a, tol * (1. + sqn)) << "N = " << N;
+
+    Vector<N, T> n = a.normalized();
+    Vector<N, T> m = a;
+    m.normalize();
+    T inv_norm = T(1.) / std::sqrt(a.squaredNorm() + std::numeric_limits<T>::epsilon());
+    for (unsigned i = 0; i < N; ++i) {
+        EXPECT_EQ(n[i], a[i] * inv_norm);
+        EXPECT_EQ(m[i], a[i] * inv_norm);
+    }
+
+    Vector<N, T> sum = a, diff = a, prod = a, quot = a;
+    sum += b;
+    diff -= b;
+    prod *= b;
+    quot /= b;
+    for (unsigned i = 0; i < N; ++i) {
+        EXPECT_EQ(sum[i], T(a[i] + b[i]));
+        EXPECT_EQ(diff[i], T(a[i] - b[i]));
+        EXPECT_EQ(prod[i], T(a[i] * b[i]));
+        EXPECT_EQ(quot[i], T(a[i] / b[i]));
+    }
+}
+
+template <typename T, unsigned... Ns>
+void checkSizes() {
+    (checkKernels<Ns, T>(), ...);
+}
+
+}  // namespace
+
+TEST(Simd, Float) {
+    checkSizes<float, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, 64, 100, 257, 1000, 4099>();
+}
+
+TEST(Simd, Double) {
+    checkSizes<double, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, 64, 100, 257, 1000, 4099>();
+}
+
+TEST(Simd, Integer) {
+    EXPECT_FALSE(mathlib::simd::supported<int>);
+    Vector<8, int> a(3);
+    Vector<8, int> b(2);
+    a += b;
+    EXPECT_EQ(a.dot(b), 80);
+}
+
+TEST(Simd, PairwiseAccuracy) {
+    // 0.1f is not representable, a serial float sum of many of them drifts far from the exact result.
+    // Vector::sum() sums large vectors pairwise also without SIMD.
+    constexpr unsigned N = 16384;
+    std::vector<float> a(N, 0.1f);
+    const long double exact = (long double)N * 0.1f;
+
+    float serial = 0.f;
+    for (float x : a)
+        serial += x;
+    const float pairwise = mathlib::simd::pairwiseSum(a.data(), N);
+    const float compensated = mathlib::simd::compensatedSum(a.data(), N);
+
+    EXPECT_GT(std::fabs(serial - exact), 1e-4 * exact);
+    EXPECT_LT(std::fabs(pairwise - exact), 1e-5 * exact);
+    EXPECT_LE(std::fabs(compensated - exact), std::numeric_limits<float>::epsilon() * exact);
+
+    auto v = std::make_unique<Vector<N, float>>(0.1f);
+    EXPECT_EQ(v->sum(), pairwise);
+    EXPECT_EQ(v->sum(mathlib::compensated), compensated);
+    EXPECT_EQ(v->squaredNorm(), mathlib::simd::pairwiseDot(a.data(), a.data(), N));
+}
+
+TEST(Simd, Compensated) {
+    // Every 1 is lost when it is added to 1e8 in float, the compensated sum recovers all of them.
+    constexpr unsigned N = 1000;
+    std::vector<float> a, ones(N, 1.f);
+    for (unsigned i = 0; i < N / 4; ++i)
+        a.insert(a.end(), {1e8f, 1.f, -1e8f, 1.f});
+    for (unsigned n : {N, N - 1}) {
+        float exact = 0.f;
+        for (unsigned i = 0; i < n; ++i)
+            exact += a[i] == 1.f ? 1.f : 0.f;
+        EXPECT_EQ(mathlib::simd::compensatedSum(a.data(), n), exact) << "n = " << n;
+        EXPECT_EQ(mathlib::simd::compensatedDot(a.data(), ones.data(), n), exact) << "n = " << n;
+    }
+
+    std::vector<double> d{1e17, 1., -1e17, 1., 3., 1e-3};
+    EXPECT_DOUBLE_EQ(mathlib::simd::compensatedSum(d.data(), d.size()), 5.001);
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <mathlib/defines.h>
+#include <mathlib/sparse_vector.h>
+
+#include <sstream>
+#include <stdexcept>
+
+TEST(SparseVector, Construct) {
+    SparseVector<8, double> zero;
+    EXPECT_EQ(zero.nonZeros(), 0u);
+    EXPECT_EQ(zero.toVector(), (Vector<8, double>()));
+
+    SparseVector<8, double> s{{5, 3.}, {1, 2.}, {5, 1.}, {7, 0.}};
+    EXPECT_EQ(s.nonZeros(), 2u);
+    EXPECT_EQ(s.indices(), (std::vector<unsigned>{1, 5}));
+    EXPECT_EQ(s.values(), (std::vector<double>{2., 4.}));
+    EXPECT_DOUBLE_EQ(s[1], 2.);
+    EXPECT_DOUBLE_EQ(s[2], 0.);
+    EXPECT_THROW((SparseVector<8, double>{{8, 1.}}), std::runtime_error);
+
+    Vector<8, double> dense{0., 2., 0., 0., 0., 4., 0., 0.};
+    EXPECT_EQ((SparseVector<8, double>(dense)), s);
+    EXPECT_EQ(s.toVector(), dense);
+
+    s.set(3, 1.);
+    s.set(5, 0.);
+    s.set(1, -2.);
+    EXPECT_EQ(s, (SparseVector<8, double>{{1, -2.}, {3, 1.}}));
+    EXPECT_THROW(s.set(9, 1.), std::runtime_error);
+
+    std::stringstream ss;
+    ss << s;
+    EXPECT_EQ(ss.str(), "1:-2 3:1");
+}
+
+TEST(SparseVector, Reductions) {
+    SparseVector<1000, double> a{{3, 1.}, {10, -2.}, {999, 2.}};
+    SparseVector<1000, double> b{{0, 5.}, {10, 3.}, {500, 1.}, {999, 0.5}};
+    EXPECT_DOUBLE_EQ(a.sum(), 1.);
+    EXPECT_DOUBLE_EQ(a.squaredNorm(), 9.);
+    EXPECT_DOUBLE_EQ(a.norm(), 3.);
+    EXPECT_DOUBLE_EQ(a.dot(b), -5.);
+    EXPECT_DOUBLE_EQ(b.dot(a), -5.);
+    EXPECT_DOUBLE_EQ(a.dot(SparseVector<1000, double>()), 0.);
+
+    Vector<1000, double> dense = b.toVector();
+    EXPECT_DOUBLE_EQ(a.dot(dense), -5.);
+    EXPECT_DOUBLE_EQ(mathlib::dot(dense, a), -5.);
+    EXPECT_DOUBLE_EQ(a.dot(dense), a.toVector().dot(dense));
+}
+
+TEST(SparseVector, Arithmetic) {
+    SparseVector<16, float> a{{1, 1.f}, {4, 2.f}, {9, 3.f}};
+    SparseVector<16, float> b{{4, 2.f}, {9, 1.f}, {15, 4.f}};
+
+    EXPECT_EQ(a + b, (SparseVector<16, float>{{1, 1.f}, {4, 4.f}, {9, 4.f}, {15, 4.f}}));
+    EXPECT_EQ(a - b, (SparseVector<16, float>{{1, 1.f}, {9, 2.f}, {15, -4.f}}));
+    EXPECT_EQ((a - b).nonZeros(), 3u);
+
+    SparseVector<16, float> c = a;
+    c += b;
+    c -= b;
+    EXPECT_EQ(c, a);
+    c *= 2.f;
+    c /= 4.f;
+    EXPECT_EQ(c, (SparseVector<16, float>{{1, 0.5f}, {4, 1.f}, {9, 1.5f}}));
+    c *= 0.f;
+    EXPECT_EQ(c.nonZeros(), 0u);
+
+    Vector<16, float> y(1.f);
+    a.axpy(2.f, y);
+    EXPECT_FLOAT_EQ(y[0], 1.f);
+    EXPECT_FLOAT_EQ(y[4], 5.f);
+    y += b;
+    y -= a;
+    EXPECT_FLOAT_EQ(y[4], 5.f);
+    EXPECT_FLOAT_EQ(y[15], 5.f);
+    EXPECT_FLOAT_EQ(y[9], 5.f);
+}
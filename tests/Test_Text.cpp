@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <mathlib/defines.h>
+#include <mathlib/text.h>
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST(Text, Format) {
+    EXPECT_EQ(mathlib::format(Vector3d(1., 2.5, -3.)), "1 2.5 -3");
+    EXPECT_EQ(mathlib::format(Vector3i(1, -2, 3), ','), "1,-2,3");
+
+    char buffer[4];
+    std::to_chars_result r = mathlib::format(buffer, buffer + sizeof(buffer), Vector3i(10, 20, 30));
+    EXPECT_EQ(r.ec, std::errc::value_too_large);
+}
+
+TEST(Text, RoundTrip) {
+    Vector<4, double> v(0.1, 1. / 3., std::numeric_limits<double>::min(), -1e300);
+    Vector<4, double> w;
+    ASSERT_TRUE(mathlib::parse(mathlib::format(v), w));
+    for (unsigned i = 0; i < 4; ++i)
+        EXPECT_EQ(v[i], w[i]);
+
+    Vector3f f(0.1f, 1.f / 3.f, 16777216.f);
+    Vector3f g;
+    ASSERT_TRUE(mathlib::parse(mathlib::format(f, ','), g));
+    for (unsigned i = 0; i < 3; ++i)
+        EXPECT_EQ(f[i], g[i]);
+}
+
+TEST(Text, Parse) {
+    Vector3d v;
+    EXPECT_TRUE(mathlib::parse(" 1, 2;\t3 \n", v));
+    EXPECT_EQ(v, Vector3d(1., 2., 3.));
+    EXPECT_FALSE(mathlib::parse("1 2", v));
+    EXPECT_FALSE(mathlib::parse("1 2 x", v));
+    EXPECT_FALSE(mathlib::parse("1 2 3 4", v));
+
+    std::vector<Vector2i> p = mathlib::parseVectors<2, int>("1,2\n3,4\r\n5,6");
+    ASSERT_EQ(p.size(), 3u);
+    EXPECT_EQ(p[2], Vector2i(5, 6));
+    EXPECT_TRUE((mathlib::parseVectors<2, int>(" \n").empty()));
+    EXPECT_THROW((mathlib::parseVectors<2, int>("1 2 3")), std::runtime_error);
+}
+
+TEST(Text, CFallback) {
+    // The fallback of libraries without floating point std::to_chars / std::from_chars.
+    const double d[] = {0.1, 1. / 3., std::numeric_limits<double>::min(), -1e300, 0., 2.5};
+    for (double x : d) {
+        char buffer[mathlib::detail::max_scalar_chars];
+        std::to_chars_result r = mathlib::detail::toCharsC(buffer, buffer + sizeof(buffer), x);
+        ASSERT_EQ(r.ec, std::errc());
+        double y = 1.;
+        std::from_chars_result p = mathlib::detail::fromCharsC(buffer, r.ptr, y);
+        ASSERT_EQ(p.ec, std::errc());
+        EXPECT_EQ(p.ptr, r.ptr);
+        EXPECT_EQ(x, y);
+    }
+    char buffer[mathlib::detail::max_scalar_chars];
+    std::to_chars_result r = mathlib::detail::toCharsC(buffer, buffer + sizeof(buffer), 0.1f);
+    EXPECT_EQ(std::string(buffer, r.ptr), "0.1");
+    EXPECT_EQ(mathlib::detail::toCharsC(buffer, buffer + 2, 0.125).ec, std::errc::value_too_large);
+
+    const std::string text = "1.5,x +1 1e999";
+    float f = 0.f;
+    std::from_chars_result p = mathlib::detail::fromCharsC(text.data(), text.data() + text.size(), f);
+    EXPECT_EQ(p.ec, std::errc());
+    EXPECT_EQ(p.ptr, text.data() + 3);
+    EXPECT_EQ(f, 1.5f);
+    EXPECT_EQ(mathlib::detail::fromCharsC(text.data() + 4, text.data() + 5, f).ec, std::errc::invalid_argument);
+    EXPECT_EQ(mathlib::detail::fromCharsC(text.data() + 6, text.data() + 8, f).ec, std::errc::invalid_argument);
+    EXPECT_EQ(mathlib::detail::fromCharsC(text.data() + 9, text.data() + text.size(), f).ec,
+              std::errc::result_out_of_range);
+    EXPECT_EQ(f, 1.5f);
+}
+
+TEST(Text, File) {
+    std::vector<Vector3d> v;
+    for (unsigned i = 0; i < 10000; ++i)
+        v.push_back(Vector3d(i * 0.1, -1. / (i + 1), i * 1e10));
+    const std::string path = ::testing::TempDir() + "mathlib_vectors.csv";
+    mathlib::writeVectors(path, v, ',');
+
+    std::vector<Vector3d> read = mathlib::readVectors<3, double>(path);
+    ASSERT_EQ(read.size(), v.size());
+    for (std::size_t i = 0; i < v.size(); ++i)
+        for (unsigned c = 0; c < 3; ++c)
+            EXPECT_EQ(read[i][c], v[i][c]);
+
+    EXPECT_THROW((mathlib::readVectors<3, double>(path + ".missing")), std::runtime_error);
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <mathlib/operators.h>
+#include <mathlib/unroll.h>
+#include <mathlib/vector.h>
+
+#include <vector>
+
+using mathlib::detail::unroll;
+using mathlib::detail::unrollStep;
+
+namespace {
+
+template <unsigned N>
+constexpr unsigned sumIndices() {
+    unsigned s = 0;
+    unroll<N>([&](unsigned i) { s += i; });
+    return s;
+}
+
+}  // namespace
+
+TEST(Unroll, Order) {
+    std::vector<unsigned> indices;
+    unroll<5>([&](unsigned i) { indices.push_back(i); });
+    EXPECT_EQ(indices, (std::vector<unsigned>{0, 1, 2, 3, 4}));
+
+    indices.clear();
+    unrollStep<8, 4>([&](unsigned i) { indices.push_back(i); });
+    EXPECT_EQ(indices, (std::vector<unsigned>{0, 4}));
+
+    indices.clear();
+    unroll<0>([&](unsigned i) { indices.push_back(i); });
+    EXPECT_TRUE(indices.empty());
+}
+
+TEST(Unroll, Fallback) {
+    // Above MATHLIB_MAX_UNROLL the indices are visited by a plain loop.
+    std::vector<unsigned> indices;
+    unroll<MATHLIB_MAX_UNROLL + 3>([&](unsigned i) { indices.push_back(i); });
+    ASSERT_EQ(indices.size(), MATHLIB_MAX_UNROLL + 3u);
+    for (unsigned i = 0; i < indices.size(); ++i)
+        EXPECT_EQ(indices[i], i);
+
+    Vector<40, double> a(1.0), b(2.0);
+    EXPECT_DOUBLE_EQ(a.dot(b), 80.0);
+    Vector<40, double> c = a + b;
+    EXPECT_DOUBLE_EQ(c.sum(), 120.0);
+}
+
+TEST(Unroll, Constexpr) {
+    static_assert(sumIndices<4>() == 6);
+    static_assert(sumIndices<MATHLIB_MAX_UNROLL + 4>() == (MATHLIB_MAX_UNROLL + 4) * (MATHLIB_MAX_UNROLL + 3) / 2);
+}
@@ -1,7 +1,10 @@
 #include <gtest/gtest.h>
 #include <mathlib/defines.h>
+#include <mathlib/operators.h>
 #include <mathlib/vector.h>
 
+#include <array>
+
 TEST(Vector, Type) {
     EXPECT_EQ(typeid(Vector<1, char>::type), typeid(char));
     EXPECT_EQ(typeid(Vector<1, unsigned long long>::type), typeid(unsigned long long));
@@ -33,6 +36,22 @@ TEST(Vector, Constructor) {
     Vector2d v6(1., 2.);
     EXPECT_DOUBLE_EQ(v6.at(0), 1.);
     EXPECT_DOUBLE_EQ(v6.at(1), 2.);
+
+    Vector<6, float> v7(1, 2.f, 3., 4u, 5.f, 6.f);
+    EXPECT_FLOAT_EQ(v7.at(5), 6.f);
+
+    Vector<5, int> v8(std::array<int, 5>{1, 2, 3, 4, 5});
+    EXPECT_EQ(v8.at(4), 5);
+
+    Vector<5, int> v9{1, 2, 3, 4, 5};
+    EXPECT_EQ(v9, v8);
+    Vector<5, int> v10{7};
+    EXPECT_EQ(v10, (Vector<5, int>(7)));
+    EXPECT_THROW((Vector<5, int>{1, 2}), std::invalid_argument);
+
+    constexpr Vector<5, double> v11{1., 2., 3., 4., 5.};
+    constexpr Vector<5, double> v12(std::array<double, 5>{1., 2., 3., 4., 5.});
+    static_assert(v11[4] == 5. && v12[4] == 5.);
 }
 
 TEST(Vector, Norm) {
@@ -281,4 +300,81 @@ TEST(Stream, ToString) {
     EXPECT_EQ(v2.to_string(), std::string("1.500000 2.250000 3.750000"));
 
     EXPECT_EQ(v2.cast<int>().to_string(), std::string("1 2 3"));
-}
\ No newline at end of file
+}
+
+TEST(Vector, Constexpr) {
+    static_assert(std::is_trivially_copyable<Vector3d>::value);
+    static_assert(std::is_trivially_copyable<Vector<16, float>>::value);
+    static_assert(std::is_trivially_copyable<Vector3i>::value);
+
+    constexpr Vector3d zero;
+    static_assert(zero[0] == 0. && zero[1] == 0. && zero[2] == 0.);
+
+    constexpr Vector3d e_x(1., 0., 0.);
+    constexpr Vector3d e_y(0., 1., 0.);
+    constexpr Vector3d e_z = e_x.cross(e_y);
+    static_assert(e_z.x() == 0. && e_z.y() == 0. && e_z.z() == 1.);
+    static_assert(e_x.dot(e_y) == 0.);
+    static_assert(e_z.squaredNorm() == 1.);
+
+    constexpr Vector3d sum = e_x + 2. * e_y - e_z / 2.;
+    static_assert(sum(0) == 1. && sum(1) == 2. && sum(2) == -0.5);
+    static_assert(sum.sum() == 2.5 && sum.min() == -0.5 && sum.max() == 2.);
+    static_assert(sum.at(1) == 2.);
+
+    constexpr Vector<4, double> v(1., 2., 3., 4.);
+    static_assert(v.head<2>()[1] == 2. && v.tail<2>()[0] == 3. && v.segment<1, 2>()[1] == 3.);
+    static_assert(v.cast<int>()[3] == 4);
+
+    constexpr Vector<8, float> f(2.f);
+    static_assert(f.dot(f) == 32.f);
+    EXPECT_FLOAT_EQ(f.dot(f), 32.f);
+}
+
+TEST(Vector, FastMath) {
+    // Relative error bounds of the approximate reciprocal (square root).
+    double max_rsqrt_f = 0., max_rcp_f = 0., max_rsqrt_d = 0., max_rcp_d = 0.;
+    for (int e = -30; e <= 30; ++e) {
+        for (int m = 1; m < 200; ++m) {
+            const double x = std::ldexp(1. + m / 200., e);
+            const float xf = float(x);
+            max_rsqrt_f = std::max(max_rsqrt_f, std::fabs(mathlib::rsqrt(xf, mathlib::fast) * std::sqrt(double(xf)) - 1.));
+            max_rcp_f = std::max(max_rcp_f, std::fabs(mathlib::rcp(-xf, mathlib::fast) * -double(xf) - 1.));
+            max_rsqrt_d = std::max(max_rsqrt_d, std::fabs(mathlib::rsqrt(x, mathlib::fast) * std::sqrt(x) - 1.));
+            max_rcp_d = std::max(max_rcp_d, std::fabs(mathlib::rcp(x, mathlib::fast) * x - 1.));
+        }
+    }
+    EXPECT_LT(max_rsqrt_f, 5e-7);
+    EXPECT_LT(max_rcp_f, 5e-7);
+    EXPECT_LT(max_rsqrt_d, 1e-13);
+    EXPECT_LT(max_rcp_d, 1e-13);
+    EXPECT_EQ(mathlib::rsqrt(1e300, mathlib::fast), 1e-150);
+
+    for (int i = 1; i < 100; ++i) {
+        const Vector<3, float> v(float(i), -0.5f * i, 1.f / i);
+        const Vector<3, float> exact = v.normalized(), fast = v.normalized(mathlib::fast);
+        for (unsigned c = 0; c < 3; ++c)
+            EXPECT_NEAR(fast[c], exact[c], 1e-6f);
+        EXPECT_NEAR(v.norm(mathlib::fast), v.norm(), 1e-6f * v.norm());
+        EXPECT_EQ(v.norm(mathlib::exact), v.norm());
+        EXPECT_EQ(v.normalized(mathlib::exact), exact);
+
+        Vector<4, double> w(double(i), 2., -1. / i, 0.25);
+        w.normalize(mathlib::fast);
+        EXPECT_NEAR(w.norm(), 1., 1e-13);
+    }
+
+    // The fast norm approximates the exact one for small magnitudes, down to subnormal squared norms.
+    for (int e = -75; e <= 0; ++e) {
+        const Vector<3, float> v(std::ldexp(1.f, e), std::ldexp(-0.75f, e), 0.f);
+        EXPECT_NEAR(v.norm(mathlib::fast), v.norm(), 1e-6f * v.norm());
+    }
+    for (int e = -540; e <= 0; e += 5) {
+        const Vector<3, double> v(std::ldexp(1., e), 0., std::ldexp(0.3, e));
+        EXPECT_NEAR(v.norm(mathlib::fast), v.norm(), 1e-13 * v.norm());
+    }
+    EXPECT_NEAR(Vector3f(1e-3f, 0.f, 0.f).norm(mathlib::fast), 1e-3f, 1e-9f);
+    EXPECT_NEAR(Vector3d(1e-8, 0., 0.).norm(mathlib::fast), 1e-8, 1e-21);
+    EXPECT_EQ(Vector3f(0.f).norm(mathlib::fast), 0.f);
+    EXPECT_EQ(Vector3d(0.).norm(mathlib::fast), 0.);
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <mathlib/defines.h>
+#include <mathlib/vector_array.h>
+
+#include <cstdint>
+
+TEST(VectorArray, Constructor) {
+    VectorArray3d a;
+    EXPECT_EQ(a.size(), 0);
+    EXPECT_TRUE(a.empty());
+
+    VectorArray3d b(4, Vector3d(1., 2., 3.));
+    EXPECT_EQ(b.size(), 4);
+    EXPECT_EQ(b[3], Vector3d(1., 2., 3.));
+
+    std::vector<Vector3d> v = {Vector3d(1., 2., 3.), Vector3d(4., 5., 6.)};
+    VectorArray3d c(v);
+    EXPECT_EQ(c.size(), 2);
+    EXPECT_EQ(c[1], Vector3d(4., 5., 6.));
+    EXPECT_EQ(c.toVectors()[0], v[0]);
+}
+
+TEST(VectorArray, Layout) {
+    VectorArray3f a(17);
+    for (unsigned c = 0; c < 3; ++c)
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(a.data(c)) % 64, 0u);
+
+    a[2] = Vector3f(1.f, 2.f, 3.f);
+    EXPECT_FLOAT_EQ(a.data(0)[2], 1.f);
+    EXPECT_FLOAT_EQ(a.data(1)[2], 2.f);
+    EXPECT_FLOAT_EQ(a.data(2)[2], 3.f);
+
+    a[2][1] = 5.f;
+    Vector3f v = a[2];
+    EXPECT_EQ(v, Vector3f(1.f, 5.f, 3.f));
+
+    a.push_back(Vector3f(7.f));
+    EXPECT_EQ(a.size(), 18);
+    EXPECT_EQ(a[17], Vector3f(7.f));
+}
+
+TEST(VectorArray, Bulk) {
+    std::vector<Vector3d> v = {Vector3d(1., 2., 3.), Vector3d(-4., 5., 0.5), Vector3d(42., 15., 0.24)};
+    std::vector<Vector3d> w = {Vector3d(1., 1., 2.), Vector3d(3., 2., 1.), Vector3d(0., 1., 0.)};
+    VectorArray3d a(v);
+    VectorArray3d b(w);
+
+    std::vector<double> dot = a.dot(b);
+    std::vector<double> sqn = a.squaredNorm();
+    std::vector<double> norm = a.norm();
+    std::vector<double> mn = a.min();
+    std::vector<double> mx = a.max();
+    VectorArray3d cross = a.cross(b);
+    VectorArray3d normalized = a.normalized();
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        EXPECT_DOUBLE_EQ(dot[i], v[i].dot(w[i]));
+        EXPECT_DOUBLE_EQ(sqn[i], v[i].squaredNorm());
+        EXPECT_DOUBLE_EQ(norm[i], v[i].norm());
+        EXPECT_DOUBLE_EQ(mn[i], v[i].min());
+        EXPECT_DOUBLE_EQ(mx[i], v[i].max());
+        EXPECT_EQ(cross[i], v[i].cross(w[i]));
+        EXPECT_EQ(normalized[i], v[i].normalized());
+    }
+}
+
+TEST(VectorArray, Operators) {
+    VectorArray3d a(2, Vector3d(1., 2., 3.));
+    VectorArray3d b(2, Vector3d(4., 5., 6.));
+
+    a += b;
+    EXPECT_EQ(a[1], Vector3d(5., 7., 9.));
+    a -= b;
+    EXPECT_EQ(a[1], Vector3d(1., 2., 3.));
+    a *= b;
+    EXPECT_EQ(a[1], Vector3d(4., 10., 18.));
+    a /= b;
+    EXPECT_EQ(a[1], Vector3d(1., 2., 3.));
+
+    a += Vector3d(1., 0., -1.);
+    EXPECT_EQ(a[0], Vector3d(2., 2., 2.));
+    a *= 2.;
+    EXPECT_EQ(a[0], Vector3d(4., 4., 4.));
+    a /= 4.;
+    EXPECT_EQ(a[0], Vector3d(1., 1., 1.));
+    a -= 1.;
+    EXPECT_EQ(a[0], Vector3d(0., 0., 0.));
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <mathlib/defines.h>
+#include <mathlib/operators.h>
+#include <mathlib/quaternion.h>
+#include <mathlib/vector.h>
+
+#include <type_traits>
+
+TEST(VectorView, References) {
+    Vector<6, double> v({1., 2., 3., 4., 5., 6.});
+
+    auto head = v.head<3>();
+    static_assert(std::is_same<decltype(head), VectorView<3, double>>::value);
+    EXPECT_EQ(head.data(), &v[0]);
+    EXPECT_EQ(v.tail<2>().data(), &v[4]);
+    EXPECT_EQ((v.segment<1, 3>().data()), &v[1]);
+
+    head[0] = 10.;
+    head.z() = 30.;
+    EXPECT_DOUBLE_EQ(v[0], 10.);
+    EXPECT_DOUBLE_EQ(v[2], 30.);
+
+    v.tail<3>() = Vector3d(7., 8., 9.);
+    EXPECT_EQ(v, (Vector<6, double>({10., 2., 30., 7., 8., 9.})));
+
+    v.head<3>() = v.tail<3>();
+    EXPECT_EQ(v, (Vector<6, double>({7., 8., 9., 7., 8., 9.})));
+
+    const Vector<6, double> &c = v;
+    static_assert(std::is_same<decltype(c.segment<2, 2>()), VectorView<2, const double>>::value);
+    VectorView<3, const double> read = v.head<3>();
+    EXPECT_DOUBLE_EQ(read.y(), 8.);
+
+    // Temporaries are copied instead of referenced.
+    static_assert(std::is_same<decltype(Vector<6, double>().head<3>()), Vector<3, double>>::value);
+    EXPECT_EQ((Vector<4, double>(1., 2., 3., 4.).segment<1, 2>()), (Vector<2, double>(2., 3.)));
+}
+
+TEST(VectorView, Arithmetic) {
+    Vector<6, double> v({1., 2., 3., 4., 5., 6.});
+    Vector3d a(1., 0., 0.);
+
+    Vector3d sum = v.head<3>() + v.tail<3>() * 2. - a;
+    EXPECT_EQ(sum, Vector3d(8., 12., 15.));
+
+    EXPECT_DOUBLE_EQ(v.head<3>().dot(v.tail<3>()), 32.);
+    EXPECT_DOUBLE_EQ(a.dot(v.tail<3>()), 4.);
+    EXPECT_DOUBLE_EQ(v.head<2>().squaredNorm(), 5.);
+    EXPECT_DOUBLE_EQ((v.segment<2, 2>().norm()), 5.);
+    EXPECT_EQ(v.head<3>().cross(v.tail<3>()), Vector3d(-3., 6., -3.));
+    EXPECT_EQ(a.cross(v.head<3>()), Vector3d(0., -3., 2.));
+
+    EXPECT_EQ((v.segment<2, 2>().normalized()), (Vector<2, double>(0.6, 0.8)));
+    v.segment<2, 2>().normalize();
+    EXPECT_NEAR(v[2], 0.6, 1e-12);
+    EXPECT_NEAR(v[3], 0.8, 1e-12);
+
+    v.head<2>() += Vector<2, double>(1., 1.);
+    v.head<2>() -= v.tail<2>();
+    v.tail<2>() *= 2.;
+    v.tail<2>() /= 4.;
+    EXPECT_EQ(v.head<2>(), (Vector<2, double>(-3., -3.)));
+    EXPECT_EQ(v.tail<2>(), (Vector<2, double>(2.5, 3.)));
+}
+
+TEST(VectorView, Quaternion) {
+    Quaterniond q(1., 2., 3., 4.);
+    static_assert(std::is_same<decltype(q.vec()), VectorView<3, double>>::value);
+    EXPECT_EQ(q.vec().data(), &q[0]);
+
+    q.vec() *= 2.;
+    EXPECT_EQ(q, Quaterniond(2., 4., 6., 4.));
+    q.vec() = Vector3d(0., 0., 1.);
+    EXPECT_EQ(q, Quaterniond(0., 0., 1., 4.));
+
+    const Vector3d v = (q * q).vec();
+    EXPECT_EQ(v, Vector3d(0., 0., 8.));
+}
+
+TEST(VectorView, Constexpr) {
+    constexpr Vector<4, double> v(1., 2., 3., 4.);
+    static_assert(v.head<3>().dot(v.tail<3>()) == 20.);
+    static_assert(v.head<3>().cross(v.tail<3>())[0] == -1.);
+    static_assert((v.segment<1, 2>() + v.head<2>()).eval()[1] == 5.);
+}
@@ -0,0 +1,24 @@
+// Compiled to assembly by check_codegen.cmake: every function below must be straight-line code at -O1, without
+// calls or jumps.
+#include <mathlib/aligned_vector.h>
+#include <mathlib/defines.h>
+#include <mathlib/operators.h>
+#include <mathlib/vector.h>
+
+extern "C" {
+
+void mathlib_codegen_add3f(Vector3f &a, const Vector3f &b) { a += b; }
+void mathlib_codegen_sub4d(Vector<4, double> &a, const Vector<4, double> &b) { a -= b; }
+void mathlib_codegen_mul3i(Vector3i &a, const Vector3i &b) { a *= b; }
+void mathlib_codegen_scale3f(Vector3f &a, float s) { a *= s; }
+void mathlib_codegen_expr3d(Vector3d &r, const Vector3d &a, const Vector3d &b) { r = a + b * 2.0; }
+void mathlib_codegen_cast3f(Vector3d &r, const Vector3f &a) { r = a.cast<double>(); }
+void mathlib_codegen_head4d(Vector3d &r, const Vector<4, double> &a) { r = a.head<3>(); }
+float mathlib_codegen_dot3f(const Vector3f &a, const Vector3f &b) { return a.dot(b); }
+double mathlib_codegen_dot16d(const Vector<16, double> &a, const Vector<16, double> &b) { return a.dot(b); }
+double mathlib_codegen_sum4d(const Vector<4, double> &a) { return a.sum(); }
+double mathlib_codegen_squaredNorm3d(const Vector3d &a) { return a.squaredNorm(); }
+bool mathlib_codegen_equal3f(const Vector3f &a, const Vector3f &b) { return a == b; }
+void mathlib_codegen_alignedAdd3f(AlignedVector3f &a, const AlignedVector3f &b) { a += b; }
+float mathlib_codegen_alignedDot4f(const AlignedVector4f &a, const AlignedVector4f &b) { return a.dot(b); }
+}
@@ -0,0 +1,35 @@
+# Compile SOURCE to assembly with COMPILER at OPT and fail if a function whose name starts with mathlib_codegen_
+# contains a call or a jump. Expects x86 assembly in AT&T syntax, as emitted by GCC and Clang.
+
+execute_process(
+    COMMAND ${COMPILER} -std=c++17 ${OPT} -fno-asynchronous-unwind-tables -I${INCLUDE} -S ${SOURCE} -o ${OUTPUT}
+    RESULT_VARIABLE result
+    ERROR_VARIABLE error
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Compiling ${SOURCE} failed:\n${error}")
+endif()
+
+file(STRINGS ${OUTPUT} lines)
+set(function "")
+set(functions 0)
+set(failures "")
+foreach(line IN LISTS lines)
+    if(line MATCHES "^(mathlib_codegen_[A-Za-z0-9_]+):")
+        set(function ${CMAKE_MATCH_1})
+        math(EXPR functions "${functions} + 1")
+    elseif(line MATCHES "^[A-Za-z_.$][^ \t]*:" AND NOT line MATCHES "^\\.L")
+        set(function "")
+    elseif(function AND line MATCHES "^[ \t]+(call|j[a-z]+)[ \t]")
+        list(APPEND failures "${function}: ${line}")
+    endif()
+endforeach()
+
+if(functions EQUAL 0)
+    message(FATAL_ERROR "No mathlib_codegen_ functions found in ${OUTPUT}")
+endif()
+if(failures)
+    string(REPLACE ";" "\n" failures "${failures}")
+    message(FATAL_ERROR "Loops or calls left at ${OPT}:\n${failures}")
+endif()
+message(STATUS "${functions} functions are straight-line code at ${OPT}")